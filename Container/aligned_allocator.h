@@ -0,0 +1,68 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace Containers {
+
+	// Allocator returning storage aligned to Alignment bytes, e.g. 64 for AVX-512 loads.
+	// With PadTail every block is also rounded up to a whole multiple of Alignment, so a
+	// kernel may load full vectors up to the next boundary past the last element without
+	// leaving the allocation; the extra lanes hold unspecified values. Containers take it
+	// as their Allocator, so every allocation path (construction, reserve, growth,
+	// shrink_to_fit) honours it. See AlignedVector in vector.h.
+
+	template<typename T, size_t Alignment = 64, bool PadTail = true>
+	class AlignedAllocator {
+		static_assert(std::has_single_bit(Alignment), "alignment must be a power of two");
+
+	public:
+		using value_type = T;
+
+		using is_always_equal = std::true_type;
+
+		template<typename U>
+		struct rebind {
+			using other = AlignedAllocator<U, Alignment, PadTail>;
+		};
+
+		static constexpr size_t alignment = Alignment < alignof(T) ? alignof(T) : Alignment;
+
+		AlignedAllocator() noexcept = default;
+
+		template<typename U>
+		AlignedAllocator(const AlignedAllocator<U, Alignment, PadTail>&) noexcept {}
+
+		T* allocate(size_t);
+
+		void deallocate(T*, size_t) noexcept;
+
+		// Bytes actually reserved for n elements
+		static constexpr size_t allocation_size(size_t) noexcept;
+
+		template<typename U>
+		bool operator==(const AlignedAllocator<U, Alignment, PadTail>&) const noexcept { return true; }
+
+		template<typename U>
+		bool operator!=(const AlignedAllocator<U, Alignment, PadTail>&) const noexcept { return false; }
+	};
+
+	template<typename T, size_t Alignment, bool PadTail>
+	T* AlignedAllocator<T, Alignment, PadTail>::allocate(size_t n) {
+		if (n > (size_t(-1) - alignment) / sizeof(T)) throw std::bad_array_new_length();
+		return static_cast<T*>(::operator new(allocation_size(n), std::align_val_t(alignment)));
+	}
+
+	template<typename T, size_t Alignment, bool PadTail>
+	void AlignedAllocator<T, Alignment, PadTail>::deallocate(T* data, size_t n) noexcept {
+		::operator delete(data, allocation_size(n), std::align_val_t(alignment));
+	}
+
+	template<typename T, size_t Alignment, bool PadTail>
+	constexpr size_t AlignedAllocator<T, Alignment, PadTail>::allocation_size(size_t n) noexcept {
+		size_t bytes = n * sizeof(T);
+		if constexpr (PadTail) return (bytes + alignment - 1) & ~(alignment - 1);
+		else return bytes;
+	}
+}
\ No newline at end of file
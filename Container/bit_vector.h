@@ -0,0 +1,730 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include "exception.h"
+#include "simd.h"
+#include "vector.h"
+
+namespace Containers {
+
+	// Packed vector of bools, one bit per element in 64-bit words
+	// Bits past size() in the last word are kept zero, so counting and comparing work on
+	// whole words. rank and select use an index built on first use after a change: the
+	// number of ones before every 512-bit block, and the block holding every
+	// select_sample-th one. rank reads one entry and at most eight words; select narrows
+	// to a handful of blocks from its sample. The rebuild writes to the object, so a
+	// const BitVector must not be ranked from several threads right after a change.
+	template<typename Allocator = std::allocator<uint64_t>>
+	class BitVector {
+	public:
+		using Word = uint64_t;
+
+		class Reference;
+
+		class Iterator;
+
+		static constexpr size_t word_bits = 64;
+
+		static constexpr size_t rank_block_words = 8;
+
+		static constexpr size_t select_sample = 8192;
+
+		BitVector() : BitVector(Allocator()) {}
+
+		explicit BitVector(const Allocator&) noexcept;
+
+		explicit BitVector(size_t, bool = false, const Allocator& = Allocator());
+
+		template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
+		BitVector(IT, IT, const Allocator& = Allocator());
+
+		BitVector(std::initializer_list<bool>, const Allocator& = Allocator());
+
+		BitVector(const BitVector&) = default;
+
+		BitVector(BitVector&&) noexcept;
+
+		BitVector& operator=(const BitVector&) = default;
+
+		BitVector& operator=(BitVector&&) noexcept(std::is_nothrow_move_assignable_v<Vector<Word, DefaultGrowth, Allocator>>);
+
+		BitVector& operator=(std::initializer_list<bool>);
+
+		Allocator get_allocator() const noexcept;
+
+		// Element Access
+		Reference at(size_t);
+
+		bool at(size_t) const;
+
+		Reference operator[](size_t);
+
+		bool operator[](size_t) const;
+
+		Reference front();
+
+		bool front() const;
+
+		Reference back();
+
+		bool back() const;
+
+		// Writes through the words must leave the bits past size() zero
+		Word* data() noexcept;
+
+		const Word* data() const noexcept;
+
+		size_t word_count() const noexcept;
+
+		// Capacity
+		bool empty() const noexcept;
+
+		size_t size() const noexcept;
+
+		void reserve(size_t);
+
+		size_t capacity() const;
+
+		void shrink_to_fit();
+
+		// Iterators
+		Iterator begin() noexcept;
+
+		const Iterator begin() const noexcept;
+
+		Iterator end() noexcept;
+
+		const Iterator end() const noexcept;
+
+		// Bit Operations
+		void set(size_t, bool = true);
+
+		void reset(size_t);
+
+		void flip(size_t);
+
+		void set() noexcept;
+
+		void reset() noexcept;
+
+		void flip() noexcept;
+
+		// Word-wise operations with a BitVector of the same size
+		BitVector& operator&=(const BitVector&);
+
+		BitVector& operator|=(const BitVector&);
+
+		BitVector& operator^=(const BitVector&);
+
+		// Clears every bit that is set in the other BitVector
+		BitVector& and_not(const BitVector&);
+
+		size_t count() const noexcept;
+
+		bool any() const noexcept;
+
+		bool none() const noexcept;
+
+		bool all() const noexcept;
+
+		// Number of ones in [0, pos)
+		size_t rank(size_t) const;
+
+		// Position of the one with the given zero-based rank, or size() when there are fewer ones
+		size_t select(size_t) const;
+
+		// Modifiers
+		void clear() noexcept;
+
+		void push_back(bool);
+
+		void pop_back();
+
+		void resize(size_t, bool = false);
+
+		void swap(BitVector&) noexcept;
+
+		bool operator==(const BitVector&) const noexcept;
+
+		bool operator!=(const BitVector&) const noexcept;
+
+	private:
+		using Words = Vector<Word, DefaultGrowth, Allocator>;
+
+		Words m_words;
+		size_t m_size;
+		mutable Words m_rank;
+		mutable Words m_select;
+		mutable bool m_indexed;
+
+		static constexpr size_t words_for(size_t) noexcept;
+
+		static size_t select_in_word(Word, size_t) noexcept;
+
+		template<typename Op>
+		BitVector& combine(const BitVector&, Op);
+
+		void clear_tail() noexcept;
+
+		void build_index() const;
+	};
+
+	template<typename Allocator>
+	class BitVector<Allocator>::Reference {
+	public:
+		Reference(BitVector* vector, size_t pos) : m_vector(vector), m_pos(pos) {}
+
+		Reference(const Reference&) = default;
+
+		Reference& operator=(bool);
+
+		Reference& operator=(const Reference&);
+
+		operator bool() const;
+
+		bool operator~() const;
+
+		void flip();
+
+	private:
+		BitVector* m_vector;
+		size_t m_pos;
+	};
+
+	template<typename Allocator>
+	typename BitVector<Allocator>::Reference& BitVector<Allocator>::Reference::operator=(bool value) {
+		m_vector->set(m_pos, value);
+		return *this;
+	}
+
+	template<typename Allocator>
+	typename BitVector<Allocator>::Reference& BitVector<Allocator>::Reference::operator=(const Reference& other) {
+		return *this = static_cast<bool>(other);
+	}
+
+	template<typename Allocator>
+	BitVector<Allocator>::Reference::operator bool() const {
+		return static_cast<const BitVector&>(*m_vector)[m_pos];
+	}
+
+	template<typename Allocator>
+	bool BitVector<Allocator>::Reference::operator~() const {
+		return !static_cast<bool>(*this);
+	}
+
+	template<typename Allocator>
+	void BitVector<Allocator>::Reference::flip() {
+		m_vector->flip(m_pos);
+	}
+
+	template<typename Allocator>
+	class BitVector<Allocator>::Iterator {
+	public:
+		Iterator() : m_vector(nullptr), m_pos(0) {}
+
+		Iterator(BitVector* vector, size_t pos) : m_vector(vector), m_pos(pos) {}
+
+		Iterator(const Iterator& other) : m_vector(other.m_vector), m_pos(other.m_pos) {}
+
+		Iterator& operator=(const Iterator&) = default;
+
+		bool operator==(const Iterator&) const;
+
+		bool operator!=(const Iterator&) const;
+
+		Iterator& operator++();
+
+		Iterator operator++(int);
+
+		Iterator operator+(int) const;
+
+		Iterator& operator+=(int);
+
+		Iterator& operator--();
+
+		Iterator operator--(int);
+
+		Iterator operator-(int) const;
+
+		Iterator& operator-=(int);
+
+		size_t operator-(const Iterator&) const;
+
+		Reference operator*() const;
+
+	private:
+		BitVector* m_vector;
+		size_t m_pos;
+	};
+
+	template<typename Allocator>
+	bool BitVector<Allocator>::Iterator::operator==(const Iterator& other) const {
+		return m_pos == other.m_pos;
+	}
+
+	template<typename Allocator>
+	bool BitVector<Allocator>::Iterator::operator!=(const Iterator& other) const {
+		return m_pos != other.m_pos;
+	}
+
+	template<typename Allocator>
+	typename BitVector<Allocator>::Iterator& BitVector<Allocator>::Iterator::operator++() {
+		++m_pos;
+		return *this;
+	}
+
+	template<typename Allocator>
+	typename BitVector<Allocator>::Iterator BitVector<Allocator>::Iterator::operator++(int) {
+		Iterator it = *this;
+		++(*this);
+		return it;
+	}
+
+	template<typename Allocator>
+	typename BitVector<Allocator>::Iterator BitVector<Allocator>::Iterator::operator+(int steps) const {
+		Iterator it = *this;
+		it.m_pos += steps;
+		return it;
+	}
+
+	template<typename Allocator>
+	typename BitVector<Allocator>::Iterator& BitVector<Allocator>::Iterator::operator+=(int steps) {
+		m_pos += steps;
+		return *this;
+	}
+
+	template<typename Allocator>
+	typename BitVector<Allocator>::Iterator& BitVector<Allocator>::Iterator::operator--() {
+		--m_pos;
+		return *this;
+	}
+
+	template<typename Allocator>
+	typename BitVector<Allocator>::Iterator BitVector<Allocator>::Iterator::operator--(int) {
+		Iterator it = *this;
+		--(*this);
+		return it;
+	}
+
+	template<typename Allocator>
+	typename BitVector<Allocator>::Iterator BitVector<Allocator>::Iterator::operator-(int steps) const {
+		Iterator it = *this;
+		it.m_pos -= steps;
+		return it;
+	}
+
+	template<typename Allocator>
+	typename BitVector<Allocator>::Iterator& BitVector<Allocator>::Iterator::operator-=(int steps) {
+		m_pos -= steps;
+		return *this;
+	}
+
+	template<typename Allocator>
+	size_t BitVector<Allocator>::Iterator::operator-(const Iterator& other) const {
+		return m_pos - other.m_pos;
+	}
+
+	template<typename Allocator>
+	typename BitVector<Allocator>::Reference BitVector<Allocator>::Iterator::operator*() const {
+		return Reference(m_vector, m_pos);
+	}
+
+	// Constructors
+	template<typename Allocator>
+	BitVector<Allocator>::BitVector(const Allocator& allocator) noexcept :
+		m_words(allocator), m_size(0), m_rank(allocator), m_select(allocator), m_indexed(false) {}
+
+	template<typename Allocator>
+	BitVector<Allocator>::BitVector(size_t size, bool value, const Allocator& allocator) : BitVector(allocator) {
+		resize(size, value);
+	}
+
+	template<typename Allocator>
+	template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
+	BitVector<Allocator>::BitVector(IT first, IT last, const Allocator& allocator) : BitVector(allocator) {
+		for (; first != last; ++first) push_back(static_cast<bool>(*first));
+	}
+
+	template<typename Allocator>
+	BitVector<Allocator>::BitVector(std::initializer_list<bool> il, const Allocator& allocator) :
+		BitVector(il.begin(), il.end(), allocator) {}
+
+	template<typename Allocator>
+	BitVector<Allocator>::BitVector(BitVector&& other) noexcept :
+		m_words(std::move(other.m_words)), m_size(std::exchange(other.m_size, 0)),
+		m_rank(std::move(other.m_rank)), m_select(std::move(other.m_select)),
+		m_indexed(std::exchange(other.m_indexed, false)) {}
+
+	// An allocator that does not propagate may leave the words behind, so the source is cleared
+	template<typename Allocator>
+	BitVector<Allocator>& BitVector<Allocator>::operator=(BitVector&& other) noexcept(std::is_nothrow_move_assignable_v<Words>) {
+		if (this == &other) return *this;
+		m_words = std::move(other.m_words);
+		m_rank = std::move(other.m_rank);
+		m_select = std::move(other.m_select);
+		m_size = std::exchange(other.m_size, 0);
+		m_indexed = std::exchange(other.m_indexed, false);
+		other.m_words.clear();
+		return *this;
+	}
+
+	template<typename Allocator>
+	BitVector<Allocator>& BitVector<Allocator>::operator=(std::initializer_list<bool> il) {
+		BitVector temp(il, get_allocator());
+		swap(temp);
+		return *this;
+	}
+
+	template<typename Allocator>
+	Allocator BitVector<Allocator>::get_allocator() const noexcept {
+		return m_words.get_allocator();
+	}
+
+	// Element Access
+	template<typename Allocator>
+	typename BitVector<Allocator>::Reference BitVector<Allocator>::at(size_t pos) {
+		if (pos >= m_size) throw OutOfRangeException("BitVector");
+		return Reference(this, pos);
+	}
+
+	template<typename Allocator>
+	bool BitVector<Allocator>::at(size_t pos) const {
+		if (pos >= m_size) throw OutOfRangeException("BitVector");
+		return (*this)[pos];
+	}
+
+	template<typename Allocator>
+	typename BitVector<Allocator>::Reference BitVector<Allocator>::operator[](size_t pos) {
+		return Reference(this, pos);
+	}
+
+	template<typename Allocator>
+	bool BitVector<Allocator>::operator[](size_t pos) const {
+		return (m_words[pos / word_bits] >> (pos % word_bits)) & 1;
+	}
+
+	template<typename Allocator>
+	typename BitVector<Allocator>::Reference BitVector<Allocator>::front() {
+		if (!m_size) throw OutOfRangeException("BitVector");
+		return Reference(this, 0);
+	}
+
+	template<typename Allocator>
+	bool BitVector<Allocator>::front() const {
+		if (!m_size) throw OutOfRangeException("BitVector");
+		return (*this)[0];
+	}
+
+	template<typename Allocator>
+	typename BitVector<Allocator>::Reference BitVector<Allocator>::back() {
+		if (!m_size) throw OutOfRangeException("BitVector");
+		return Reference(this, m_size - 1);
+	}
+
+	template<typename Allocator>
+	bool BitVector<Allocator>::back() const {
+		if (!m_size) throw OutOfRangeException("BitVector");
+		return (*this)[m_size - 1];
+	}
+
+	template<typename Allocator>
+	typename BitVector<Allocator>::Word* BitVector<Allocator>::data() noexcept {
+		m_indexed = false;
+		return m_words.data();
+	}
+
+	template<typename Allocator>
+	const typename BitVector<Allocator>::Word* BitVector<Allocator>::data() const noexcept {
+		return m_words.data();
+	}
+
+	template<typename Allocator>
+	size_t BitVector<Allocator>::word_count() const noexcept {
+		return m_words.size();
+	}
+
+	// Capacity
+	template<typename Allocator>
+	bool BitVector<Allocator>::empty() const noexcept { return m_size == 0; }
+
+	template<typename Allocator>
+	size_t BitVector<Allocator>::size() const noexcept { return m_size; }
+
+	template<typename Allocator>
+	void BitVector<Allocator>::reserve(size_t capacity) {
+		m_words.reserve(words_for(capacity));
+	}
+
+	template<typename Allocator>
+	size_t BitVector<Allocator>::capacity() const {
+		return m_words.capacity() * word_bits;
+	}
+
+	template<typename Allocator>
+	void BitVector<Allocator>::shrink_to_fit() {
+		m_words.shrink_to_fit();
+	}
+
+	// Iterators
+	template<typename Allocator>
+	typename BitVector<Allocator>::Iterator BitVector<Allocator>::begin() noexcept {
+		return Iterator(this, 0);
+	}
+
+	template<typename Allocator>
+	const typename BitVector<Allocator>::Iterator BitVector<Allocator>::begin() const noexcept {
+		return Iterator(const_cast<BitVector*>(this), 0);
+	}
+
+	template<typename Allocator>
+	typename BitVector<Allocator>::Iterator BitVector<Allocator>::end() noexcept {
+		return Iterator(this, m_size);
+	}
+
+	template<typename Allocator>
+	const typename BitVector<Allocator>::Iterator BitVector<Allocator>::end() const noexcept {
+		return Iterator(const_cast<BitVector*>(this), m_size);
+	}
+
+	// Bit Operations
+	template<typename Allocator>
+	void BitVector<Allocator>::set(size_t pos, bool value) {
+		Word mask = Word(1) << (pos % word_bits);
+		Word& word = m_words[pos / word_bits];
+		word = (word & ~mask) | (-static_cast<Word>(value) & mask);
+		m_indexed = false;
+	}
+
+	template<typename Allocator>
+	void BitVector<Allocator>::reset(size_t pos) {
+		set(pos, false);
+	}
+
+	template<typename Allocator>
+	void BitVector<Allocator>::flip(size_t pos) {
+		m_words[pos / word_bits] ^= Word(1) << (pos % word_bits);
+		m_indexed = false;
+	}
+
+	template<typename Allocator>
+	void BitVector<Allocator>::set() noexcept {
+		for (size_t i = 0; i < m_words.size(); ++i) m_words[i] = ~Word(0);
+		clear_tail();
+		m_indexed = false;
+	}
+
+	template<typename Allocator>
+	void BitVector<Allocator>::reset() noexcept {
+		for (size_t i = 0; i < m_words.size(); ++i) m_words[i] = 0;
+		m_indexed = false;
+	}
+
+	template<typename Allocator>
+	void BitVector<Allocator>::flip() noexcept {
+		for (size_t i = 0; i < m_words.size(); ++i) m_words[i] = ~m_words[i];
+		clear_tail();
+		m_indexed = false;
+	}
+
+	template<typename Allocator>
+	BitVector<Allocator>& BitVector<Allocator>::operator&=(const BitVector& other) {
+		return combine(other, [](Word a, Word b) { return a & b; });
+	}
+
+	template<typename Allocator>
+	BitVector<Allocator>& BitVector<Allocator>::operator|=(const BitVector& other) {
+		return combine(other, [](Word a, Word b) { return a | b; });
+	}
+
+	template<typename Allocator>
+	BitVector<Allocator>& BitVector<Allocator>::operator^=(const BitVector& other) {
+		return combine(other, [](Word a, Word b) { return a ^ b; });
+	}
+
+	template<typename Allocator>
+	BitVector<Allocator>& BitVector<Allocator>::and_not(const BitVector& other) {
+		return combine(other, [](Word a, Word b) { return a & ~b; });
+	}
+
+	template<typename Allocator>
+	size_t BitVector<Allocator>::count() const noexcept {
+		return simd::popcount(m_words.data(), m_words.size());
+	}
+
+	template<typename Allocator>
+	bool BitVector<Allocator>::any() const noexcept {
+		for (size_t i = 0; i < m_words.size(); ++i) {
+			if (m_words[i]) return true;
+		}
+		return false;
+	}
+
+	template<typename Allocator>
+	bool BitVector<Allocator>::none() const noexcept {
+		return !any();
+	}
+
+	template<typename Allocator>
+	bool BitVector<Allocator>::all() const noexcept {
+		return count() == m_size;
+	}
+
+	template<typename Allocator>
+	size_t BitVector<Allocator>::rank(size_t pos) const {
+		if (pos > m_size) throw OutOfRangeException("BitVector");
+		if (!m_indexed) build_index();
+		size_t word = pos / word_bits;
+		size_t ones = m_rank[word / rank_block_words];
+		for (size_t i = word / rank_block_words * rank_block_words; i < word; ++i)
+			ones += std::popcount(m_words[i]);
+		if (pos % word_bits)
+			ones += std::popcount(m_words[word] & ((Word(1) << (pos % word_bits)) - 1));
+		return ones;
+	}
+
+	template<typename Allocator>
+	size_t BitVector<Allocator>::select(size_t rank) const {
+		if (!m_indexed) build_index();
+		size_t blocks = m_rank.size() - 1;
+		if (rank >= m_rank[blocks]) return m_size;
+
+		// the samples bound the blocks that can hold the one; find the last block starting at or before it
+		size_t sample = rank / select_sample;
+		size_t low = m_select[sample];
+		size_t high = sample + 1 < m_select.size() ? m_select[sample + 1] + 1 : blocks;
+		while (high - low > 1) {
+			size_t mid = low + (high - low) / 2;
+			if (m_rank[mid] <= rank) low = mid;
+			else high = mid;
+		}
+
+		rank -= m_rank[low];
+		for (size_t i = low * rank_block_words;; ++i) {
+			size_t ones = std::popcount(m_words[i]);
+			if (rank < ones) return i * word_bits + select_in_word(m_words[i], rank);
+			rank -= ones;
+		}
+	}
+
+	// Modifiers
+	template<typename Allocator>
+	void BitVector<Allocator>::clear() noexcept {
+		m_words.clear();
+		m_size = 0;
+		m_indexed = false;
+	}
+
+	template<typename Allocator>
+	void BitVector<Allocator>::push_back(bool value) {
+		if (m_size % word_bits == 0) m_words.push_back(0);
+		m_words.back() |= static_cast<Word>(value) << (m_size % word_bits);
+		++m_size;
+		m_indexed = false;
+	}
+
+	template<typename Allocator>
+	void BitVector<Allocator>::pop_back() {
+		if (!m_size) throw OutOfRangeException("BitVector");
+		--m_size;
+		if (m_size % word_bits == 0) m_words.pop_back();
+		else clear_tail();
+		m_indexed = false;
+	}
+
+	template<typename Allocator>
+	void BitVector<Allocator>::resize(size_t size, bool value) {
+		if (size > m_size && value && m_size % word_bits)
+			m_words.back() |= ~Word(0) << (m_size % word_bits);
+		m_words.resize(words_for(size), value ? ~Word(0) : Word(0));
+		m_size = size;
+		clear_tail();
+		m_indexed = false;
+	}
+
+	template<typename Allocator>
+	void BitVector<Allocator>::swap(BitVector& other) noexcept {
+		m_words.swap(other.m_words);
+		m_rank.swap(other.m_rank);
+		m_select.swap(other.m_select);
+		std::swap(m_size, other.m_size);
+		std::swap(m_indexed, other.m_indexed);
+	}
+
+	template<typename Allocator>
+	bool BitVector<Allocator>::operator==(const BitVector& other) const noexcept {
+		if (m_size != other.m_size) return false;
+		for (size_t i = 0; i < m_words.size(); ++i) {
+			if (m_words[i] != other.m_words[i]) return false;
+		}
+		return true;
+	}
+
+	template<typename Allocator>
+	bool BitVector<Allocator>::operator!=(const BitVector& other) const noexcept {
+		return !(*this == other);
+	}
+
+	// Private Members
+	template<typename Allocator>
+	constexpr size_t BitVector<Allocator>::words_for(size_t bits) noexcept {
+		return (bits + word_bits - 1) / word_bits;
+	}
+
+	// Narrows to the byte holding the one, then drops the lower ones in it
+	template<typename Allocator>
+	size_t BitVector<Allocator>::select_in_word(Word word, size_t rank) noexcept {
+		size_t shift = 0;
+		for (size_t ones; rank >= (ones = std::popcount((word >> shift) & 0xff)); shift += 8)
+			rank -= ones;
+		word >>= shift;
+		for (; rank; --rank) word &= word - 1;
+		return shift + std::countr_zero(word);
+	}
+
+	template<typename Allocator>
+	template<typename Op>
+	BitVector<Allocator>& BitVector<Allocator>::combine(const BitVector& other, Op op) {
+		if (m_size != other.m_size) throw ContainerException("BitVector", "Size mismatch");
+		Word* words = m_words.data();
+		const Word* others = other.m_words.data();
+		for (size_t i = 0, n = m_words.size(); i < n; ++i)
+			words[i] = op(words[i], others[i]);
+		m_indexed = false;
+		return *this;
+	}
+
+	template<typename Allocator>
+	void BitVector<Allocator>::clear_tail() noexcept {
+		if (m_size % word_bits)
+			m_words.back() &= (Word(1) << (m_size % word_bits)) - 1;
+	}
+
+	template<typename Allocator>
+	void BitVector<Allocator>::build_index() const {
+		size_t words = m_words.size();
+		size_t blocks = (words + rank_block_words - 1) / rank_block_words;
+		m_rank.resize(blocks + 1);
+		m_select.clear();
+		size_t ones = 0;
+		for (size_t block = 0; block < blocks; ++block) {
+			m_rank[block] = ones;
+			size_t first = block * rank_block_words;
+			size_t last = first + rank_block_words < words ? first + rank_block_words : words;
+			for (size_t i = first; i < last; ++i)
+				ones += std::popcount(m_words[i]);
+			while (m_select.size() * select_sample < ones) m_select.push_back(block);
+		}
+		m_rank[blocks] = ones;
+		m_indexed = true;
+	}
+
+	namespace pmr {
+		using BitVector = Containers::BitVector<std::pmr::polymorphic_allocator<uint64_t>>;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,600 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include "exception.h"
+#include "globals.h"
+#include "relocate.h"
+
+namespace Containers {
+
+	// Double-ended queue over one contiguous ring of power-of-two capacity
+	// The elements occupy size() consecutive slots starting at the head, wrapping past
+	// the end of the buffer, so pushing and popping at either end is O(1) and moves no
+	// other element. A full buffer doubles, unwrapping the elements to the start of the
+	// new one; growth gives the strong guarantee.
+	template<typename T, typename Allocator = std::allocator<T>>
+	class CircularBuffer {
+	private:
+		using AllocTraits = std::allocator_traits<Allocator>;
+
+	public:
+		class Iterator;
+
+		CircularBuffer() : CircularBuffer(Allocator()) {}
+
+		explicit CircularBuffer(const Allocator&) noexcept;
+
+		explicit CircularBuffer(size_t, const Allocator& = Allocator());
+
+		CircularBuffer(size_t, const T&, const Allocator& = Allocator());
+
+		template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
+		CircularBuffer(IT, IT, const Allocator& = Allocator());
+
+		CircularBuffer(const CircularBuffer&);
+
+		CircularBuffer(const CircularBuffer&, const Allocator&);
+
+		CircularBuffer(CircularBuffer&&) noexcept;
+
+		CircularBuffer(CircularBuffer&&, const Allocator&);
+
+		CircularBuffer(std::initializer_list<T>, const Allocator& = Allocator());
+
+		~CircularBuffer();
+
+		CircularBuffer& operator=(const CircularBuffer&);
+
+		CircularBuffer& operator=(CircularBuffer&&) noexcept(
+			AllocTraits::propagate_on_container_move_assignment::value ||
+			AllocTraits::is_always_equal::value);
+
+		CircularBuffer& operator=(std::initializer_list<T>);
+
+		Allocator get_allocator() const noexcept;
+
+		// Element Access
+		T& at(size_t);
+
+		const T& at(size_t) const;
+
+		T& operator[](size_t);
+
+		const T& operator[](size_t) const;
+
+		T& front();
+
+		const T& front() const;
+
+		T& back();
+
+		const T& back() const;
+
+		// Capacity
+		bool empty() const noexcept;
+
+		size_t size() const noexcept;
+
+		void reserve(size_t);
+
+		size_t capacity() const noexcept;
+
+		void shrink_to_fit();
+
+		// Iterators
+		Iterator begin() noexcept;
+
+		const Iterator begin() const noexcept;
+
+		Iterator end() noexcept;
+
+		const Iterator end() const noexcept;
+
+		// Modifiers
+		void clear() noexcept;
+
+		void push_back(const T&);
+
+		void push_back(T&&);
+
+		void push_front(const T&);
+
+		void push_front(T&&);
+
+		template<typename...Args>
+		void emplace_back(Args&&...);
+
+		template<typename...Args>
+		void emplace_front(Args&&...);
+
+		void pop_back();
+
+		void pop_front();
+
+		void swap(CircularBuffer&) noexcept;
+
+	private:
+		Allocator m_allocator;
+		T* m_data;
+		size_t m_capacity;
+		size_t m_head;
+		size_t m_size;
+
+		T* slot(size_t) const noexcept;
+
+		void reallocate(size_t);
+
+		void move_to(T*, size_t);
+
+		template<typename...Args>
+		void grow_emplace(bool, Args&&...);
+
+		void swap_storage(CircularBuffer&) noexcept;
+	};
+
+	template<typename T, typename Allocator>
+	class CircularBuffer<T, Allocator>::Iterator {
+	public:
+		Iterator() : m_buffer(nullptr), m_index(0) {}
+
+		Iterator(const CircularBuffer* buffer, size_t index) : m_buffer(buffer), m_index(index) {}
+
+		Iterator(const Iterator& other) : m_buffer(other.m_buffer), m_index(other.m_index) {}
+
+		Iterator& operator=(const Iterator&) = default;
+
+		bool operator==(const Iterator&) const;
+
+		bool operator!=(const Iterator&) const;
+
+		Iterator& operator++();
+
+		Iterator operator++(int);
+
+		Iterator operator+(int) const;
+
+		Iterator& operator+=(int);
+
+		Iterator& operator--();
+
+		Iterator operator--(int);
+
+		Iterator operator-(int) const;
+
+		Iterator& operator-=(int);
+
+		size_t operator-(const Iterator&) const;
+
+		T& operator*() const;
+
+		T* operator->() const;
+
+	private:
+		const CircularBuffer* m_buffer;
+		size_t m_index;
+	};
+
+	template<typename T, typename Allocator>
+	bool CircularBuffer<T, Allocator>::Iterator::operator==(const Iterator& other) const {
+		return m_index == other.m_index;
+	}
+
+	template<typename T, typename Allocator>
+	bool CircularBuffer<T, Allocator>::Iterator::operator!=(const Iterator& other) const {
+		return m_index != other.m_index;
+	}
+
+	template<typename T, typename Allocator>
+	typename CircularBuffer<T, Allocator>::Iterator& CircularBuffer<T, Allocator>::Iterator::operator++() {
+		++m_index;
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	typename CircularBuffer<T, Allocator>::Iterator CircularBuffer<T, Allocator>::Iterator::operator++(int) {
+		Iterator it = *this;
+		++(*this);
+		return it;
+	}
+
+	template<typename T, typename Allocator>
+	typename CircularBuffer<T, Allocator>::Iterator CircularBuffer<T, Allocator>::Iterator::operator+(int steps) const {
+		Iterator it = *this;
+		it.m_index += steps;
+		return it;
+	}
+
+	template<typename T, typename Allocator>
+	typename CircularBuffer<T, Allocator>::Iterator& CircularBuffer<T, Allocator>::Iterator::operator+=(int steps) {
+		m_index += steps;
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	typename CircularBuffer<T, Allocator>::Iterator& CircularBuffer<T, Allocator>::Iterator::operator--() {
+		--m_index;
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	typename CircularBuffer<T, Allocator>::Iterator CircularBuffer<T, Allocator>::Iterator::operator--(int) {
+		Iterator it = *this;
+		--(*this);
+		return it;
+	}
+
+	template<typename T, typename Allocator>
+	typename CircularBuffer<T, Allocator>::Iterator CircularBuffer<T, Allocator>::Iterator::operator-(int steps) const {
+		Iterator it = *this;
+		it.m_index -= steps;
+		return it;
+	}
+
+	template<typename T, typename Allocator>
+	typename CircularBuffer<T, Allocator>::Iterator& CircularBuffer<T, Allocator>::Iterator::operator-=(int steps) {
+		m_index -= steps;
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	size_t CircularBuffer<T, Allocator>::Iterator::operator-(const Iterator& other) const {
+		return m_index - other.m_index;
+	}
+
+	template<typename T, typename Allocator>
+	T& CircularBuffer<T, Allocator>::Iterator::operator*() const {
+		return *m_buffer->slot(m_index);
+	}
+
+	template<typename T, typename Allocator>
+	T* CircularBuffer<T, Allocator>::Iterator::operator->() const {
+		return m_buffer->slot(m_index);
+	}
+
+	// Constructors
+	template<typename T, typename Allocator>
+	CircularBuffer<T, Allocator>::CircularBuffer(const Allocator& allocator) noexcept :
+		m_allocator(allocator), m_data(nullptr), m_capacity(0), m_head(0), m_size(0) {}
+
+	// The delegating constructors leave cleanup after a throw to the destructor
+	template<typename T, typename Allocator>
+	CircularBuffer<T, Allocator>::CircularBuffer(size_t size, const Allocator& allocator) : CircularBuffer(allocator) {
+		reserve(size);
+		while (m_size < size) emplace_back();
+	}
+
+	template<typename T, typename Allocator>
+	CircularBuffer<T, Allocator>::CircularBuffer(size_t size, const T& value, const Allocator& allocator) : CircularBuffer(allocator) {
+		reserve(size);
+		while (m_size < size) emplace_back(value);
+	}
+
+	template<typename T, typename Allocator>
+	template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
+	CircularBuffer<T, Allocator>::CircularBuffer(IT first, IT last, const Allocator& allocator) : CircularBuffer(allocator) {
+		for (; first != last; ++first) emplace_back(*first);
+	}
+
+	template<typename T, typename Allocator>
+	CircularBuffer<T, Allocator>::CircularBuffer(const CircularBuffer& other) :
+		CircularBuffer(other, AllocTraits::select_on_container_copy_construction(other.m_allocator)) {}
+
+	template<typename T, typename Allocator>
+	CircularBuffer<T, Allocator>::CircularBuffer(const CircularBuffer& other, const Allocator& allocator) : CircularBuffer(allocator) {
+		reserve(other.m_size);
+		for (size_t i = 0; i < other.m_size; ++i) emplace_back(other[i]);
+	}
+
+	template<typename T, typename Allocator>
+	CircularBuffer<T, Allocator>::CircularBuffer(CircularBuffer&& other) noexcept :
+		m_allocator(std::move(other.m_allocator)), m_data(std::exchange(other.m_data, nullptr)),
+		m_capacity(std::exchange(other.m_capacity, 0)), m_head(std::exchange(other.m_head, 0)),
+		m_size(std::exchange(other.m_size, 0)) {}
+
+	template<typename T, typename Allocator>
+	CircularBuffer<T, Allocator>::CircularBuffer(CircularBuffer&& other, const Allocator& allocator) : CircularBuffer(allocator) {
+		if (m_allocator == other.m_allocator) {
+			swap_storage(other);
+			return;
+		}
+		reserve(other.m_size);
+		for (size_t i = 0; i < other.m_size; ++i) emplace_back(std::move(other[i]));
+	}
+
+	template<typename T, typename Allocator>
+	CircularBuffer<T, Allocator>::CircularBuffer(std::initializer_list<T> il, const Allocator& allocator) :
+		CircularBuffer(il.begin(), il.end(), allocator) {}
+
+	template<typename T, typename Allocator>
+	CircularBuffer<T, Allocator>::~CircularBuffer() {
+		clear();
+		if (m_data) AllocTraits::deallocate(m_allocator, m_data, m_capacity);
+	}
+
+	template<typename T, typename Allocator>
+	CircularBuffer<T, Allocator>& CircularBuffer<T, Allocator>::operator=(const CircularBuffer& other) {
+		if (this == &other) return *this;
+		constexpr bool propagate = AllocTraits::propagate_on_container_copy_assignment::value;
+		CircularBuffer temp(other, propagate ? other.m_allocator : m_allocator);
+		swap_storage(temp);
+		if constexpr (propagate) std::swap(m_allocator, temp.m_allocator);
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	CircularBuffer<T, Allocator>& CircularBuffer<T, Allocator>::operator=(CircularBuffer&& other) noexcept(
+		AllocTraits::propagate_on_container_move_assignment::value ||
+		AllocTraits::is_always_equal::value) {
+		constexpr bool propagate = AllocTraits::propagate_on_container_move_assignment::value;
+		CircularBuffer temp(std::move(other), propagate ? other.m_allocator : m_allocator);
+		swap_storage(temp);
+		if constexpr (propagate) std::swap(m_allocator, temp.m_allocator);
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	CircularBuffer<T, Allocator>& CircularBuffer<T, Allocator>::operator=(std::initializer_list<T> il) {
+		CircularBuffer temp(il, m_allocator);
+		swap_storage(temp);
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	Allocator CircularBuffer<T, Allocator>::get_allocator() const noexcept {
+		return m_allocator;
+	}
+
+	// Element Access
+	template<typename T, typename Allocator>
+	T& CircularBuffer<T, Allocator>::at(size_t pos) {
+		if (pos >= m_size) throw OutOfRangeException("CircularBuffer");
+		return *slot(pos);
+	}
+
+	template<typename T, typename Allocator>
+	const T& CircularBuffer<T, Allocator>::at(size_t pos) const {
+		if (pos >= m_size) throw OutOfRangeException("CircularBuffer");
+		return *slot(pos);
+	}
+
+	template<typename T, typename Allocator>
+	T& CircularBuffer<T, Allocator>::operator[](size_t pos) {
+		return *slot(pos);
+	}
+
+	template<typename T, typename Allocator>
+	const T& CircularBuffer<T, Allocator>::operator[](size_t pos) const {
+		return *slot(pos);
+	}
+
+	template<typename T, typename Allocator>
+	T& CircularBuffer<T, Allocator>::front() {
+		if (!m_size) throw OutOfRangeException("CircularBuffer");
+		return *slot(0);
+	}
+
+	template<typename T, typename Allocator>
+	const T& CircularBuffer<T, Allocator>::front() const {
+		if (!m_size) throw OutOfRangeException("CircularBuffer");
+		return *slot(0);
+	}
+
+	template<typename T, typename Allocator>
+	T& CircularBuffer<T, Allocator>::back() {
+		if (!m_size) throw OutOfRangeException("CircularBuffer");
+		return *slot(m_size - 1);
+	}
+
+	template<typename T, typename Allocator>
+	const T& CircularBuffer<T, Allocator>::back() const {
+		if (!m_size) throw OutOfRangeException("CircularBuffer");
+		return *slot(m_size - 1);
+	}
+
+	// Capacity
+	template<typename T, typename Allocator>
+	bool CircularBuffer<T, Allocator>::empty() const noexcept { return m_size == 0; }
+
+	template<typename T, typename Allocator>
+	size_t CircularBuffer<T, Allocator>::size() const noexcept { return m_size; }
+
+	template<typename T, typename Allocator>
+	void CircularBuffer<T, Allocator>::reserve(size_t capacity) {
+		if (capacity > m_capacity) reallocate(std::bit_ceil(capacity));
+	}
+
+	template<typename T, typename Allocator>
+	size_t CircularBuffer<T, Allocator>::capacity() const noexcept { return m_capacity; }
+
+	template<typename T, typename Allocator>
+	void CircularBuffer<T, Allocator>::shrink_to_fit() {
+		size_t capacity = m_size ? std::bit_ceil(m_size) : 0;
+		if (capacity < m_capacity) reallocate(capacity);
+	}
+
+	// Iterators
+	template<typename T, typename Allocator>
+	typename CircularBuffer<T, Allocator>::Iterator CircularBuffer<T, Allocator>::begin() noexcept {
+		return Iterator(this, 0);
+	}
+
+	template<typename T, typename Allocator>
+	const typename CircularBuffer<T, Allocator>::Iterator CircularBuffer<T, Allocator>::begin() const noexcept {
+		return Iterator(this, 0);
+	}
+
+	template<typename T, typename Allocator>
+	typename CircularBuffer<T, Allocator>::Iterator CircularBuffer<T, Allocator>::end() noexcept {
+		return Iterator(this, m_size);
+	}
+
+	template<typename T, typename Allocator>
+	const typename CircularBuffer<T, Allocator>::Iterator CircularBuffer<T, Allocator>::end() const noexcept {
+		return Iterator(this, m_size);
+	}
+
+	// Modifiers
+	template<typename T, typename Allocator>
+	void CircularBuffer<T, Allocator>::clear() noexcept {
+		for (size_t i = m_size; i > 0; --i)
+			AllocTraits::destroy(m_allocator, slot(i - 1));
+		m_head = 0;
+		m_size = 0;
+	}
+
+	template<typename T, typename Allocator>
+	void CircularBuffer<T, Allocator>::push_back(const T& value) {
+		emplace_back(value);
+	}
+
+	template<typename T, typename Allocator>
+	void CircularBuffer<T, Allocator>::push_back(T&& value) {
+		emplace_back(std::move(value));
+	}
+
+	template<typename T, typename Allocator>
+	void CircularBuffer<T, Allocator>::push_front(const T& value) {
+		emplace_front(value);
+	}
+
+	template<typename T, typename Allocator>
+	void CircularBuffer<T, Allocator>::push_front(T&& value) {
+		emplace_front(std::move(value));
+	}
+
+	template<typename T, typename Allocator>
+	template<typename...Args>
+	void CircularBuffer<T, Allocator>::emplace_back(Args&&...args) {
+		if (m_size == m_capacity) return grow_emplace(false, std::forward<Args>(args)...);
+		AllocTraits::construct(m_allocator, slot(m_size), std::forward<Args>(args)...);
+		++m_size;
+	}
+
+	template<typename T, typename Allocator>
+	template<typename...Args>
+	void CircularBuffer<T, Allocator>::emplace_front(Args&&...args) {
+		if (m_size == m_capacity) return grow_emplace(true, std::forward<Args>(args)...);
+		size_t head = (m_head - 1) & (m_capacity - 1);
+		AllocTraits::construct(m_allocator, m_data + head, std::forward<Args>(args)...);
+		m_head = head;
+		++m_size;
+	}
+
+	template<typename T, typename Allocator>
+	void CircularBuffer<T, Allocator>::pop_back() {
+		if (!m_size) throw OutOfRangeException("CircularBuffer");
+		AllocTraits::destroy(m_allocator, slot(--m_size));
+	}
+
+	template<typename T, typename Allocator>
+	void CircularBuffer<T, Allocator>::pop_front() {
+		if (!m_size) throw OutOfRangeException("CircularBuffer");
+		AllocTraits::destroy(m_allocator, m_data + m_head);
+		m_head = (m_head + 1) & (m_capacity - 1);
+		--m_size;
+	}
+
+	template<typename T, typename Allocator>
+	void CircularBuffer<T, Allocator>::swap(CircularBuffer& other) noexcept {
+		swap_storage(other);
+		if constexpr (AllocTraits::propagate_on_container_swap::value)
+			std::swap(m_allocator, other.m_allocator);
+	}
+
+	// Private Members
+	template<typename T, typename Allocator>
+	T* CircularBuffer<T, Allocator>::slot(size_t pos) const noexcept {
+		return m_data + ((m_head + pos) & (m_capacity - 1));
+	}
+
+	template<typename T, typename Allocator>
+	void CircularBuffer<T, Allocator>::reallocate(size_t capacity) {
+		T* data = capacity ? AllocTraits::allocate(m_allocator, capacity) : nullptr;
+		try {
+			move_to(data, capacity);
+		}
+		catch (...) {
+			AllocTraits::deallocate(m_allocator, data, capacity);
+			throw;
+		}
+	}
+
+	// Moves the elements, unwrapped, to the start of the new buffer and adopts it. All
+	// elements are built in the new buffer before any old one is destroyed, so a throwing
+	// copy leaves the buffer as it was.
+	template<typename T, typename Allocator>
+	void CircularBuffer<T, Allocator>::move_to(T* data, size_t capacity) {
+		if constexpr (is_trivially_relocatable_v<T>) {
+			if (m_size) {
+				size_t first = m_size < m_capacity - m_head ? m_size : m_capacity - m_head;
+				std::memcpy(static_cast<void*>(data), static_cast<const void*>(m_data + m_head), first * sizeof(T));
+				std::memcpy(static_cast<void*>(data + first), static_cast<const void*>(m_data), (m_size - first) * sizeof(T));
+			}
+		}
+		else {
+			size_t built = 0;
+			try {
+				for (; built < m_size; ++built)
+					AllocTraits::construct(m_allocator, data + built, std::move_if_noexcept(*slot(built)));
+			}
+			catch (...) {
+				for (size_t i = 0; i < built; ++i)
+					AllocTraits::destroy(m_allocator, data + i);
+				throw;
+			}
+			for (size_t i = 0; i < m_size; ++i)
+				AllocTraits::destroy(m_allocator, slot(i));
+		}
+		if (m_data) AllocTraits::deallocate(m_allocator, m_data, m_capacity);
+		m_data = data;
+		m_capacity = capacity;
+		m_head = 0;
+	}
+
+	// Doubles the capacity, building the new element in the new buffer before the others
+	// move, since args may refer to them. A new front goes in the last slot, where the
+	// unwrapped elements wrap around to it.
+	template<typename T, typename Allocator>
+	template<typename...Args>
+	void CircularBuffer<T, Allocator>::grow_emplace(bool front, Args&&...args) {
+		size_t capacity = m_capacity ? m_capacity * 2 : Global::CIRCULAR_BUFFER_INIT_SIZE;
+		T* data = AllocTraits::allocate(m_allocator, capacity);
+		size_t pos = front ? capacity - 1 : m_size;
+		try {
+			AllocTraits::construct(m_allocator, data + pos, std::forward<Args>(args)...);
+		}
+		catch (...) {
+			AllocTraits::deallocate(m_allocator, data, capacity);
+			throw;
+		}
+		try {
+			move_to(data, capacity);
+		}
+		catch (...) {
+			AllocTraits::destroy(m_allocator, data + pos);
+			AllocTraits::deallocate(m_allocator, data, capacity);
+			throw;
+		}
+		if (front) m_head = pos;
+		++m_size;
+	}
+
+	template<typename T, typename Allocator>
+	void CircularBuffer<T, Allocator>::swap_storage(CircularBuffer& other) noexcept {
+		std::swap(m_data, other.m_data);
+		std::swap(m_capacity, other.m_capacity);
+		std::swap(m_head, other.m_head);
+		std::swap(m_size, other.m_size);
+	}
+
+	namespace pmr {
+		template<typename T>
+		using CircularBuffer = Containers::CircularBuffer<T, std::pmr::polymorphic_allocator<T>>;
+	}
+}
\ No newline at end of file
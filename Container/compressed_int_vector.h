@@ -0,0 +1,388 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include "exception.h"
+#include "globals.h"
+#include "simd.h"
+#include "vector.h"
+
+namespace Containers {
+
+	// Vector of uint64_t stored as bit-packed blocks of block_size values
+	// Each full block is packed either frame-of-reference (value - block minimum) or, when
+	// the block is non-decreasing and that is narrower, as deltas from the previous value;
+	// every field takes the bit width of the largest one. A block of width w fills exactly
+	// 2w words, so blocks start on word boundaries and a header per block records its
+	// encoding and word offset. Random access unpacks one field (plus the deltas before it
+	// for delta blocks); iteration and to_vector unpack whole blocks with simd::unpack_bits.
+	// The last, partial block is kept unpacked until it fills, so push_back is cheap.
+	template<typename Allocator = std::allocator<uint64_t>>
+	class CompressedIntVector {
+	private:
+		struct Block {
+			uint64_t base;
+			size_t offset;
+			uint8_t width;
+			bool delta;
+		};
+
+		using BlockAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Block>;
+
+	public:
+		class Iterator;
+
+		static constexpr size_t block_size = Global::COMPRESSED_INT_BLOCK_SIZE;
+
+		static_assert(block_size % 64 == 0, "blocks must pack into whole words at every width");
+
+		CompressedIntVector() : CompressedIntVector(Allocator()) {}
+
+		explicit CompressedIntVector(const Allocator&);
+
+		template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
+		CompressedIntVector(IT, IT, const Allocator& = Allocator());
+
+		CompressedIntVector(std::initializer_list<uint64_t>, const Allocator& = Allocator());
+
+		template<typename Growth, typename VectorAllocator>
+		explicit CompressedIntVector(const Vector<uint64_t, Growth, VectorAllocator>&, const Allocator& = Allocator());
+
+		Allocator get_allocator() const noexcept;
+
+		// Element Access
+		uint64_t at(size_t) const;
+
+		uint64_t operator[](size_t) const;
+
+		uint64_t front() const;
+
+		uint64_t back() const;
+
+		// Capacity
+		bool empty() const noexcept;
+
+		size_t size() const noexcept;
+
+		size_t block_count() const noexcept;
+
+		// Bytes held by packed words, block headers and the unpacked tail
+		size_t compressed_bytes() const noexcept;
+
+		// Iterators
+		Iterator begin() const;
+
+		Iterator end() const;
+
+		// Conversion
+		// Writes all values to out, which must have room for size() elements
+		void decode(uint64_t*) const;
+
+		// Writes the values of a block to out, which must have room for block_size elements
+		size_t decode_block(size_t, uint64_t*) const;
+
+		Vector<uint64_t> to_vector() const;
+
+		// Modifiers
+		void clear() noexcept;
+
+		void push_back(uint64_t);
+
+		// Appends n values, packing whole blocks straight from the source
+		void append(const uint64_t*, size_t);
+
+		void swap(CompressedIntVector&) noexcept;
+
+	private:
+		// The packed stream keeps one trailing zero word so unpacking may read one word past
+		// the last field
+		Vector<uint64_t, DefaultGrowth, Allocator> m_words;
+		Vector<Block, DefaultGrowth, BlockAllocator> m_blocks;
+		Vector<uint64_t, DefaultGrowth, Allocator> m_tail;
+
+		void pack_block(const uint64_t*);
+
+		static uint64_t field(const uint64_t*, size_t, unsigned) noexcept;
+	};
+
+	// Forward iterator holding the decoded values of its current block
+	template<typename Allocator>
+	class CompressedIntVector<Allocator>::Iterator {
+	public:
+		Iterator() : m_vector(nullptr), m_index(0), m_block(size_t(-1)) {}
+
+		Iterator(const CompressedIntVector* vector, size_t index) : m_vector(vector), m_index(index), m_block(size_t(-1)) {}
+
+		bool operator==(const Iterator&) const;
+
+		bool operator!=(const Iterator&) const;
+
+		Iterator& operator++();
+
+		Iterator operator++(int);
+
+		uint64_t operator*();
+
+	private:
+		const CompressedIntVector* m_vector;
+		size_t m_index;
+		size_t m_block;
+		uint64_t m_values[block_size];
+	};
+
+	template<typename Allocator>
+	bool CompressedIntVector<Allocator>::Iterator::operator==(const Iterator& other) const {
+		return m_index == other.m_index;
+	}
+
+	template<typename Allocator>
+	bool CompressedIntVector<Allocator>::Iterator::operator!=(const Iterator& other) const {
+		return m_index != other.m_index;
+	}
+
+	template<typename Allocator>
+	typename CompressedIntVector<Allocator>::Iterator& CompressedIntVector<Allocator>::Iterator::operator++() {
+		++m_index;
+		return *this;
+	}
+
+	template<typename Allocator>
+	typename CompressedIntVector<Allocator>::Iterator CompressedIntVector<Allocator>::Iterator::operator++(int) {
+		Iterator it = *this;
+		++(*this);
+		return it;
+	}
+
+	template<typename Allocator>
+	uint64_t CompressedIntVector<Allocator>::Iterator::operator*() {
+		size_t block = m_index / block_size;
+		if (block != m_block) {
+			m_vector->decode_block(block, m_values);
+			m_block = block;
+		}
+		return m_values[m_index % block_size];
+	}
+
+	// Constructors
+	template<typename Allocator>
+	CompressedIntVector<Allocator>::CompressedIntVector(const Allocator& allocator) :
+		m_words(1, 0, allocator), m_blocks(BlockAllocator(allocator)), m_tail(allocator) {}
+
+	template<typename Allocator>
+	template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
+	CompressedIntVector<Allocator>::CompressedIntVector(IT first, IT last, const Allocator& allocator) : CompressedIntVector(allocator) {
+		for (; first != last; ++first) push_back(*first);
+	}
+
+	template<typename Allocator>
+	CompressedIntVector<Allocator>::CompressedIntVector(std::initializer_list<uint64_t> il, const Allocator& allocator) :
+		CompressedIntVector(allocator) {
+		append(il.begin(), il.size());
+	}
+
+	template<typename Allocator>
+	template<typename Growth, typename VectorAllocator>
+	CompressedIntVector<Allocator>::CompressedIntVector(const Vector<uint64_t, Growth, VectorAllocator>& values, const Allocator& allocator) :
+		CompressedIntVector(allocator) {
+		append(values.data(), values.size());
+	}
+
+	template<typename Allocator>
+	Allocator CompressedIntVector<Allocator>::get_allocator() const noexcept {
+		return m_words.get_allocator();
+	}
+
+	// Element Access
+	template<typename Allocator>
+	uint64_t CompressedIntVector<Allocator>::at(size_t pos) const {
+		if (pos >= size()) throw OutOfRangeException("CompressedIntVector");
+		return (*this)[pos];
+	}
+
+	template<typename Allocator>
+	uint64_t CompressedIntVector<Allocator>::operator[](size_t pos) const {
+		size_t index = pos / block_size;
+		if (index == m_blocks.size()) return m_tail[pos % block_size];
+
+		const Block& block = m_blocks[index];
+		const uint64_t* words = m_words.data() + block.offset;
+		size_t offset = pos % block_size;
+		if (!block.delta) return block.base + field(words, offset, block.width);
+		uint64_t value = block.base;
+		for (size_t i = 1; i <= offset; ++i)
+			value += field(words, i, block.width);
+		return value;
+	}
+
+	template<typename Allocator>
+	uint64_t CompressedIntVector<Allocator>::front() const {
+		if (empty()) throw OutOfRangeException("CompressedIntVector");
+		return (*this)[0];
+	}
+
+	template<typename Allocator>
+	uint64_t CompressedIntVector<Allocator>::back() const {
+		if (empty()) throw OutOfRangeException("CompressedIntVector");
+		return (*this)[size() - 1];
+	}
+
+	// Capacity
+	template<typename Allocator>
+	bool CompressedIntVector<Allocator>::empty() const noexcept { return size() == 0; }
+
+	template<typename Allocator>
+	size_t CompressedIntVector<Allocator>::size() const noexcept {
+		return m_blocks.size() * block_size + m_tail.size();
+	}
+
+	template<typename Allocator>
+	size_t CompressedIntVector<Allocator>::block_count() const noexcept {
+		return m_blocks.size();
+	}
+
+	template<typename Allocator>
+	size_t CompressedIntVector<Allocator>::compressed_bytes() const noexcept {
+		return m_words.size() * sizeof(uint64_t) + m_blocks.size() * sizeof(Block) + m_tail.size() * sizeof(uint64_t);
+	}
+
+	// Iterators
+	template<typename Allocator>
+	typename CompressedIntVector<Allocator>::Iterator CompressedIntVector<Allocator>::begin() const {
+		return Iterator(this, 0);
+	}
+
+	template<typename Allocator>
+	typename CompressedIntVector<Allocator>::Iterator CompressedIntVector<Allocator>::end() const {
+		return Iterator(this, size());
+	}
+
+	// Conversion
+	template<typename Allocator>
+	void CompressedIntVector<Allocator>::decode(uint64_t* out) const {
+		for (size_t i = 0; i < m_blocks.size(); ++i)
+			decode_block(i, out + i * block_size);
+		std::copy(m_tail.begin(), m_tail.end(), out + m_blocks.size() * block_size);
+	}
+
+	// Returns the number of values written: block_size, or the tail's size for the last block
+	template<typename Allocator>
+	size_t CompressedIntVector<Allocator>::decode_block(size_t index, uint64_t* out) const {
+		if (index == m_blocks.size()) {
+			std::copy(m_tail.begin(), m_tail.end(), out);
+			return m_tail.size();
+		}
+		if (index > m_blocks.size()) throw OutOfRangeException("CompressedIntVector");
+
+		const Block& block = m_blocks[index];
+		simd::unpack_bits(m_words.data() + block.offset, block_size, block.width, out);
+		uint64_t base = block.base;
+		if (block.delta) {
+			for (size_t i = 0; i < block_size; ++i)
+				out[i] = base += out[i];
+		}
+		else {
+			for (size_t i = 0; i < block_size; ++i)
+				out[i] += base;
+		}
+		return block_size;
+	}
+
+	template<typename Allocator>
+	Vector<uint64_t> CompressedIntVector<Allocator>::to_vector() const {
+		Vector<uint64_t> values(size());
+		decode(values.data());
+		return values;
+	}
+
+	// Modifiers
+	template<typename Allocator>
+	void CompressedIntVector<Allocator>::clear() noexcept {
+		m_words.resize(1);
+		m_words[0] = 0;
+		m_blocks.clear();
+		m_tail.clear();
+	}
+
+	template<typename Allocator>
+	void CompressedIntVector<Allocator>::push_back(uint64_t value) {
+		m_tail.push_back(value);
+		if (m_tail.size() == block_size) {
+			pack_block(m_tail.data());
+			m_tail.clear();
+		}
+	}
+
+	template<typename Allocator>
+	void CompressedIntVector<Allocator>::append(const uint64_t* values, size_t n) {
+		while (n && !m_tail.empty()) {
+			push_back(*values++);
+			--n;
+		}
+		for (; n >= block_size; values += block_size, n -= block_size)
+			pack_block(values);
+		for (; n; --n) push_back(*values++);
+	}
+
+	template<typename Allocator>
+	void CompressedIntVector<Allocator>::swap(CompressedIntVector& other) noexcept {
+		m_words.swap(other.m_words);
+		m_blocks.swap(other.m_blocks);
+		m_tail.swap(other.m_tail);
+	}
+
+	// Private Members
+	template<typename Allocator>
+	void CompressedIntVector<Allocator>::pack_block(const uint64_t* values) {
+		uint64_t low = values[0], high = values[0], gap = 0;
+		bool sorted = true;
+		for (size_t i = 1; i < block_size; ++i) {
+			low = values[i] < low ? values[i] : low;
+			high = values[i] > high ? values[i] : high;
+			sorted &= values[i] >= values[i - 1];
+			if (sorted && values[i] - values[i - 1] > gap) gap = values[i] - values[i - 1];
+		}
+		unsigned frame_width = std::bit_width(high - low);
+		unsigned delta_width = std::bit_width(gap);
+		bool delta = sorted && delta_width < frame_width;
+		unsigned width = delta ? delta_width : frame_width;
+
+		// the trailing zero word becomes the block's first word; a moved-from object has none
+		size_t offset = m_words.empty() ? 0 : m_words.size() - 1;
+		m_blocks.push_back(Block{ delta ? values[0] : low, offset, static_cast<uint8_t>(width), delta });
+		try {
+			m_words.resize(offset + block_size * width / 64 + 1, 0);
+		}
+		catch (...) {
+			m_blocks.pop_back();
+			throw;
+		}
+		if (!width) return;
+
+		uint64_t* words = m_words.data() + offset;
+		for (size_t i = 0, bit = 0; i < block_size; ++i, bit += width) {
+			uint64_t value = delta ? (i ? values[i] - values[i - 1] : 0) : values[i] - low;
+			size_t word = bit / 64, shift = bit % 64;
+			words[word] |= value << shift;
+			if (shift + width > 64) words[word + 1] |= value >> (64 - shift);
+		}
+	}
+
+	template<typename Allocator>
+	uint64_t CompressedIntVector<Allocator>::field(const uint64_t* words, size_t index, unsigned width) noexcept {
+		if (!width) return 0;
+		size_t bit = index * width, word = bit / 64, shift = bit % 64;
+		uint64_t value = words[word] >> shift;
+		if (shift + width > 64) value |= words[word + 1] << (64 - shift);
+		return width == 64 ? value : value & ((uint64_t(1) << width) - 1);
+	}
+
+	namespace pmr {
+		using CompressedIntVector = Containers::CompressedIntVector<std::pmr::polymorphic_allocator<uint64_t>>;
+	}
+}
\ No newline at end of file
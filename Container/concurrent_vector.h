@@ -0,0 +1,459 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include "exception.h"
+#include "globals.h"
+
+namespace Containers {
+
+	// Append-only vector for many producer threads
+	// Uses the block layout of StableVector: block k holds first_block << k elements and
+	// the directory lives inside the object, so growth never moves an element. push_back
+	// claims an index with a single fetch_add, and a missing block is installed with a single
+	// compare-exchange, so no thread ever waits for another: push_back is lock-free as long
+	// as the allocator is. The thread that claims the first index of a block allocates the
+	// next one, so producers rarely find a block missing; when several do, each allocates
+	// one, the first to install it wins and the rest free theirs. Each block ends with one
+	// ready bit per element.
+	// An element is published once push_back has returned its index. Another thread may
+	// read it through operator[] after learning the index through any synchronizing
+	// channel, or after published(index) returns true. size() counts claimed indices,
+	// including ones still under construction. Iteration, clear and destruction need all
+	// producers to have finished.
+	template<typename T, typename Allocator = std::allocator<T>>
+	class ConcurrentVector {
+	private:
+		using AllocTraits = std::allocator_traits<Allocator>;
+
+	public:
+		class Iterator;
+
+		static constexpr size_t first_block = Global::CONCURRENT_VECTOR_FIRST_BLOCK;
+
+		static_assert(std::has_single_bit(first_block), "the first block size must be a power of two");
+
+		static constexpr size_t max_blocks = sizeof(size_t) * 8 - std::countr_zero(first_block);
+
+		ConcurrentVector() : ConcurrentVector(Allocator()) {}
+
+		explicit ConcurrentVector(const Allocator&) noexcept;
+
+		ConcurrentVector(const ConcurrentVector&) = delete;
+
+		ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+		~ConcurrentVector();
+
+		Allocator get_allocator() const noexcept;
+
+		// Element Access
+		T& at(size_t);
+
+		const T& at(size_t) const;
+
+		T& operator[](size_t);
+
+		const T& operator[](size_t) const;
+
+		// True once the element at the index is fully constructed
+		bool published(size_t) const noexcept;
+
+		// Capacity
+		bool empty() const noexcept;
+
+		size_t size() const noexcept;
+
+		// Allocates blocks ahead of time; safe to call while other threads append
+		void reserve(size_t);
+
+		size_t capacity() const noexcept;
+
+		// Iterators
+		Iterator begin() noexcept;
+
+		const Iterator begin() const noexcept;
+
+		Iterator end() noexcept;
+
+		const Iterator end() const noexcept;
+
+		// Modifiers
+		size_t push_back(const T&);
+
+		size_t push_back(T&&);
+
+		// Returns the index of the new element
+		template<typename...Args>
+		size_t emplace_back(Args&&...);
+
+		void clear() noexcept;
+
+	private:
+		Allocator m_allocator;
+		std::atomic<T*> m_blocks[max_blocks];
+		// written by every producer, so kept off the cache line of the directory
+		alignas(64) std::atomic<size_t> m_size;
+
+		static constexpr size_t block_size(size_t) noexcept;
+
+		// Elements allocated for a block, including the room taken by its ready bits
+		static constexpr size_t block_allocation(size_t) noexcept;
+
+		static constexpr size_t capacity_of(size_t) noexcept;
+
+		static void locate(size_t, size_t&, size_t&) noexcept;
+
+		static unsigned char* flags(T*, size_t) noexcept;
+
+		static constexpr unsigned char ready_bit(size_t) noexcept;
+
+		T* block_for(size_t);
+
+		T* allocate_block(size_t);
+
+		void release() noexcept;
+	};
+
+	template<typename T, typename Allocator>
+	class ConcurrentVector<T, Allocator>::Iterator {
+	public:
+		Iterator() : m_vector(nullptr), m_index(0) {}
+
+		Iterator(const ConcurrentVector* vector, size_t index) : m_vector(vector), m_index(index) {}
+
+		Iterator(const Iterator& other) : m_vector(other.m_vector), m_index(other.m_index) {}
+
+		Iterator& operator=(const Iterator&) = default;
+
+		bool operator==(const Iterator&) const;
+
+		bool operator!=(const Iterator&) const;
+
+		Iterator& operator++();
+
+		Iterator operator++(int);
+
+		Iterator operator+(int) const;
+
+		Iterator& operator+=(int);
+
+		Iterator& operator--();
+
+		Iterator operator--(int);
+
+		Iterator operator-(int) const;
+
+		Iterator& operator-=(int);
+
+		size_t operator-(const Iterator&) const;
+
+		T& operator*() const;
+
+		T* operator->() const;
+
+	private:
+		const ConcurrentVector* m_vector;
+		size_t m_index;
+	};
+
+	template<typename T, typename Allocator>
+	bool ConcurrentVector<T, Allocator>::Iterator::operator==(const Iterator& other) const {
+		return m_index == other.m_index;
+	}
+
+	template<typename T, typename Allocator>
+	bool ConcurrentVector<T, Allocator>::Iterator::operator!=(const Iterator& other) const {
+		return m_index != other.m_index;
+	}
+
+	template<typename T, typename Allocator>
+	typename ConcurrentVector<T, Allocator>::Iterator& ConcurrentVector<T, Allocator>::Iterator::operator++() {
+		++m_index;
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	typename ConcurrentVector<T, Allocator>::Iterator ConcurrentVector<T, Allocator>::Iterator::operator++(int) {
+		Iterator it = *this;
+		++(*this);
+		return it;
+	}
+
+	template<typename T, typename Allocator>
+	typename ConcurrentVector<T, Allocator>::Iterator ConcurrentVector<T, Allocator>::Iterator::operator+(int steps) const {
+		Iterator it = *this;
+		it.m_index += steps;
+		return it;
+	}
+
+	template<typename T, typename Allocator>
+	typename ConcurrentVector<T, Allocator>::Iterator& ConcurrentVector<T, Allocator>::Iterator::operator+=(int steps) {
+		m_index += steps;
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	typename ConcurrentVector<T, Allocator>::Iterator& ConcurrentVector<T, Allocator>::Iterator::operator--() {
+		--m_index;
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	typename ConcurrentVector<T, Allocator>::Iterator ConcurrentVector<T, Allocator>::Iterator::operator--(int) {
+		Iterator it = *this;
+		--(*this);
+		return it;
+	}
+
+	template<typename T, typename Allocator>
+	typename ConcurrentVector<T, Allocator>::Iterator ConcurrentVector<T, Allocator>::Iterator::operator-(int steps) const {
+		Iterator it = *this;
+		it.m_index -= steps;
+		return it;
+	}
+
+	template<typename T, typename Allocator>
+	typename ConcurrentVector<T, Allocator>::Iterator& ConcurrentVector<T, Allocator>::Iterator::operator-=(int steps) {
+		m_index -= steps;
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	size_t ConcurrentVector<T, Allocator>::Iterator::operator-(const Iterator& other) const {
+		return m_index - other.m_index;
+	}
+
+	template<typename T, typename Allocator>
+	T& ConcurrentVector<T, Allocator>::Iterator::operator*() const {
+		return const_cast<T&>((*m_vector)[m_index]);
+	}
+
+	template<typename T, typename Allocator>
+	T* ConcurrentVector<T, Allocator>::Iterator::operator->() const {
+		return &**this;
+	}
+
+	// Constructors
+	template<typename T, typename Allocator>
+	ConcurrentVector<T, Allocator>::ConcurrentVector(const Allocator& allocator) noexcept :
+		m_allocator(allocator), m_blocks(), m_size(0) {}
+
+	template<typename T, typename Allocator>
+	ConcurrentVector<T, Allocator>::~ConcurrentVector() {
+		release();
+	}
+
+	template<typename T, typename Allocator>
+	Allocator ConcurrentVector<T, Allocator>::get_allocator() const noexcept {
+		return m_allocator;
+	}
+
+	// Element Access
+	template<typename T, typename Allocator>
+	T& ConcurrentVector<T, Allocator>::at(size_t pos) {
+		if (!published(pos)) throw OutOfRangeException("ConcurrentVector");
+		return (*this)[pos];
+	}
+
+	template<typename T, typename Allocator>
+	const T& ConcurrentVector<T, Allocator>::at(size_t pos) const {
+		if (!published(pos)) throw OutOfRangeException("ConcurrentVector");
+		return (*this)[pos];
+	}
+
+	template<typename T, typename Allocator>
+	T& ConcurrentVector<T, Allocator>::operator[](size_t pos) {
+		size_t block, offset;
+		locate(pos, block, offset);
+		return m_blocks[block].load(std::memory_order_acquire)[offset];
+	}
+
+	template<typename T, typename Allocator>
+	const T& ConcurrentVector<T, Allocator>::operator[](size_t pos) const {
+		size_t block, offset;
+		locate(pos, block, offset);
+		return m_blocks[block].load(std::memory_order_acquire)[offset];
+	}
+
+	template<typename T, typename Allocator>
+	bool ConcurrentVector<T, Allocator>::published(size_t pos) const noexcept {
+		if (pos >= m_size.load(std::memory_order_acquire)) return false;
+		size_t block, offset;
+		locate(pos, block, offset);
+		T* data = m_blocks[block].load(std::memory_order_acquire);
+		return data && std::atomic_ref<unsigned char>(flags(data, block)[offset / 8]).load(std::memory_order_acquire) & ready_bit(offset);
+	}
+
+	// Capacity
+	template<typename T, typename Allocator>
+	bool ConcurrentVector<T, Allocator>::empty() const noexcept { return size() == 0; }
+
+	template<typename T, typename Allocator>
+	size_t ConcurrentVector<T, Allocator>::size() const noexcept {
+		return m_size.load(std::memory_order_acquire);
+	}
+
+	template<typename T, typename Allocator>
+	void ConcurrentVector<T, Allocator>::reserve(size_t capacity) {
+		for (size_t block = 0; capacity_of(block) < capacity; ++block)
+			block_for(capacity_of(block));
+	}
+
+	template<typename T, typename Allocator>
+	size_t ConcurrentVector<T, Allocator>::capacity() const noexcept {
+		size_t blocks = 0;
+		while (blocks < max_blocks) {
+			T* data = m_blocks[blocks].load(std::memory_order_acquire);
+			if (!data) break;
+			++blocks;
+		}
+		return capacity_of(blocks);
+	}
+
+	// Iterators
+	template<typename T, typename Allocator>
+	typename ConcurrentVector<T, Allocator>::Iterator ConcurrentVector<T, Allocator>::begin() noexcept {
+		return Iterator(this, 0);
+	}
+
+	template<typename T, typename Allocator>
+	const typename ConcurrentVector<T, Allocator>::Iterator ConcurrentVector<T, Allocator>::begin() const noexcept {
+		return Iterator(this, 0);
+	}
+
+	template<typename T, typename Allocator>
+	typename ConcurrentVector<T, Allocator>::Iterator ConcurrentVector<T, Allocator>::end() noexcept {
+		return Iterator(this, size());
+	}
+
+	template<typename T, typename Allocator>
+	const typename ConcurrentVector<T, Allocator>::Iterator ConcurrentVector<T, Allocator>::end() const noexcept {
+		return Iterator(this, size());
+	}
+
+	// Modifiers
+	template<typename T, typename Allocator>
+	size_t ConcurrentVector<T, Allocator>::push_back(const T& value) {
+		return emplace_back(value);
+	}
+
+	template<typename T, typename Allocator>
+	size_t ConcurrentVector<T, Allocator>::push_back(T&& value) {
+		return emplace_back(std::move(value));
+	}
+
+	// If construction throws, the index stays claimed but is never published, and the
+	// destructor skips it
+	template<typename T, typename Allocator>
+	template<typename...Args>
+	size_t ConcurrentVector<T, Allocator>::emplace_back(Args&&...args) {
+		size_t index = m_size.fetch_add(1, std::memory_order_relaxed);
+		T* data = block_for(index);
+		size_t block, offset;
+		locate(index, block, offset);
+		AllocTraits::construct(m_allocator, data + offset, std::forward<Args>(args)...);
+		std::atomic_ref<unsigned char>(flags(data, block)[offset / 8]).fetch_or(ready_bit(offset), std::memory_order_release);
+		if (!offset && block + 1 < max_blocks && !m_blocks[block + 1].load(std::memory_order_relaxed)) {
+			// only a head start for the next block; the thread that needs it allocates it
+			// again and reports the failure then
+			try {
+				allocate_block(block + 1);
+			}
+			catch (...) {}
+		}
+		return index;
+	}
+
+	template<typename T, typename Allocator>
+	void ConcurrentVector<T, Allocator>::clear() noexcept {
+		size_t size = m_size.load(std::memory_order_relaxed);
+		for (size_t i = 0; i < size; ++i) {
+			size_t block, offset;
+			locate(i, block, offset);
+			T* data = m_blocks[block].load(std::memory_order_relaxed);
+			if (!data || !(flags(data, block)[offset / 8] & ready_bit(offset))) continue;
+			AllocTraits::destroy(m_allocator, data + offset);
+			flags(data, block)[offset / 8] &= ~ready_bit(offset);
+		}
+		m_size.store(0, std::memory_order_relaxed);
+	}
+
+	// Private Members
+	template<typename T, typename Allocator>
+	constexpr size_t ConcurrentVector<T, Allocator>::block_size(size_t block) noexcept {
+		return first_block << block;
+	}
+
+	template<typename T, typename Allocator>
+	constexpr size_t ConcurrentVector<T, Allocator>::block_allocation(size_t block) noexcept {
+		return block_size(block) + ((block_size(block) + 7) / 8 + sizeof(T) - 1) / sizeof(T);
+	}
+
+	template<typename T, typename Allocator>
+	constexpr size_t ConcurrentVector<T, Allocator>::capacity_of(size_t blocks) noexcept {
+		return blocks ? first_block * ((size_t(2) << (blocks - 1)) - 1) : 0;
+	}
+
+	template<typename T, typename Allocator>
+	void ConcurrentVector<T, Allocator>::locate(size_t pos, size_t& block, size_t& offset) noexcept {
+		constexpr size_t shift = std::countr_zero(first_block);
+		size_t shifted = pos + first_block;
+		block = std::bit_width(shifted) - 1 - shift;
+		offset = shifted - (first_block << block);
+	}
+
+	template<typename T, typename Allocator>
+	unsigned char* ConcurrentVector<T, Allocator>::flags(T* data, size_t block) noexcept {
+		return reinterpret_cast<unsigned char*>(data + block_size(block));
+	}
+
+	template<typename T, typename Allocator>
+	constexpr unsigned char ConcurrentVector<T, Allocator>::ready_bit(size_t offset) noexcept {
+		return static_cast<unsigned char>(1u << (offset % 8));
+	}
+
+	// Block holding pos, allocating it if no thread has yet
+	template<typename T, typename Allocator>
+	T* ConcurrentVector<T, Allocator>::block_for(size_t pos) {
+		size_t block, offset;
+		locate(pos, block, offset);
+		T* data = m_blocks[block].load(std::memory_order_acquire);
+		return data ? data : allocate_block(block);
+	}
+
+	// Allocates a block and installs it with a compare-exchange. A thread that loses the
+	// race frees its block and returns the one installed first.
+	template<typename T, typename Allocator>
+	T* ConcurrentVector<T, Allocator>::allocate_block(size_t block) {
+		T* fresh = AllocTraits::allocate(m_allocator, block_allocation(block));
+		std::memset(flags(fresh, block), 0, (block_size(block) + 7) / 8);
+		T* data = nullptr;
+		if (m_blocks[block].compare_exchange_strong(data, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+			return fresh;
+		AllocTraits::deallocate(m_allocator, fresh, block_allocation(block));
+		return data;
+	}
+
+	template<typename T, typename Allocator>
+	void ConcurrentVector<T, Allocator>::release() noexcept {
+		clear();
+		for (size_t i = 0; i < max_blocks; ++i) {
+			T* data = m_blocks[i].load(std::memory_order_relaxed);
+			if (data) AllocTraits::deallocate(m_allocator, data, block_allocation(i));
+		}
+	}
+
+	namespace pmr {
+		// Producers allocate blocks concurrently through the one resource, so it must be
+		// safe to use from several threads at once, such as std::pmr::synchronized_pool_resource
+		// or new_delete_resource(); unsynchronized_pool_resource and monotonic_buffer_resource
+		// are not
+		template<typename T>
+		using ConcurrentVector = Containers::ConcurrentVector<T, std::pmr::polymorphic_allocator<T>>;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,278 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "exception.h"
+#include "simd.h"
+
+namespace Containers {
+
+	// Lazy element-wise arithmetic over numeric containers
+	// a * 2 + b builds a small tree of nodes that only hold pointers and scalars; nothing is
+	// computed until the tree is assigned to a Vector or reduced, and then every element is
+	// produced by one fused loop. A node refers to the containers it was built from, so it
+	// must not outlive them: store results in a Vector, not in an auto variable.
+
+	struct ExpressionBase {};
+
+	template<typename E>
+	inline constexpr bool is_vector_expression_v = std::is_base_of_v<ExpressionBase, E>;
+
+	// Contiguous containers of arithmetic elements that can appear in an expression;
+	// specialized next to each container
+	template<typename C>
+	struct is_numeric_container : std::false_type {};
+
+	template<typename C>
+	inline constexpr bool is_numeric_container_v = is_numeric_container<C>::value;
+
+	namespace expression {
+
+		template<typename T>
+		struct Terminal : ExpressionBase {
+			using value_type = T;
+
+			const T* m_data;
+			size_t m_size;
+
+			Terminal(const T* data, size_t size) : m_data(data), m_size(size) {}
+
+			size_t size() const noexcept { return m_size; }
+
+			T operator[](size_t i) const noexcept { return m_data[i]; }
+		};
+
+		template<typename T>
+		struct Scalar {
+			using value_type = T;
+
+			T m_value;
+
+			explicit Scalar(T value) : m_value(value) {}
+
+			T operator[](size_t) const noexcept { return m_value; }
+		};
+
+		template<typename E>
+		size_t size_of(const E& operand) noexcept {
+			if constexpr (is_vector_expression_v<E>) return operand.size();
+			else return 0;
+		}
+
+		template<typename Op, typename L, typename R>
+		struct Binary : ExpressionBase {
+			using value_type = decltype(Op()(std::declval<typename L::value_type>(), std::declval<typename R::value_type>()));
+
+			L m_lhs;
+			R m_rhs;
+			size_t m_size;
+
+			Binary(const L& lhs, const R& rhs) : m_lhs(lhs), m_rhs(rhs) {
+				size_t left = size_of(lhs), right = size_of(rhs);
+				if constexpr (is_vector_expression_v<L> && is_vector_expression_v<R>) {
+					if (left != right) throw ContainerException("Vector", "Size Mismatch");
+				}
+				m_size = std::max(left, right);
+			}
+
+			size_t size() const noexcept { return m_size; }
+
+			value_type operator[](size_t i) const noexcept { return Op()(m_lhs[i], m_rhs[i]); }
+		};
+
+		template<typename Op, typename E>
+		struct Unary : ExpressionBase {
+			using value_type = decltype(Op()(std::declval<typename E::value_type>()));
+
+			E m_operand;
+
+			explicit Unary(const E& operand) : m_operand(operand) {}
+
+			size_t size() const noexcept { return m_operand.size(); }
+
+			value_type operator[](size_t i) const noexcept { return Op()(m_operand[i]); }
+		};
+
+		template<typename X>
+		inline constexpr bool is_operand_v =
+			is_vector_expression_v<X> || is_numeric_container_v<X> || std::is_arithmetic_v<X>;
+
+		// At least one side has to be a container or expression, so plain arithmetic and
+		// unrelated operator overloads are left alone
+		template<typename L, typename R>
+		inline constexpr bool is_operation_v =
+			is_operand_v<L> && is_operand_v<R> && !(std::is_arithmetic_v<L> && std::is_arithmetic_v<R>);
+
+		template<typename X>
+		auto wrap(const X& operand) {
+			if constexpr (is_vector_expression_v<X>) return operand;
+			else if constexpr (is_numeric_container_v<X>)
+				return Terminal<std::remove_cv_t<std::remove_pointer_t<decltype(operand.data())>>>(operand.data(), operand.size());
+			else return Scalar<X>(operand);
+		}
+
+		template<typename Op, typename L, typename R>
+		auto make_binary(const L& lhs, const R& rhs) {
+			using WL = decltype(wrap(lhs));
+			using WR = decltype(wrap(rhs));
+			return Binary<Op, WL, WR>(wrap(lhs), wrap(rhs));
+		}
+
+		struct Min {
+			template<typename A, typename B>
+			auto operator()(A a, B b) const noexcept { return b < a ? b : a; }
+		};
+
+		struct Max {
+			template<typename A, typename B>
+			auto operator()(A a, B b) const noexcept { return a < b ? b : a; }
+		};
+
+		// Kernels
+		// Written as plain loops over independent accumulators so the compiler vectorizes
+		// them; each is instantiated once per instruction set and picked at runtime.
+
+		template<size_t Lanes, typename Acc, typename E, typename Op>
+		inline Acc reduce_lanes(const E& operand, size_t first, size_t n, Acc init, Op op) noexcept {
+			Acc acc[Lanes];
+			for (size_t j = 0; j < Lanes; ++j) acc[j] = init;
+			size_t i = first;
+			for (; i + Lanes <= n; i += Lanes) {
+				for (size_t j = 0; j < Lanes; ++j)
+					acc[j] = op(acc[j], static_cast<Acc>(operand[i + j]));
+			}
+			// Folding pairwise keeps the accumulators in registers through the main loop
+			for (size_t width = Lanes / 2; width; width /= 2) {
+				for (size_t j = 0; j < width; ++j)
+					acc[j] = op(acc[j], acc[j + width]);
+			}
+			for (; i < n; ++i)
+				acc[0] = op(acc[0], static_cast<Acc>(operand[i]));
+			return acc[0];
+		}
+
+		template<typename T, typename E>
+		inline void evaluate_loop(const E& operand, T* out, size_t n) noexcept {
+			for (size_t i = 0; i < n; ++i)
+				out[i] = static_cast<T>(operand[i]);
+		}
+
+#if CONTAINERS_SIMD_X86
+		template<typename Acc, typename E, typename Op>
+		CONTAINERS_SIMD_TARGET("sse2") Acc reduce_sse2(const E& operand, size_t first, size_t n, Acc init, Op op) noexcept {
+			return reduce_lanes<2 * 16 / sizeof(Acc)>(operand, first, n, init, op);
+		}
+
+		template<typename Acc, typename E, typename Op>
+		CONTAINERS_SIMD_TARGET("avx2") Acc reduce_avx2(const E& operand, size_t first, size_t n, Acc init, Op op) noexcept {
+			return reduce_lanes<2 * 32 / sizeof(Acc)>(operand, first, n, init, op);
+		}
+
+		template<typename Acc, typename E, typename Op>
+		CONTAINERS_SIMD_TARGET("avx512f,avx512bw") Acc reduce_avx512(const E& operand, size_t first, size_t n, Acc init, Op op) noexcept {
+			return reduce_lanes<2 * 64 / sizeof(Acc)>(operand, first, n, init, op);
+		}
+
+		template<typename T, typename E>
+		CONTAINERS_SIMD_TARGET("avx2") void evaluate_avx2(const E& operand, T* out, size_t n) noexcept {
+			evaluate_loop(operand, out, n);
+		}
+
+		template<typename T, typename E>
+		CONTAINERS_SIMD_TARGET("avx512f,avx512bw") void evaluate_avx512(const E& operand, T* out, size_t n) noexcept {
+			evaluate_loop(operand, out, n);
+		}
+#endif
+
+		template<typename Acc, typename E, typename Op>
+		Acc reduce(const E& operand, size_t first, size_t n, Acc init, Op op) noexcept {
+#if CONTAINERS_SIMD_X86
+			switch (simd::active_isa()) {
+			case simd::Isa::AVX512: return reduce_avx512(operand, first, n, init, op);
+			case simd::Isa::AVX2: return reduce_avx2(operand, first, n, init, op);
+			case simd::Isa::SSE2: return reduce_sse2(operand, first, n, init, op);
+			default: break;
+			}
+#endif
+			return reduce_lanes<4>(operand, first, n, init, op);
+		}
+
+		// Writes every element of operand to out, which may be one of the operand's own
+		// containers since element i only reads index i
+		template<typename T, typename E>
+		void evaluate(const E& operand, T* out) noexcept {
+#if CONTAINERS_SIMD_X86
+			switch (simd::active_isa()) {
+			case simd::Isa::AVX512: evaluate_avx512(operand, out, operand.size()); return;
+			case simd::Isa::AVX2: evaluate_avx2(operand, out, operand.size()); return;
+			default: break;
+			}
+#endif
+			evaluate_loop(operand, out, operand.size());
+		}
+	}
+
+	// Element-wise Operators
+	template<typename L, typename R, std::enable_if_t<expression::is_operation_v<L, R>>...>
+	auto operator+(const L& lhs, const R& rhs) {
+		return expression::make_binary<std::plus<>>(lhs, rhs);
+	}
+
+	template<typename L, typename R, std::enable_if_t<expression::is_operation_v<L, R>>...>
+	auto operator-(const L& lhs, const R& rhs) {
+		return expression::make_binary<std::minus<>>(lhs, rhs);
+	}
+
+	template<typename L, typename R, std::enable_if_t<expression::is_operation_v<L, R>>...>
+	auto operator*(const L& lhs, const R& rhs) {
+		return expression::make_binary<std::multiplies<>>(lhs, rhs);
+	}
+
+	template<typename L, typename R, std::enable_if_t<expression::is_operation_v<L, R>>...>
+	auto operator/(const L& lhs, const R& rhs) {
+		return expression::make_binary<std::divides<>>(lhs, rhs);
+	}
+
+	template<typename X, std::enable_if_t<is_vector_expression_v<X> || is_numeric_container_v<X>>...>
+	auto operator-(const X& operand) {
+		using W = decltype(expression::wrap(operand));
+		return expression::Unary<std::negate<>, W>(expression::wrap(operand));
+	}
+
+	// Reductions
+	// Integer elements narrower than int are summed as int, like the arithmetic
+	// operators do; floating-point sums are reassociated across lanes.
+
+	template<typename X, std::enable_if_t<is_vector_expression_v<X> || is_numeric_container_v<X>>...>
+	auto sum(const X& operand) {
+		auto terms = expression::wrap(operand);
+		using T = typename decltype(terms)::value_type;
+		using Acc = decltype(std::declval<T>() + std::declval<T>());
+		return expression::reduce(terms, 0, terms.size(), Acc(0), std::plus<>());
+	}
+
+	template<typename X, std::enable_if_t<is_vector_expression_v<X> || is_numeric_container_v<X>>...>
+	auto min(const X& operand) {
+		auto terms = expression::wrap(operand);
+		using T = typename decltype(terms)::value_type;
+		if (!terms.size()) throw OutOfRangeException("Vector");
+		return expression::reduce(terms, 1, terms.size(), static_cast<T>(terms[0]), expression::Min());
+	}
+
+	template<typename X, std::enable_if_t<is_vector_expression_v<X> || is_numeric_container_v<X>>...>
+	auto max(const X& operand) {
+		auto terms = expression::wrap(operand);
+		using T = typename decltype(terms)::value_type;
+		if (!terms.size()) throw OutOfRangeException("Vector");
+		return expression::reduce(terms, 1, terms.size(), static_cast<T>(terms[0]), expression::Max());
+	}
+
+	template<typename X, typename Y,
+		std::enable_if_t<(is_vector_expression_v<X> || is_numeric_container_v<X>) &&
+		(is_vector_expression_v<Y> || is_numeric_container_v<Y>)>...>
+	auto dot(const X& lhs, const Y& rhs) {
+		return sum(expression::make_binary<std::multiplies<>>(lhs, rhs));
+	}
+}
\ No newline at end of file
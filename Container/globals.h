@@ -1,9 +1,18 @@
 #pragma once
+#include <cstddef>
 
 namespace Global {
-	extern size_t VECTOR_INIT_SIZE;
-	extern double VECTOR_RESIZE_FACTOR;
-	extern size_t UNORDERED_MAP_INIT_BUCKET_COUNT;
-	extern double UNORDERED_MAP_INIT_LOAD_FACTOR;
-	extern double UNORDERED_MAP_RESIZE_FACTOR;
+	inline constexpr size_t VECTOR_INIT_SIZE = 2;
+	inline constexpr size_t VECTOR_RESIZE_FACTOR = 2;
+	inline constexpr size_t UNORDERED_MAP_INIT_BUCKET_COUNT = 16;
+	inline constexpr double UNORDERED_MAP_INIT_LOAD_FACTOR = 1.0;
+	inline constexpr size_t UNORDERED_MAP_RESIZE_FACTOR = 2;
+	inline constexpr size_t PARALLEL_CHUNK_BYTES = 64 * 1024;
+	inline constexpr size_t HUGE_PAGE_THRESHOLD = 8 * 1024 * 1024;
+	inline constexpr size_t STABLE_VECTOR_FIRST_BLOCK = 16;
+	inline constexpr size_t CONCURRENT_VECTOR_FIRST_BLOCK = 64;
+	inline constexpr size_t COMPRESSED_INT_BLOCK_SIZE = 128;
+	inline constexpr size_t PERSISTENT_VECTOR_BITS = 5;
+	inline constexpr size_t CIRCULAR_BUFFER_INIT_SIZE = 16;
+	inline constexpr size_t RADIX_SORT_THRESHOLD = 256;
 }
\ No newline at end of file
@@ -0,0 +1,126 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include "globals.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#endif
+
+namespace Containers {
+
+	// Allocator for very large buffers
+	// Blocks of at least Threshold bytes are mapped straight from the OS in whole huge
+	// pages instead of coming from the heap. On Linux they are advised for transparent
+	// huge pages, cutting TLB misses on scans, and reallocate() grows or shrinks them with
+	// mremap, which moves page table entries rather than bytes: a Vector of trivially
+	// relocatable elements then never holds two copies of its buffer while growing.
+	// Smaller blocks, and every block on platforms without mremap, behave as with
+	// std::allocator. Opt in per Vector:
+	//     Vector<float, DefaultGrowth, HugePageAllocator<float>> samples;
+
+	template<typename T, size_t Threshold = Global::HUGE_PAGE_THRESHOLD>
+	class HugePageAllocator {
+	public:
+		using value_type = T;
+
+		using is_always_equal = std::true_type;
+
+		template<typename U>
+		struct rebind {
+			using other = HugePageAllocator<U, Threshold>;
+		};
+
+		static constexpr size_t page_size = size_t(2) * 1024 * 1024;
+
+		HugePageAllocator() noexcept = default;
+
+		template<typename U>
+		HugePageAllocator(const HugePageAllocator<U, Threshold>&) noexcept {}
+
+		T* allocate(size_t);
+
+		void deallocate(T*, size_t) noexcept;
+
+		T* reallocate(T*, size_t, size_t) noexcept;
+
+		// Whether a block of n elements is mapped from the OS rather than the heap
+		static constexpr bool is_mapped(size_t) noexcept;
+
+		template<typename U>
+		bool operator==(const HugePageAllocator<U, Threshold>&) const noexcept { return true; }
+
+		template<typename U>
+		bool operator!=(const HugePageAllocator<U, Threshold>&) const noexcept { return false; }
+
+	private:
+		static constexpr size_t mapped_bytes(size_t) noexcept;
+	};
+
+	template<typename T, size_t Threshold>
+	T* HugePageAllocator<T, Threshold>::allocate(size_t n) {
+		if (n > size_t(-1) / sizeof(T)) throw std::bad_array_new_length();
+		if (!is_mapped(n)) return std::allocator<T>().allocate(n);
+		size_t bytes = mapped_bytes(n);
+#if defined(_WIN32)
+		void* block = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+		if (!block) throw std::bad_alloc();
+#else
+		void* block = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (block == MAP_FAILED) throw std::bad_alloc();
+#if defined(MADV_HUGEPAGE)
+		madvise(block, bytes, MADV_HUGEPAGE);
+#endif
+#endif
+		return static_cast<T*>(block);
+	}
+
+	template<typename T, size_t Threshold>
+	void HugePageAllocator<T, Threshold>::deallocate(T* data, size_t n) noexcept {
+		if (!is_mapped(n)) {
+			std::allocator<T>().deallocate(data, n);
+			return;
+		}
+#if defined(_WIN32)
+		VirtualFree(data, 0, MEM_RELEASE);
+#else
+		munmap(data, mapped_bytes(n));
+#endif
+	}
+
+	// Only mapped blocks that stay mapped can be remapped; anything crossing the threshold
+	// is left to the caller's allocate-and-relocate path
+	template<typename T, size_t Threshold>
+	T* HugePageAllocator<T, Threshold>::reallocate(T* data, size_t old_n, size_t new_n) noexcept {
+		if (!is_mapped(old_n) || !is_mapped(new_n)) return nullptr;
+		size_t old_bytes = mapped_bytes(old_n), new_bytes = mapped_bytes(new_n);
+		if (old_bytes == new_bytes) return data;
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+		void* block = mremap(data, old_bytes, new_bytes, MREMAP_MAYMOVE);
+		if (block == MAP_FAILED) return nullptr;
+#if defined(MADV_HUGEPAGE)
+		if (new_bytes > old_bytes) madvise(block, new_bytes, MADV_HUGEPAGE);
+#endif
+		return static_cast<T*>(block);
+#else
+		return nullptr;
+#endif
+	}
+
+	template<typename T, size_t Threshold>
+	constexpr bool HugePageAllocator<T, Threshold>::is_mapped(size_t n) noexcept {
+		return n && n >= (Threshold + sizeof(T) - 1) / sizeof(T);
+	}
+
+	template<typename T, size_t Threshold>
+	constexpr size_t HugePageAllocator<T, Threshold>::mapped_bytes(size_t n) noexcept {
+		return (n * sizeof(T) + page_size - 1) / page_size * page_size;
+	}
+}
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 #include <initializer_list>
 #include <iostream>
+#include <memory>
+#include <memory_resource>
 #include <type_traits>
 #include <utility>
 #include "globals.h"
@@ -8,30 +10,44 @@
 
 namespace Containers {
 
-	template<typename T>
+	template<typename T, typename Allocator = std::allocator<T>>
 	class LinkedList {
+		struct ListNode;
+		using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<ListNode>;
+		using NodeTraits = std::allocator_traits<NodeAllocator>;
 	public:
 		LinkedList();
 
-		LinkedList(size_t, const T&);
+		explicit LinkedList(const Allocator&);
+
+		LinkedList(size_t, const T&, const Allocator& = Allocator());
 
 		template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
-		LinkedList(IT, IT);
+		LinkedList(IT, IT, const Allocator& = Allocator());
 
 		LinkedList(const LinkedList&);
 
-		LinkedList(LinkedList&&) noexcept;
+		LinkedList(const LinkedList&, const Allocator&);
+
+		// Not noexcept: the moved-from list is left with a freshly allocated end node
+		LinkedList(LinkedList&&);
+
+		LinkedList(LinkedList&&, const Allocator&);
 
-		LinkedList(std::initializer_list<T>);
+		LinkedList(std::initializer_list<T>, const Allocator& = Allocator());
 
 		~LinkedList();
 
 		LinkedList& operator=(const LinkedList&);
 		
-		LinkedList& operator=(LinkedList&&) noexcept;
+		LinkedList& operator=(LinkedList&&) noexcept(
+			NodeTraits::propagate_on_container_move_assignment::value ||
+			NodeTraits::is_always_equal::value);
 		
 		LinkedList& operator=(std::initializer_list<T>);
 
+		Allocator get_allocator() const noexcept;
+
 		// Element Access
 		T& front();
 
@@ -107,12 +123,18 @@ namespace Containers {
 		// Operations
 
 	private:
-		struct ListNode; 
-
+		NodeAllocator m_allocator;
 		ListNode* m_head;
 		ListNode* m_tail;
 		size_t m_size;
 
+		template<typename...Args>
+		ListNode* create_node(Args&&...);
+
+		void destroy_node(ListNode*) noexcept;
+
+		void swap_storage(LinkedList&) noexcept;
+
 		void insert_between(ListNode*, ListNode*, ListNode*);
 
 		void insert_n(ListNode*, size_t, const T&);
@@ -123,8 +145,8 @@ namespace Containers {
 		void erase(ListNode*);
 	};
 
-	template<typename T>
-	class LinkedList<T>::Iterator {
+	template<typename T, typename Allocator>
+	class LinkedList<T, Allocator>::Iterator {
 	public:
 		Iterator() : m_pointer(nullptr) {}
 
@@ -167,8 +189,8 @@ namespace Containers {
 		friend class LinkedList;
 	};
 
-	template<typename T>
-	struct LinkedList<T>::ListNode {
+	template<typename T, typename Allocator>
+	struct LinkedList<T, Allocator>::ListNode {
 		T value;
 		ListNode* next;
 		ListNode* prev;
@@ -179,155 +201,194 @@ namespace Containers {
 			value(std::move(value)), prev(nullptr), next(nullptr) {}
 	};
 
-	template<typename T>
-	LinkedList<T>::LinkedList() :
-		m_head(new ListNode()), m_tail(m_head), m_size(0) {}
+	template<typename T, typename Allocator>
+	LinkedList<T, Allocator>::LinkedList() :
+		LinkedList(Allocator()) {}
+
+	template<typename T, typename Allocator>
+	LinkedList<T, Allocator>::LinkedList(const Allocator& allocator) :
+		m_allocator(allocator), m_head(create_node()), m_tail(m_head), m_size(0) {}
 
-	template<typename T>
-	LinkedList<T>::LinkedList(size_t size, const T& init_val) :
-		LinkedList() {
+	template<typename T, typename Allocator>
+	LinkedList<T, Allocator>::LinkedList(size_t size, const T& init_val, const Allocator& allocator) :
+		LinkedList(allocator) {
 		insert_n(nullptr, size, init_val);
 	}
 
-	template<typename T>
+	template<typename T, typename Allocator>
 	template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
-	LinkedList<T>::LinkedList(IT first, IT last) :
-		LinkedList() {
+	LinkedList<T, Allocator>::LinkedList(IT first, IT last, const Allocator& allocator) :
+		LinkedList(allocator) {
 		insert_range(0, first, last);
 	}
 
-	template<typename T>
-	LinkedList<T>::LinkedList(const LinkedList& other) :
-		LinkedList(other.begin(), other.end()) {}
+	template<typename T, typename Allocator>
+	LinkedList<T, Allocator>::LinkedList(const LinkedList& other) :
+		LinkedList(other, NodeTraits::select_on_container_copy_construction(other.m_allocator)) {}
 
-	template<typename T>
-	LinkedList<T>::LinkedList(LinkedList&& other) noexcept :
-		m_head(std::move(other.m_head)), 
-		m_tail(std::move(other.m_tail)), 
-		m_size(std::move(other.m_size)) {}
+	template<typename T, typename Allocator>
+	LinkedList<T, Allocator>::LinkedList(const LinkedList& other, const Allocator& allocator) :
+		LinkedList(other.begin(), other.end(), allocator) {}
 
-	template<typename T>
-	LinkedList<T>::LinkedList(std::initializer_list<T> il) :
-		LinkedList(il.begin(), il.end()) {}
+	template<typename T, typename Allocator>
+	LinkedList<T, Allocator>::LinkedList(LinkedList&& other) :
+		LinkedList(Allocator(other.m_allocator)) {
+		swap_storage(other);
+	}
+
+	template<typename T, typename Allocator>
+	LinkedList<T, Allocator>::LinkedList(LinkedList&& other, const Allocator& allocator) :
+		LinkedList(allocator) {
+		if (m_allocator == other.m_allocator)
+			swap_storage(other);
+		else {
+			for (T& value : other)
+				push_back(std::move(value));
+		}
+	}
+
+	template<typename T, typename Allocator>
+	LinkedList<T, Allocator>::LinkedList(std::initializer_list<T> il, const Allocator& allocator) :
+		LinkedList(il.begin(), il.end(), allocator) {}
 
-	template<typename T>
-	LinkedList<T>::~LinkedList() {
+	template<typename T, typename Allocator>
+	LinkedList<T, Allocator>::~LinkedList() {
 		clear();
-		delete m_tail;
+		destroy_node(m_tail);
 	}
 
-	template<typename T>
-	LinkedList<T>& LinkedList<T>::operator=(const LinkedList& other) {
-		LinkedList<T> temp(other);
-		temp.swap(*this);
+	template<typename T, typename Allocator>
+	LinkedList<T, Allocator>& LinkedList<T, Allocator>::operator=(const LinkedList& other) {
+		if (this == &other) return *this;
+		constexpr bool propagate = NodeTraits::propagate_on_container_copy_assignment::value;
+		LinkedList temp(other, Allocator(propagate ? other.m_allocator : m_allocator));
+		swap_storage(temp);
+		if constexpr (propagate) std::swap(m_allocator, temp.m_allocator);
 		return *this;
 	}
 
-	template<typename T>
-	LinkedList<T>& LinkedList<T>::operator=(LinkedList&& other) noexcept {
-		other.swap(*this);
+	template<typename T, typename Allocator>
+	LinkedList<T, Allocator>& LinkedList<T, Allocator>::operator=(LinkedList&& other) noexcept(
+		NodeTraits::propagate_on_container_move_assignment::value ||
+		NodeTraits::is_always_equal::value) {
+		if constexpr (NodeTraits::propagate_on_container_move_assignment::value) {
+			swap_storage(other);
+			std::swap(m_allocator, other.m_allocator);
+		}
+		else if constexpr (NodeTraits::is_always_equal::value) {
+			swap_storage(other);
+		}
+		else {
+			LinkedList temp(std::move(other), Allocator(m_allocator));
+			swap_storage(temp);
+		}
 		return *this;
 	}
 
-	template<typename T>
-	LinkedList<T>& LinkedList<T>::operator=(std::initializer_list<T> il) {
-		LinkedList<T> temp(il);
-		temp.swap(*this);
+	template<typename T, typename Allocator>
+	LinkedList<T, Allocator>& LinkedList<T, Allocator>::operator=(std::initializer_list<T> il) {
+		LinkedList temp(il, Allocator(m_allocator));
+		swap_storage(temp);
 		return *this;
 	}
 
+	template<typename T, typename Allocator>
+	Allocator LinkedList<T, Allocator>::get_allocator() const noexcept {
+		return Allocator(m_allocator);
+	}
+
 	// Element Access
-	template<typename T>
-	T& LinkedList<T>::front() {
+	template<typename T, typename Allocator>
+	T& LinkedList<T, Allocator>::front() {
 		if (!m_head) throw OutOfRangeException("LinkedList");
 		return m_head->value;
 	}
 
-	template<typename T>
-	const T& LinkedList<T>::front() const {
+	template<typename T, typename Allocator>
+	const T& LinkedList<T, Allocator>::front() const {
 		if (!m_head) throw OutOfRangeException("LinkedList");
 		return m_head->value;
 	}
 
-	template<typename T>
-	T& LinkedList<T>::back() {
+	template<typename T, typename Allocator>
+	T& LinkedList<T, Allocator>::back() {
 		if (!m_tail->prev) throw OutOfRangeException("LinkedList");
 		return m_tail->prev->value;
 	}
 
-	template<typename T>
-	const T& LinkedList<T>::back() const {
+	template<typename T, typename Allocator>
+	const T& LinkedList<T, Allocator>::back() const {
 		if (!m_tail->prev) throw OutOfRangeException("LinkedList");
 		return m_tail->prev->value;
 	}
 
 	// Iterators
-	template<typename T>
-	bool LinkedList<T>::Iterator::operator==(const Iterator& other) const {
+	template<typename T, typename Allocator>
+	bool LinkedList<T, Allocator>::Iterator::operator==(const Iterator& other) const {
 		return m_pointer == other.m_pointer;
 	}
 
-	template<typename T>
-	bool LinkedList<T>::Iterator::operator!=(const Iterator& other) const {
+	template<typename T, typename Allocator>
+	bool LinkedList<T, Allocator>::Iterator::operator!=(const Iterator& other) const {
 		return m_pointer != other.m_pointer;
 	}
 
-	template<typename T>
-	typename LinkedList<T>::Iterator& LinkedList<T>::Iterator::operator++() {
+	template<typename T, typename Allocator>
+	typename LinkedList<T, Allocator>::Iterator& LinkedList<T, Allocator>::Iterator::operator++() {
 		if (!m_pointer->next) throw OutOfRangeException("LinkedList");
 		m_pointer = m_pointer->next;
 		return *this;
 	}
 
-	template<typename T>
-	typename LinkedList<T>::Iterator LinkedList<T>::Iterator::operator++(int) {
+	template<typename T, typename Allocator>
+	typename LinkedList<T, Allocator>::Iterator LinkedList<T, Allocator>::Iterator::operator++(int) {
 		Iterator it = *this;
 		++(*this);
 		return it;
 	}
 
-	template<typename T>
-	typename LinkedList<T>::Iterator LinkedList<T>::Iterator::operator+(int steps) const {
+	template<typename T, typename Allocator>
+	typename LinkedList<T, Allocator>::Iterator LinkedList<T, Allocator>::Iterator::operator+(int steps) const {
 		Iterator it = *this;
 		for (int i = 0; i < steps; ++i, ++it);
 		return it;
 	}
 
-	template<typename T>
-	typename LinkedList<T>::Iterator& LinkedList<T>::Iterator::operator+=(int steps) {
+	template<typename T, typename Allocator>
+	typename LinkedList<T, Allocator>::Iterator& LinkedList<T, Allocator>::Iterator::operator+=(int steps) {
 		*this = *this + steps;
 		return *this;
 	}
 
-	template<typename T>
-	typename LinkedList<T>::Iterator& LinkedList<T>::Iterator::operator--() {
+	template<typename T, typename Allocator>
+	typename LinkedList<T, Allocator>::Iterator& LinkedList<T, Allocator>::Iterator::operator--() {
 		if (!m_pointer->prev) throw OutOfRangeException("LinkedList");
 		m_pointer = m_pointer->prev;
 		return *this;
 	}
 
-	template<typename T>
-	typename LinkedList<T>::Iterator LinkedList<T>::Iterator::operator--(int) {
+	template<typename T, typename Allocator>
+	typename LinkedList<T, Allocator>::Iterator LinkedList<T, Allocator>::Iterator::operator--(int) {
 		Iterator it = *this;
 		--(*this);
 		return it;
 	}
 
-	template<typename T>
-	typename LinkedList<T>::Iterator LinkedList<T>::Iterator::operator-(int steps) const {
+	template<typename T, typename Allocator>
+	typename LinkedList<T, Allocator>::Iterator LinkedList<T, Allocator>::Iterator::operator-(int steps) const {
 		Iterator it = *this;
 		for (int i = 0; i < steps; ++i, --it);
 		return it;
 	}
 
-	template<typename T>
-	typename LinkedList<T>::Iterator& LinkedList<T>::Iterator::operator-=(int steps) {
+	template<typename T, typename Allocator>
+	typename LinkedList<T, Allocator>::Iterator& LinkedList<T, Allocator>::Iterator::operator-=(int steps) {
 		*this = *this - steps;
 		return *this;
 	}
 
-	template<typename T>
-	size_t LinkedList<T>::Iterator::operator-(const Iterator& other) const {
+	template<typename T, typename Allocator>
+	size_t LinkedList<T, Allocator>::Iterator::operator-(const Iterator& other) const {
 		size_t dis = 0;
 		for (Iterator it = other; it.m_pointer; ++it, ++dis) {
 			if (m_pointer == it.m_pointer) return dis;
@@ -335,48 +396,48 @@ namespace Containers {
 		throw InvalidIteratorException("LinkedList");
 	}
 
-	template<typename T>
-	T& LinkedList<T>::Iterator::operator*() {
+	template<typename T, typename Allocator>
+	T& LinkedList<T, Allocator>::Iterator::operator*() {
 		return m_pointer->value;
 	}
 
-	template<typename T>
-	const T& LinkedList<T>::Iterator::operator*() const {
+	template<typename T, typename Allocator>
+	const T& LinkedList<T, Allocator>::Iterator::operator*() const {
 		return m_pointer->value;
 	}
 
-	template<typename T>
-	T* LinkedList<T>::Iterator::operator->() {
+	template<typename T, typename Allocator>
+	T* LinkedList<T, Allocator>::Iterator::operator->() {
 		return &(m_pointer->value);
 	}
 
-	template<typename T>
-	const T* LinkedList<T>::Iterator::operator->() const {
+	template<typename T, typename Allocator>
+	const T* LinkedList<T, Allocator>::Iterator::operator->() const {
 		return &(m_pointer->value);
 	}
 
-	template<typename T>
-	typename LinkedList<T>::Iterator LinkedList<T>::begin() noexcept {
+	template<typename T, typename Allocator>
+	typename LinkedList<T, Allocator>::Iterator LinkedList<T, Allocator>::begin() noexcept {
 		return Iterator(m_head);
 	}
 
-	template<typename T>
-	const typename LinkedList<T>::Iterator LinkedList<T>::begin() const noexcept {
+	template<typename T, typename Allocator>
+	const typename LinkedList<T, Allocator>::Iterator LinkedList<T, Allocator>::begin() const noexcept {
 		return Iterator(m_head);
 	}
 
-	template<typename T>
-	typename LinkedList<T>::Iterator LinkedList<T>::end() noexcept {
+	template<typename T, typename Allocator>
+	typename LinkedList<T, Allocator>::Iterator LinkedList<T, Allocator>::end() noexcept {
 		return Iterator(m_tail);
 	}
 
-	template<typename T>
-	const typename LinkedList<T>::Iterator LinkedList<T>::end() const noexcept {
+	template<typename T, typename Allocator>
+	const typename LinkedList<T, Allocator>::Iterator LinkedList<T, Allocator>::end() const noexcept {
 		return Iterator(m_tail);
 	}
 
-	template<typename T>
-	typename LinkedList<T>::Iterator LinkedList<T>::find(const T& value) const {
+	template<typename T, typename Allocator>
+	typename LinkedList<T, Allocator>::Iterator LinkedList<T, Allocator>::find(const T& value) const {
 		for (Iterator it = begin(); it != end(); ++it) {
 			if (*it == value) return it;
 		}
@@ -384,120 +445,120 @@ namespace Containers {
 	}
 
 	// Capacity
-	template<typename T>
-	size_t LinkedList<T>::size() const noexcept { return m_size; }
+	template<typename T, typename Allocator>
+	size_t LinkedList<T, Allocator>::size() const noexcept { return m_size; }
 
-	template<typename T>
-	bool LinkedList<T>::empty() const noexcept { return m_size == 0; }
+	template<typename T, typename Allocator>
+	bool LinkedList<T, Allocator>::empty() const noexcept { return m_size == 0; }
 
 	// Modifiers
-	template<typename T>
-	void LinkedList<T>::clear() noexcept {
+	template<typename T, typename Allocator>
+	void LinkedList<T, Allocator>::clear() noexcept {
 		erase(begin(), end());
 	}
 
-	template<typename T>
+	template<typename T, typename Allocator>
 	template<typename...Args>
-	typename LinkedList<T>::Iterator LinkedList<T>::emplace(const Iterator pos, Args&&...args) {
-		ListNode* new_node = new ListNode(std::forward<Args>(args)...);
+	typename LinkedList<T, Allocator>::Iterator LinkedList<T, Allocator>::emplace(const Iterator pos, Args&&...args) {
+		ListNode* new_node = create_node(std::forward<Args>(args)...);
 		insert_between(new_node, pos.m_pointer->prev, pos.m_pointer);
 		return Iterator(new_node);
 	}
 
-	template<typename T>
-	typename LinkedList<T>::Iterator LinkedList<T>::insert(const Iterator pos, const T& value) {
+	template<typename T, typename Allocator>
+	typename LinkedList<T, Allocator>::Iterator LinkedList<T, Allocator>::insert(const Iterator pos, const T& value) {
 		insert(pos, (size_t)1, value);
 		return pos - 1;
 	}
 
-	template<typename T>
-	typename LinkedList<T>::Iterator LinkedList<T>::insert(const Iterator pos, T&& value) {
+	template<typename T, typename Allocator>
+	typename LinkedList<T, Allocator>::Iterator LinkedList<T, Allocator>::insert(const Iterator pos, T&& value) {
 		return emplace(pos, std::move(value));
 	}
 
-	template<typename T>
-	void LinkedList<T>::insert(const Iterator pos, size_t n, const T& value) {
+	template<typename T, typename Allocator>
+	void LinkedList<T, Allocator>::insert(const Iterator pos, size_t n, const T& value) {
 		ListNode* ptr = pos.m_pointer;
 		for (size_t i = 0; i < n; ++i) {
-			ListNode* new_node = new ListNode(value);
+			ListNode* new_node = create_node(value);
 			insert_between(new_node, pos.m_pointer->prev, pos.m_pointer);
 		}
 	}
 
-	template<typename T>
+	template<typename T, typename Allocator>
 	template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
-	void LinkedList<T>::insert(const Iterator pos, IT first, IT last) {
+	void LinkedList<T, Allocator>::insert(const Iterator pos, IT first, IT last) {
 		Iterator cur = pos;
 		for (IT it = first; it != last; ++it) {
 			cur = ++insert(cur, *it);
 		}
 	}
 
-	template<typename T>
-	void LinkedList<T>::insert(const Iterator pos, std::initializer_list<T> il) {
+	template<typename T, typename Allocator>
+	void LinkedList<T, Allocator>::insert(const Iterator pos, std::initializer_list<T> il) {
 		insert(pos, il.begin(), il.end());
 	}
 
-	template<typename T>
-	typename LinkedList<T>::Iterator LinkedList<T>::erase(const Iterator pos) {
+	template<typename T, typename Allocator>
+	typename LinkedList<T, Allocator>::Iterator LinkedList<T, Allocator>::erase(const Iterator pos) {
 		ListNode* next = pos.m_pointer->next;
 		erase(pos.m_pointer);
 		return Iterator(next);
 	}
 
-	template<typename T>
-	typename LinkedList<T>::Iterator LinkedList<T>::erase(const Iterator first, const Iterator last) {
+	template<typename T, typename Allocator>
+	typename LinkedList<T, Allocator>::Iterator LinkedList<T, Allocator>::erase(const Iterator first, const Iterator last) {
 		size_t dis = last - first;
 		Iterator it = first;
 		for (; it != last; it = erase(it));
 		return it;
 	}
 
-	template<typename T>
-	void LinkedList<T>::push_back(const T& value) {
-		ListNode* new_node = new ListNode(value);
+	template<typename T, typename Allocator>
+	void LinkedList<T, Allocator>::push_back(const T& value) {
+		ListNode* new_node = create_node(value);
 		insert_between(new_node, m_tail->prev, m_tail);
 	}
 
-	template<typename T>
-	void LinkedList<T>::push_back(T&& value) {
-		ListNode* new_node = new ListNode(std::move(value));
+	template<typename T, typename Allocator>
+	void LinkedList<T, Allocator>::push_back(T&& value) {
+		ListNode* new_node = create_node(std::move(value));
 		insert_between(new_node, m_tail->prev, m_tail);
 	}
 
-	template<typename T>
-	void LinkedList<T>::push_front(const T& value) {
-		ListNode* new_node = new ListNode(value);
+	template<typename T, typename Allocator>
+	void LinkedList<T, Allocator>::push_front(const T& value) {
+		ListNode* new_node = create_node(value);
 		insert_between(new_node, nullptr, m_head);
 	}
 
-	template<typename T>
-	void LinkedList<T>::push_front(T&& value) {
-		ListNode* new_node = new ListNode(std::move(value));
+	template<typename T, typename Allocator>
+	void LinkedList<T, Allocator>::push_front(T&& value) {
+		ListNode* new_node = create_node(std::move(value));
 		insert_between(new_node, nullptr, m_head);
 	}
 
-	template<typename T>
+	template<typename T, typename Allocator>
 	template<typename...Args>
-	void LinkedList<T>::emplace_back(Args&&...args) {
-		ListNode* new_node = new ListNode(T(std::forward<Args>(args)...));
+	void LinkedList<T, Allocator>::emplace_back(Args&&...args) {
+		ListNode* new_node = create_node(T(std::forward<Args>(args)...));
 		insert_between(new_node, m_tail->prev, m_tail);
 	}
 
-	template<typename T>
+	template<typename T, typename Allocator>
 	template<typename...Args>
-	void LinkedList<T>::emplace_front(Args&&...args) {
-		ListNode* new_node = new ListNode(T(std::forward<Args>(args)...));
+	void LinkedList<T, Allocator>::emplace_front(Args&&...args) {
+		ListNode* new_node = create_node(T(std::forward<Args>(args)...));
 		insert_between(new_node, nullptr, m_head);
 	}
 
-	template<typename T>
-	void LinkedList<T>::resize(size_t size) {
+	template<typename T, typename Allocator>
+	void LinkedList<T, Allocator>::resize(size_t size) {
 		resize(size, T());
 	}
 
-	template<typename T>
-	void LinkedList<T>::resize(size_t size, const T& value) {
+	template<typename T, typename Allocator>
+	void LinkedList<T, Allocator>::resize(size_t size, const T& value) {
 		if (size < m_size) {
 			erase(begin() + size, end());
 		}
@@ -506,39 +567,66 @@ namespace Containers {
 		}
 	}
 
-	template<typename T>
-	void LinkedList<T>::swap(LinkedList& other) noexcept {
-		std::swap(m_head, other.m_head);
-		std::swap(m_tail, other.m_tail);
-		std::swap(m_size, other.m_size);
+	template<typename T, typename Allocator>
+	void LinkedList<T, Allocator>::swap(LinkedList& other) noexcept {
+		swap_storage(other);
+		if constexpr (NodeTraits::propagate_on_container_swap::value)
+			std::swap(m_allocator, other.m_allocator);
 	}
 
-	template<typename T>
-	void LinkedList<T>::pop_back() {
+	template<typename T, typename Allocator>
+	void LinkedList<T, Allocator>::pop_back() {
 		erase(m_tail->prev);
 	}
 
-	template<typename T>
-	void LinkedList<T>::pop_front() {
+	template<typename T, typename Allocator>
+	void LinkedList<T, Allocator>::pop_front() {
 		erase(m_head);
 	}
 
 	// Private Members
-	template<typename T>
-	void LinkedList<T>::insert_n(ListNode* start, size_t n, const T& value) {
+	template<typename T, typename Allocator>
+	template<typename...Args>
+	typename LinkedList<T, Allocator>::ListNode* LinkedList<T, Allocator>::create_node(Args&&...args) {
+		ListNode* node = NodeTraits::allocate(m_allocator, 1);
+		try {
+			NodeTraits::construct(m_allocator, node, std::forward<Args>(args)...);
+		}
+		catch (...) {
+			NodeTraits::deallocate(m_allocator, node, 1);
+			throw;
+		}
+		return node;
+	}
+
+	template<typename T, typename Allocator>
+	void LinkedList<T, Allocator>::destroy_node(ListNode* node) noexcept {
+		NodeTraits::destroy(m_allocator, node);
+		NodeTraits::deallocate(m_allocator, node, 1);
+	}
+
+	template<typename T, typename Allocator>
+	void LinkedList<T, Allocator>::swap_storage(LinkedList& other) noexcept {
+		std::swap(m_head, other.m_head);
+		std::swap(m_tail, other.m_tail);
+		std::swap(m_size, other.m_size);
+	}
+
+	template<typename T, typename Allocator>
+	void LinkedList<T, Allocator>::insert_n(ListNode* start, size_t n, const T& value) {
 		for (size_t i = 0; i < n; ++i)
 			push_back(value);
 	}
 
-	template<typename T>
+	template<typename T, typename Allocator>
 	template<class IT>
-	void LinkedList<T>::insert_range(ListNode* start, IT first, IT last) {
+	void LinkedList<T, Allocator>::insert_range(ListNode* start, IT first, IT last) {
 		for (IT it = first; it != last; ++it)
 			push_back(*it);
 	}
 
-	template<typename T>
-	void LinkedList<T>::insert_between(ListNode* new_node, ListNode* prev, ListNode* next) {
+	template<typename T, typename Allocator>
+	void LinkedList<T, Allocator>::insert_between(ListNode* new_node, ListNode* prev, ListNode* next) {
 		new_node->prev = prev;
 		new_node->next = next;
 		if (prev) prev->next = new_node;
@@ -547,15 +635,20 @@ namespace Containers {
 		++m_size;
 	}
 
-	template<typename T>
-	void LinkedList<T>::erase(ListNode* node) {
+	template<typename T, typename Allocator>
+	void LinkedList<T, Allocator>::erase(ListNode* node) {
 		if (!node) throw OutOfRangeException("LinkedList");
 		if (node->prev)
 			node->prev->next = node->next;
 		else
 			m_head = node->next;
 		node->next->prev = node->prev;
-		delete node;
+		destroy_node(node);
 		--m_size;
 	}
+
+	namespace pmr {
+		template<typename T>
+		using LinkedList = Containers::LinkedList<T, std::pmr::polymorphic_allocator<T>>;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,562 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <type_traits>
+#include <utility>
+#include "exception.h"
+#include "policy.h"
+#include "simd.h"
+#include "vector.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Containers {
+
+	enum class MapMode {
+		// The file is never written. Element writes are copy-on-write and stay private to
+		// this process; members that change the size throw.
+		ReadOnly,
+		// Element writes go to the file, which is created if missing and grows to hold
+		// appended elements
+		ReadWrite
+	};
+
+	// A Vector whose elements are the bytes of a file mapped into memory, so opening it
+	// costs no reads or copies: pages are faulted in as they are touched. The file holds
+	// the elements back to back with no header. While open in ReadWrite mode the file is
+	// grown ahead of the size like a Vector's capacity, and cut back to the elements on
+	// close(); a process that dies first leaves zeroed elements past the end.
+	template<typename T, typename Growth = DefaultGrowth>
+	class MappedVector {
+		static_assert(std::is_trivially_copyable_v<T>, "MappedVector elements must be trivially copyable");
+
+	public:
+		using Iterator = typename Vector<T>::Iterator;
+
+		MappedVector() noexcept;
+
+		explicit MappedVector(const std::filesystem::path&, MapMode = MapMode::ReadOnly);
+
+		MappedVector(const MappedVector&) = delete;
+
+		MappedVector(MappedVector&&) noexcept;
+
+		~MappedVector();
+
+		MappedVector& operator=(const MappedVector&) = delete;
+
+		MappedVector& operator=(MappedVector&&) noexcept;
+
+		// Element Access
+		T& at(size_t);
+
+		const T& at(size_t) const;
+
+		T& operator[](size_t);
+
+		const T& operator[](size_t) const;
+
+		T& front();
+
+		const T& front() const;
+
+		T& back();
+
+		const T& back() const;
+
+		T* data() noexcept;
+
+		const T* data() const noexcept;
+
+		// Capacity
+		bool empty() const noexcept;
+
+		size_t size() const noexcept;
+
+		void reserve(size_t);
+
+		size_t capacity() const noexcept;
+
+		void shrink_to_fit();
+
+		// Iterators
+		Iterator begin() noexcept;
+
+		const Iterator begin() const noexcept;
+
+		Iterator end() noexcept;
+
+		const Iterator end() const noexcept;
+
+		Iterator find(const T&) const;
+
+		size_t count(const T&) const;
+
+		bool contains(const T&) const;
+
+		// Modifiers
+		void clear();
+
+		void push_back(const T&);
+
+		void pop_back();
+
+		void resize(size_t);
+
+		void resize(size_t, const T&);
+
+		void swap(MappedVector&) noexcept;
+
+		// Mapping
+		bool is_open() const noexcept;
+
+		MapMode mode() const noexcept;
+
+		// Writes modified pages back to the file (ReadWrite only)
+		void flush();
+
+		void close() noexcept;
+
+	private:
+		T* m_data;
+		size_t m_size;
+		size_t m_capacity;
+		MapMode m_mode;
+#if defined(_WIN32)
+		HANDLE m_file;
+		HANDLE m_mapping;
+#else
+		int m_file;
+#endif
+
+		void open(const std::filesystem::path&);
+
+		void map(size_t);
+
+		void unmap() noexcept;
+
+		void remap(size_t);
+
+		void writable() const;
+	};
+
+	// Constructors
+	template<typename T, typename Growth>
+	MappedVector<T, Growth>::MappedVector() noexcept :
+		m_data(nullptr), m_size(0), m_capacity(0), m_mode(MapMode::ReadOnly),
+#if defined(_WIN32)
+		m_file(INVALID_HANDLE_VALUE), m_mapping(nullptr) {}
+#else
+		m_file(-1) {}
+#endif
+
+	template<typename T, typename Growth>
+	MappedVector<T, Growth>::MappedVector(const std::filesystem::path& path, MapMode mode) : MappedVector() {
+		m_mode = mode;
+		open(path);
+	}
+
+	template<typename T, typename Growth>
+	MappedVector<T, Growth>::MappedVector(MappedVector&& other) noexcept : MappedVector() {
+		swap(other);
+	}
+
+	template<typename T, typename Growth>
+	MappedVector<T, Growth>::~MappedVector() {
+		close();
+	}
+
+	template<typename T, typename Growth>
+	MappedVector<T, Growth>& MappedVector<T, Growth>::operator=(MappedVector&& other) noexcept {
+		if (this == &other) return *this;
+		close();
+		swap(other);
+		return *this;
+	}
+
+	// Element Access
+	template<typename T, typename Growth>
+	T& MappedVector<T, Growth>::at(size_t pos) {
+		if (pos >= m_size) throw OutOfRangeException("MappedVector");
+		return m_data[pos];
+	}
+
+	template<typename T, typename Growth>
+	const T& MappedVector<T, Growth>::at(size_t pos) const {
+		if (pos >= m_size) throw OutOfRangeException("MappedVector");
+		return m_data[pos];
+	}
+
+	template<typename T, typename Growth>
+	T& MappedVector<T, Growth>::operator[](size_t pos) {
+		return m_data[pos];
+	}
+
+	template<typename T, typename Growth>
+	const T& MappedVector<T, Growth>::operator[](size_t pos) const {
+		return m_data[pos];
+	}
+
+	template<typename T, typename Growth>
+	T& MappedVector<T, Growth>::front() {
+		if (!m_size) throw OutOfRangeException("MappedVector");
+		return m_data[0];
+	}
+
+	template<typename T, typename Growth>
+	const T& MappedVector<T, Growth>::front() const {
+		if (!m_size) throw OutOfRangeException("MappedVector");
+		return m_data[0];
+	}
+
+	template<typename T, typename Growth>
+	T& MappedVector<T, Growth>::back() {
+		if (!m_size) throw OutOfRangeException("MappedVector");
+		return m_data[m_size - 1];
+	}
+
+	template<typename T, typename Growth>
+	const T& MappedVector<T, Growth>::back() const {
+		if (!m_size) throw OutOfRangeException("MappedVector");
+		return m_data[m_size - 1];
+	}
+
+	template<typename T, typename Growth>
+	T* MappedVector<T, Growth>::data() noexcept { return m_data; }
+
+	template<typename T, typename Growth>
+	const T* MappedVector<T, Growth>::data() const noexcept { return m_data; }
+
+	// Capacity
+	template<typename T, typename Growth>
+	bool MappedVector<T, Growth>::empty() const noexcept { return m_size == 0; }
+
+	template<typename T, typename Growth>
+	size_t MappedVector<T, Growth>::size() const noexcept { return m_size; }
+
+	template<typename T, typename Growth>
+	void MappedVector<T, Growth>::reserve(size_t capacity) {
+		writable();
+		if (capacity > m_capacity) remap(capacity);
+	}
+
+	template<typename T, typename Growth>
+	size_t MappedVector<T, Growth>::capacity() const noexcept { return m_capacity; }
+
+	template<typename T, typename Growth>
+	void MappedVector<T, Growth>::shrink_to_fit() {
+		if (m_mode == MapMode::ReadWrite && m_size != m_capacity) remap(m_size);
+	}
+
+	// Iterators
+	template<typename T, typename Growth>
+	typename MappedVector<T, Growth>::Iterator MappedVector<T, Growth>::begin() noexcept {
+		return Iterator(m_data);
+	}
+
+	template<typename T, typename Growth>
+	const typename MappedVector<T, Growth>::Iterator MappedVector<T, Growth>::begin() const noexcept {
+		return Iterator(m_data);
+	}
+
+	template<typename T, typename Growth>
+	typename MappedVector<T, Growth>::Iterator MappedVector<T, Growth>::end() noexcept {
+		return Iterator(m_data + m_size);
+	}
+
+	template<typename T, typename Growth>
+	const typename MappedVector<T, Growth>::Iterator MappedVector<T, Growth>::end() const noexcept {
+		return Iterator(m_data + m_size);
+	}
+
+	template<typename T, typename Growth>
+	typename MappedVector<T, Growth>::Iterator MappedVector<T, Growth>::find(const T& value) const {
+		if constexpr (simd::is_searchable_v<T>) {
+			return Iterator(m_data + simd::find(m_data, m_size, value));
+		}
+		else {
+			for (Iterator it = begin(); it != end(); ++it) {
+				if (*it == value) return it;
+			}
+			return end();
+		}
+	}
+
+	template<typename T, typename Growth>
+	size_t MappedVector<T, Growth>::count(const T& value) const {
+		if constexpr (simd::is_searchable_v<T>) {
+			return simd::count(m_data, m_size, value);
+		}
+		else {
+			size_t matches = 0;
+			for (size_t i = 0; i < m_size; ++i)
+				matches += m_data[i] == value;
+			return matches;
+		}
+	}
+
+	template<typename T, typename Growth>
+	bool MappedVector<T, Growth>::contains(const T& value) const {
+		return find(value) != end();
+	}
+
+	// Modifiers
+	template<typename T, typename Growth>
+	void MappedVector<T, Growth>::clear() {
+		writable();
+		m_size = 0;
+	}
+
+	template<typename T, typename Growth>
+	void MappedVector<T, Growth>::push_back(const T& value) {
+		writable();
+		if (m_size == m_capacity) {
+			T copy = value;
+			remap(Growth::grow(m_capacity, m_size + 1));
+			m_data[m_size++] = copy;
+			return;
+		}
+		m_data[m_size++] = value;
+	}
+
+	template<typename T, typename Growth>
+	void MappedVector<T, Growth>::pop_back() {
+		writable();
+		if (!m_size) throw OutOfRangeException("MappedVector");
+		--m_size;
+	}
+
+	template<typename T, typename Growth>
+	void MappedVector<T, Growth>::resize(size_t size) {
+		resize(size, T());
+	}
+
+	template<typename T, typename Growth>
+	void MappedVector<T, Growth>::resize(size_t size, const T& value) {
+		writable();
+		T copy = value;
+		if (size > m_capacity) remap(Growth::grow(m_capacity, size));
+		if (size > m_size) std::fill(m_data + m_size, m_data + size, copy);
+		m_size = size;
+	}
+
+	template<typename T, typename Growth>
+	void MappedVector<T, Growth>::swap(MappedVector& other) noexcept {
+		std::swap(m_data, other.m_data);
+		std::swap(m_size, other.m_size);
+		std::swap(m_capacity, other.m_capacity);
+		std::swap(m_mode, other.m_mode);
+		std::swap(m_file, other.m_file);
+#if defined(_WIN32)
+		std::swap(m_mapping, other.m_mapping);
+#endif
+	}
+
+	// Mapping
+	template<typename T, typename Growth>
+	bool MappedVector<T, Growth>::is_open() const noexcept {
+#if defined(_WIN32)
+		return m_file != INVALID_HANDLE_VALUE;
+#else
+		return m_file != -1;
+#endif
+	}
+
+	template<typename T, typename Growth>
+	MapMode MappedVector<T, Growth>::mode() const noexcept { return m_mode; }
+
+	template<typename T, typename Growth>
+	void MappedVector<T, Growth>::flush() {
+		if (m_mode != MapMode::ReadWrite || !m_data) return;
+#if defined(_WIN32)
+		if (!FlushViewOfFile(m_data, 0) || !FlushFileBuffers(m_file))
+			throw ContainerException("MappedVector", "Cannot Flush File");
+#else
+		if (msync(m_data, m_capacity * sizeof(T), MS_SYNC))
+			throw ContainerException("MappedVector", "Cannot Flush File");
+#endif
+	}
+
+	// Unmaps the file and, in ReadWrite mode, trims it to the elements in use. The trim runs
+	// even when size() equals capacity(), since a failed resize may have left the file
+	// longer than the mapping.
+	template<typename T, typename Growth>
+	void MappedVector<T, Growth>::close() noexcept {
+		if (!is_open()) return;
+		unmap();
+#if defined(_WIN32)
+		if (m_mode == MapMode::ReadWrite) {
+			LARGE_INTEGER bytes;
+			bytes.QuadPart = static_cast<LONGLONG>(m_size * sizeof(T));
+			if (SetFilePointerEx(m_file, bytes, nullptr, FILE_BEGIN)) SetEndOfFile(m_file);
+		}
+		CloseHandle(m_file);
+		m_file = INVALID_HANDLE_VALUE;
+#else
+		if (m_mode == MapMode::ReadWrite)
+			static_cast<void>(ftruncate(m_file, static_cast<off_t>(m_size * sizeof(T))));
+		::close(m_file);
+		m_file = -1;
+#endif
+		m_size = m_capacity = 0;
+	}
+
+	// Helpers
+	template<typename T, typename Growth>
+	void MappedVector<T, Growth>::open(const std::filesystem::path& path) {
+		bool write = m_mode == MapMode::ReadWrite;
+		size_t bytes;
+#if defined(_WIN32)
+		m_file = CreateFileW(path.c_str(), write ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+			FILE_SHARE_READ, nullptr, write ? OPEN_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (m_file == INVALID_HANDLE_VALUE) throw ContainerException("MappedVector", "Cannot Open File");
+		LARGE_INTEGER length;
+		if (!GetFileSizeEx(m_file, &length)) {
+			close();
+			throw ContainerException("MappedVector", "Cannot Open File");
+		}
+		bytes = static_cast<size_t>(length.QuadPart);
+#else
+		m_file = ::open(path.c_str(), write ? O_RDWR | O_CREAT | O_CLOEXEC : O_RDONLY | O_CLOEXEC, 0644);
+		if (m_file == -1) throw ContainerException("MappedVector", "Cannot Open File");
+		struct stat status;
+		if (fstat(m_file, &status)) {
+			close();
+			throw ContainerException("MappedVector", "Cannot Open File");
+		}
+		bytes = static_cast<size_t>(status.st_size);
+#endif
+		if (bytes % sizeof(T)) {
+			close();
+			throw ContainerException("MappedVector", "Size Mismatch");
+		}
+		try {
+			map(bytes / sizeof(T));
+		}
+		catch (...) {
+			close();
+			throw;
+		}
+		m_size = m_capacity;
+	}
+
+	// Maps the first capacity elements of the file, which must already be that long
+	template<typename T, typename Growth>
+	void MappedVector<T, Growth>::map(size_t capacity) {
+		if (!capacity) {
+			m_data = nullptr;
+			m_capacity = 0;
+			return;
+		}
+		bool write = m_mode == MapMode::ReadWrite;
+#if defined(_WIN32)
+		m_mapping = CreateFileMappingW(m_file, nullptr, write ? PAGE_READWRITE : PAGE_WRITECOPY, 0, 0, nullptr);
+		if (!m_mapping) throw ContainerException("MappedVector", "Cannot Map File");
+		void* view = MapViewOfFile(m_mapping, write ? FILE_MAP_WRITE : FILE_MAP_COPY, 0, 0, capacity * sizeof(T));
+		if (!view) {
+			CloseHandle(m_mapping);
+			m_mapping = nullptr;
+			throw ContainerException("MappedVector", "Cannot Map File");
+		}
+#else
+		void* view = mmap(nullptr, capacity * sizeof(T), PROT_READ | PROT_WRITE, write ? MAP_SHARED : MAP_PRIVATE, m_file, 0);
+		if (view == MAP_FAILED) throw ContainerException("MappedVector", "Cannot Map File");
+#endif
+		m_data = static_cast<T*>(view);
+		m_capacity = capacity;
+	}
+
+	template<typename T, typename Growth>
+	void MappedVector<T, Growth>::unmap() noexcept {
+		if (!m_data) return;
+#if defined(_WIN32)
+		UnmapViewOfFile(m_data);
+		CloseHandle(m_mapping);
+		m_mapping = nullptr;
+#else
+		munmap(m_data, m_capacity * sizeof(T));
+#endif
+		m_data = nullptr;
+	}
+
+	// Resizes the file to capacity elements and maps all of it. Grown files are zero-filled.
+	// The old mapping stays valid until the new one exists, and a failed mapping puts the
+	// file length back, so a failure changes nothing.
+	template<typename T, typename Growth>
+	void MappedVector<T, Growth>::remap(size_t capacity) {
+		size_t bytes = capacity * sizeof(T);
+#if defined(_WIN32)
+		// Shrinking needs every view closed, growing happens through the new mapping
+		if (capacity < m_capacity) unmap();
+		LARGE_INTEGER length;
+		length.QuadPart = static_cast<LONGLONG>(bytes);
+		if (capacity < m_capacity && !(SetFilePointerEx(m_file, length, nullptr, FILE_BEGIN) && SetEndOfFile(m_file))) {
+			map(m_capacity);
+			throw ContainerException("MappedVector", "Cannot Resize File");
+		}
+		if (!capacity) {
+			unmap();
+			m_capacity = 0;
+			return;
+		}
+		T* old_data = m_data;
+		HANDLE old_mapping = m_mapping;
+		m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READWRITE, length.HighPart, length.LowPart, nullptr);
+		if (!m_mapping) {
+			m_mapping = old_mapping;
+			throw ContainerException("MappedVector", "Cannot Resize File");
+		}
+		void* view = MapViewOfFile(m_mapping, FILE_MAP_WRITE, 0, 0, bytes);
+		if (!view) {
+			CloseHandle(m_mapping);
+			m_mapping = old_mapping;
+			throw ContainerException("MappedVector", "Cannot Map File");
+		}
+		if (old_data) {
+			UnmapViewOfFile(old_data);
+			CloseHandle(old_mapping);
+		}
+		m_data = static_cast<T*>(view);
+		m_capacity = capacity;
+#else
+		if (ftruncate(m_file, static_cast<off_t>(bytes))) throw ContainerException("MappedVector", "Cannot Resize File");
+		if (!m_data || !capacity) {
+			unmap();
+			map(capacity);
+			return;
+		}
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+		void* view = mremap(m_data, m_capacity * sizeof(T), bytes, MREMAP_MAYMOVE);
+#else
+		void* view = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, m_file, 0);
+		if (view != MAP_FAILED) munmap(m_data, m_capacity * sizeof(T));
+#endif
+		if (view == MAP_FAILED) {
+			// a shrunk file would fault in the old mapping, a grown one keep a zeroed tail
+			static_cast<void>(ftruncate(m_file, static_cast<off_t>(m_capacity * sizeof(T))));
+			throw ContainerException("MappedVector", "Cannot Map File");
+		}
+		m_data = static_cast<T*>(view);
+		m_capacity = capacity;
+#endif
+	}
+
+	template<typename T, typename Growth>
+	void MappedVector<T, Growth>::writable() const {
+		if (m_mode != MapMode::ReadWrite || !is_open()) throw ContainerException("MappedVector", "Read Only");
+	}
+
+	template<typename T, typename Growth>
+	struct is_numeric_container<MappedVector<T, Growth>> : std::is_arithmetic<T> {};
+}
\ No newline at end of file
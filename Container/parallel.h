@@ -0,0 +1,265 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "globals.h"
+#include "thread_pool.h"
+
+namespace Containers {
+
+	// Parallel algorithms over contiguous ranges
+	// The ranges are given as iterators of Vector, SmallVector or StaticVector, or as plain
+	// pointers. Work is split in halves until a piece spans Global::PARALLEL_CHUNK_BYTES,
+	// so every chunk a worker touches fits in its cache, and the pieces run on a
+	// ThreadPool (the global one unless a pool is passed first). Callables are invoked
+	// concurrently from several threads. Exceptions thrown by them reach the caller; the
+	// range is then left partially processed.
+
+	namespace parallel {
+
+		namespace detail {
+
+			template<typename T>
+			constexpr size_t grain_size() noexcept {
+				return std::max<size_t>(Global::PARALLEL_CHUNK_BYTES / sizeof(T), 1);
+			}
+
+			template<class IT>
+			auto* address(IT it) {
+				return std::addressof(*it);
+			}
+
+			// Calls body(first, last) on pieces of [first, last) no longer than grain
+			template<typename F>
+			void split(ThreadPool& pool, size_t first, size_t last, size_t grain, const F& body) {
+				if (last - first <= grain) {
+					body(first, last);
+					return;
+				}
+				size_t middle = first + (last - first) / 2;
+				TaskGroup group(pool);
+				group.run([&pool, middle, last, grain, &body] { split(pool, middle, last, grain, body); });
+				split(pool, first, middle, grain, body);
+				group.wait();
+			}
+
+			template<typename V, typename T, typename Op>
+			V reduce(ThreadPool& pool, const T* data, size_t n, size_t grain, const Op& op) {
+				if (n <= grain)
+					return std::accumulate(data + 1, data + n, static_cast<V>(data[0]), op);
+				size_t half = n / 2;
+				std::optional<V> right;
+				TaskGroup group(pool);
+				group.run([&] { right.emplace(reduce<V>(pool, data + half, n - half, grain, op)); });
+				V left = reduce<V>(pool, data, half, grain, op);
+				group.wait();
+				return op(std::move(left), std::move(*right));
+			}
+
+			// Moves the merge of the sorted runs [x, x + nx) and [y, y + ny) to out. Large
+			// merges are cut at the middle of the longer run and the matching position in the
+			// shorter one, giving two independent merges.
+			template<typename T, typename Compare>
+			void merge(ThreadPool& pool, T* x, size_t nx, T* y, size_t ny, T* out, size_t grain, const Compare& comp) {
+				if (nx < ny) {
+					std::swap(x, y);
+					std::swap(nx, ny);
+				}
+				if (nx + ny <= grain || nx < 2) {
+					std::merge(std::make_move_iterator(x), std::make_move_iterator(x + nx),
+						std::make_move_iterator(y), std::make_move_iterator(y + ny), out, comp);
+					return;
+				}
+				size_t i = nx / 2;
+				size_t j = std::lower_bound(y, y + ny, x[i], comp) - y;
+				TaskGroup group(pool);
+				group.run([&] { merge(pool, x + i, nx - i, y + j, ny - j, out + i + j, grain, comp); });
+				merge(pool, x, i, y, j, out, grain, comp);
+				group.wait();
+			}
+
+			// Sorts the n elements at a, leaving the result in b when to_b is set and in a
+			// otherwise; the other array is scratch space of live objects
+			template<typename T, typename Compare>
+			void sort(ThreadPool& pool, T* a, T* b, size_t n, bool to_b, size_t grain, const Compare& comp) {
+				if (n <= grain) {
+					std::sort(a, a + n, comp);
+					if (to_b) std::move(a, a + n, b);
+					return;
+				}
+				size_t half = n / 2;
+				TaskGroup group(pool);
+				group.run([&] { sort(pool, a + half, b + half, n - half, !to_b, grain, comp); });
+				sort(pool, a, b, half, !to_b, grain, comp);
+				group.wait();
+				T* from = to_b ? a : b;
+				merge(pool, from, half, from + half, n - half, to_b ? b : a, grain, comp);
+			}
+
+			// Scratch storage for sort. Trivial types are used as raw storage; other types are
+			// moved in from the range so every slot holds a live object.
+			template<typename T>
+			class SortBuffer {
+			public:
+				SortBuffer(ThreadPool& pool, T* source, size_t n) : m_data(std::allocator<T>().allocate(n)), m_size(0) {
+					if constexpr (std::is_trivial_v<T>) {
+						m_size = n;
+					}
+					else {
+						// A throwing move in one chunk would strand the chunks built by the others
+						try {
+							if constexpr (std::is_nothrow_move_constructible_v<T>) {
+								split(pool, 0, n, grain_size<T>(), [this, source](size_t first, size_t last) {
+									std::uninitialized_move(source + first, source + last, m_data + first);
+								});
+							}
+							else {
+								std::uninitialized_move(source, source + n, m_data);
+							}
+						}
+						catch (...) {
+							std::allocator<T>().deallocate(m_data, n);
+							throw;
+						}
+						m_size = n;
+					}
+				}
+
+				SortBuffer(const SortBuffer&) = delete;
+
+				SortBuffer& operator=(const SortBuffer&) = delete;
+
+				~SortBuffer() {
+					if constexpr (!std::is_trivial_v<T>) std::destroy_n(m_data, m_size);
+					std::allocator<T>().deallocate(m_data, m_size);
+				}
+
+				T* data() const noexcept { return m_data; }
+
+			private:
+				T* m_data;
+				size_t m_size;
+			};
+		}
+
+		// for_each
+
+		template<class IT, typename F>
+		void for_each(ThreadPool& pool, IT first, IT last, F function) {
+			size_t n = last - first;
+			if (!n) return;
+			auto* data = detail::address(first);
+			detail::split(pool, 0, n, detail::grain_size<std::remove_pointer_t<decltype(data)>>(), [data, &function](size_t from, size_t to) {
+				for (size_t i = from; i < to; ++i) function(data[i]);
+			});
+		}
+
+		template<class IT, typename F>
+		void for_each(IT first, IT last, F function) {
+			parallel::for_each(ThreadPool::global(), first, last, std::move(function));
+		}
+
+		// transform
+		// out may be first itself; otherwise the output range must not overlap the inputs
+
+		template<class IT, class OUT, typename F>
+		void transform(ThreadPool& pool, IT first, IT last, OUT out, F function) {
+			size_t n = last - first;
+			if (!n) return;
+			auto* data = detail::address(first);
+			auto* result = detail::address(out);
+			detail::split(pool, 0, n, detail::grain_size<std::remove_pointer_t<decltype(data)>>(), [data, result, &function](size_t from, size_t to) {
+				for (size_t i = from; i < to; ++i) result[i] = function(data[i]);
+			});
+		}
+
+		template<class IT, class OUT, typename F>
+		void transform(IT first, IT last, OUT out, F function) {
+			parallel::transform(ThreadPool::global(), first, last, out, std::move(function));
+		}
+
+		template<class IT1, class IT2, class OUT, typename F>
+		void transform(ThreadPool& pool, IT1 first1, IT1 last1, IT2 first2, OUT out, F function) {
+			size_t n = last1 - first1;
+			if (!n) return;
+			auto* lhs = detail::address(first1);
+			auto* rhs = detail::address(first2);
+			auto* result = detail::address(out);
+			detail::split(pool, 0, n, detail::grain_size<std::remove_pointer_t<decltype(lhs)>>(), [lhs, rhs, result, &function](size_t from, size_t to) {
+				for (size_t i = from; i < to; ++i) result[i] = function(lhs[i], rhs[i]);
+			});
+		}
+
+		template<class IT1, class IT2, class OUT, typename F>
+		void transform(IT1 first1, IT1 last1, IT2 first2, OUT out, F function) {
+			parallel::transform(ThreadPool::global(), first1, last1, first2, out, std::move(function));
+		}
+
+		// reduce
+		// op must be associative; elements are combined in order, so it need not commute
+
+		template<class IT, typename V, typename Op = std::plus<>>
+		V reduce(ThreadPool& pool, IT first, IT last, V init, Op op = Op()) {
+			size_t n = last - first;
+			if (!n) return init;
+			auto* data = detail::address(first);
+			V total = detail::reduce<V>(pool, data, n, detail::grain_size<std::remove_pointer_t<decltype(data)>>(), op);
+			return op(std::move(init), std::move(total));
+		}
+
+		template<class IT, typename V, typename Op = std::plus<>>
+		V reduce(IT first, IT last, V init, Op op = Op()) {
+			return parallel::reduce(ThreadPool::global(), first, last, std::move(init), std::move(op));
+		}
+
+		// sort
+		// Chunks are sorted in parallel and merged pairwise, with each merge split across
+		// the pool too. Not stable, and needs scratch space for as many elements as the range.
+
+		template<class IT, typename Compare = std::less<>>
+		void sort(ThreadPool& pool, IT first, IT last, Compare comp = Compare()) {
+			size_t n = last - first;
+			if (!n) return;
+			auto* data = detail::address(first);
+			using T = std::remove_pointer_t<decltype(data)>;
+			size_t grain = detail::grain_size<T>();
+			if (n <= grain) {
+				std::sort(data, data + n, comp);
+				return;
+			}
+			detail::SortBuffer<T> buffer(pool, data, n);
+			if constexpr (std::is_trivial_v<T>)
+				detail::sort(pool, data, buffer.data(), n, false, grain, comp);
+			else
+				detail::sort(pool, buffer.data(), data, n, true, grain, comp);
+		}
+
+		template<class IT, typename Compare = std::less<>>
+		void sort(IT first, IT last, Compare comp = Compare()) {
+			parallel::sort(ThreadPool::global(), first, last, std::move(comp));
+		}
+
+		// fill
+
+		template<class IT, typename T>
+		void fill(ThreadPool& pool, IT first, IT last, const T& value) {
+			size_t n = last - first;
+			if (!n) return;
+			auto* data = detail::address(first);
+			detail::split(pool, 0, n, detail::grain_size<std::remove_pointer_t<decltype(data)>>(), [data, &value](size_t from, size_t to) {
+				std::fill(data + from, data + to, value);
+			});
+		}
+
+		template<class IT, typename T>
+		void fill(IT first, IT last, const T& value) {
+			parallel::fill(ThreadPool::global(), first, last, value);
+		}
+	}
+}
\ No newline at end of file
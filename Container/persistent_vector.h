@@ -0,0 +1,681 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "exception.h"
+#include "globals.h"
+
+namespace Containers {
+
+	// Vector with structurally shared storage and O(1) snapshots
+	// Elements live in leaves of branching elements under a trie of branching-way nodes
+	// (a bit-partitioned vector trie); the last, partially filled leaf is kept aside as
+	// the tail so push_back rarely touches the trie. Nodes are reference counted, so
+	// copying a PersistentVector only bumps two counts and both copies share every node.
+	// An update copies the nodes on the path to the element that are still shared, at
+	// most one per level, and edits in place the ones this object holds alone: a writer
+	// that takes no snapshots between edits never copies, which is what a transient or
+	// batch-edit mode would give, and after a snapshot the first edit to a path pays for
+	// the copy once. Elements are therefore read-only through the public interface and
+	// changed with set.
+	// Different objects sharing nodes may be read, copied, edited and destroyed from
+	// different threads at the same time; a single object is not synchronized. Sharing
+	// needs equal allocators, so assigning between unequal ones copies element-wise.
+	template<typename T, typename Allocator = std::allocator<T>>
+	class PersistentVector {
+	private:
+		using AllocTraits = std::allocator_traits<Allocator>;
+
+	public:
+		class Iterator;
+
+		static constexpr size_t bits = Global::PERSISTENT_VECTOR_BITS;
+
+		static constexpr size_t branching = size_t(1) << bits;
+
+		PersistentVector() : PersistentVector(Allocator()) {}
+
+		explicit PersistentVector(const Allocator&) noexcept;
+
+		PersistentVector(size_t, const T&, const Allocator& = Allocator());
+
+		template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
+		PersistentVector(IT, IT, const Allocator& = Allocator());
+
+		PersistentVector(std::initializer_list<T>, const Allocator& = Allocator());
+
+		// Shares the other vector's nodes, so the allocator is copied as is
+		PersistentVector(const PersistentVector&) noexcept;
+
+		PersistentVector(const PersistentVector&, const Allocator&);
+
+		PersistentVector(PersistentVector&&) noexcept;
+
+		~PersistentVector();
+
+		PersistentVector& operator=(const PersistentVector&);
+
+		PersistentVector& operator=(PersistentVector&&);
+
+		Allocator get_allocator() const noexcept;
+
+		// O(1) copy sharing every node
+		PersistentVector snapshot() const noexcept;
+
+		// Element Access
+		const T& at(size_t) const;
+
+		const T& operator[](size_t) const;
+
+		const T& front() const;
+
+		const T& back() const;
+
+		// Capacity
+		bool empty() const noexcept;
+
+		size_t size() const noexcept;
+
+		// Iterators
+		Iterator begin() const noexcept;
+
+		Iterator end() const noexcept;
+
+		// Modifiers
+		void set(size_t, const T&);
+
+		void set(size_t, T&&);
+
+		void clear() noexcept;
+
+		void push_back(const T&);
+
+		void push_back(T&&);
+
+		template<typename...Args>
+		void emplace_back(Args&&...);
+
+		void pop_back();
+
+		void swap(PersistentVector&) noexcept;
+
+	private:
+		struct Node {
+			std::atomic<size_t> refs{ 1 };
+		};
+
+		struct Branch : Node {
+			Node* children[branching] = {};
+		};
+
+		struct Leaf : Node {
+			size_t count = 0;
+			alignas(T) unsigned char storage[branching * sizeof(T)];
+
+			T* data() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+		};
+
+		using BranchAllocator = typename AllocTraits::template rebind_alloc<Branch>;
+		using LeafAllocator = typename AllocTraits::template rebind_alloc<Leaf>;
+
+		Allocator m_allocator;
+		Node* m_root;
+		Node* m_tail;
+		size_t m_shift;
+		size_t m_size;
+
+		size_t tail_offset() const noexcept;
+
+		const Leaf* leaf_for(size_t) const noexcept;
+
+		Branch* new_branch();
+
+		Leaf* new_leaf();
+
+		void free_branch(Branch*) noexcept;
+
+		void free_leaf(Leaf*) noexcept;
+
+		static void retain(Node*) noexcept;
+
+		// Drops a reference to a node at the given level (0 for leaves), freeing it and its
+		// subtree once unreferenced
+		void release(Node*, size_t) noexcept;
+
+		// Replaces a shared node by a private copy
+		void make_unique(Node*&, size_t);
+
+		Node* new_path(size_t, Node*);
+
+		void push_tail(Node*, size_t, Node*);
+
+		bool pop_tail(Node*, size_t);
+
+		template<typename V>
+		void assign(size_t, V&&);
+
+		void swap_storage(PersistentVector&) noexcept;
+	};
+
+	// Iterator caching the leaf of its position
+	template<typename T, typename Allocator>
+	class PersistentVector<T, Allocator>::Iterator {
+	public:
+		Iterator() : m_vector(nullptr), m_index(0), m_leaf(nullptr) {}
+
+		Iterator(const PersistentVector* vector, size_t index) :
+			m_vector(vector), m_index(index), m_leaf(index < vector->m_size ? vector->leaf_for(index) : nullptr) {}
+
+		bool operator==(const Iterator&) const;
+
+		bool operator!=(const Iterator&) const;
+
+		Iterator& operator++();
+
+		Iterator operator++(int);
+
+		Iterator& operator--();
+
+		Iterator operator--(int);
+
+		size_t operator-(const Iterator&) const;
+
+		const T& operator*() const;
+
+		const T* operator->() const;
+
+	private:
+		const PersistentVector* m_vector;
+		size_t m_index;
+		const Leaf* m_leaf;
+	};
+
+	template<typename T, typename Allocator>
+	bool PersistentVector<T, Allocator>::Iterator::operator==(const Iterator& other) const {
+		return m_index == other.m_index;
+	}
+
+	template<typename T, typename Allocator>
+	bool PersistentVector<T, Allocator>::Iterator::operator!=(const Iterator& other) const {
+		return m_index != other.m_index;
+	}
+
+	template<typename T, typename Allocator>
+	typename PersistentVector<T, Allocator>::Iterator& PersistentVector<T, Allocator>::Iterator::operator++() {
+		if (++m_index % branching == 0 && m_index < m_vector->m_size)
+			m_leaf = m_vector->leaf_for(m_index);
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	typename PersistentVector<T, Allocator>::Iterator PersistentVector<T, Allocator>::Iterator::operator++(int) {
+		Iterator it = *this;
+		++(*this);
+		return it;
+	}
+
+	template<typename T, typename Allocator>
+	typename PersistentVector<T, Allocator>::Iterator& PersistentVector<T, Allocator>::Iterator::operator--() {
+		if (m_index-- % branching == 0 || !m_leaf)
+			m_leaf = m_vector->leaf_for(m_index);
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	typename PersistentVector<T, Allocator>::Iterator PersistentVector<T, Allocator>::Iterator::operator--(int) {
+		Iterator it = *this;
+		--(*this);
+		return it;
+	}
+
+	template<typename T, typename Allocator>
+	size_t PersistentVector<T, Allocator>::Iterator::operator-(const Iterator& other) const {
+		return m_index - other.m_index;
+	}
+
+	template<typename T, typename Allocator>
+	const T& PersistentVector<T, Allocator>::Iterator::operator*() const {
+		return const_cast<Leaf*>(m_leaf)->data()[m_index % branching];
+	}
+
+	template<typename T, typename Allocator>
+	const T* PersistentVector<T, Allocator>::Iterator::operator->() const {
+		return &**this;
+	}
+
+	// Constructors
+	template<typename T, typename Allocator>
+	PersistentVector<T, Allocator>::PersistentVector(const Allocator& allocator) noexcept :
+		m_allocator(allocator), m_root(nullptr), m_tail(nullptr), m_shift(bits), m_size(0) {}
+
+	// The delegating constructors leave cleanup after a throw to the destructor
+	template<typename T, typename Allocator>
+	PersistentVector<T, Allocator>::PersistentVector(size_t size, const T& value, const Allocator& allocator) : PersistentVector(allocator) {
+		for (size_t i = 0; i < size; ++i) emplace_back(value);
+	}
+
+	template<typename T, typename Allocator>
+	template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
+	PersistentVector<T, Allocator>::PersistentVector(IT first, IT last, const Allocator& allocator) : PersistentVector(allocator) {
+		for (; first != last; ++first) emplace_back(*first);
+	}
+
+	template<typename T, typename Allocator>
+	PersistentVector<T, Allocator>::PersistentVector(std::initializer_list<T> il, const Allocator& allocator) :
+		PersistentVector(il.begin(), il.end(), allocator) {}
+
+	template<typename T, typename Allocator>
+	PersistentVector<T, Allocator>::PersistentVector(const PersistentVector& other) noexcept :
+		m_allocator(other.m_allocator), m_root(other.m_root), m_tail(other.m_tail), m_shift(other.m_shift), m_size(other.m_size) {
+		retain(m_root);
+		retain(m_tail);
+	}
+
+	template<typename T, typename Allocator>
+	PersistentVector<T, Allocator>::PersistentVector(const PersistentVector& other, const Allocator& allocator) : PersistentVector(allocator) {
+		if (m_allocator == other.m_allocator) {
+			PersistentVector temp(other);
+			swap_storage(temp);
+			return;
+		}
+		for (const T& value : other) emplace_back(value);
+	}
+
+	template<typename T, typename Allocator>
+	PersistentVector<T, Allocator>::PersistentVector(PersistentVector&& other) noexcept :
+		m_allocator(other.m_allocator), m_root(std::exchange(other.m_root, nullptr)), m_tail(std::exchange(other.m_tail, nullptr)),
+		m_shift(std::exchange(other.m_shift, bits)), m_size(std::exchange(other.m_size, 0)) {}
+
+	template<typename T, typename Allocator>
+	PersistentVector<T, Allocator>::~PersistentVector() {
+		clear();
+	}
+
+	template<typename T, typename Allocator>
+	PersistentVector<T, Allocator>& PersistentVector<T, Allocator>::operator=(const PersistentVector& other) {
+		if (this == &other) return *this;
+		constexpr bool propagate = AllocTraits::propagate_on_container_copy_assignment::value;
+		PersistentVector temp(other, propagate ? other.m_allocator : m_allocator);
+		swap_storage(temp);
+		if constexpr (propagate) std::swap(m_allocator, temp.m_allocator);
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	PersistentVector<T, Allocator>& PersistentVector<T, Allocator>::operator=(PersistentVector&& other) {
+		if (this == &other) return *this;
+		constexpr bool propagate = AllocTraits::propagate_on_container_move_assignment::value;
+		if (propagate || m_allocator == other.m_allocator) {
+			PersistentVector temp(std::move(other));
+			swap_storage(temp);
+			if constexpr (propagate) std::swap(m_allocator, temp.m_allocator);
+		}
+		else {
+			PersistentVector temp(other, m_allocator);
+			swap_storage(temp);
+		}
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	Allocator PersistentVector<T, Allocator>::get_allocator() const noexcept {
+		return m_allocator;
+	}
+
+	template<typename T, typename Allocator>
+	PersistentVector<T, Allocator> PersistentVector<T, Allocator>::snapshot() const noexcept {
+		return *this;
+	}
+
+	// Element Access
+	template<typename T, typename Allocator>
+	const T& PersistentVector<T, Allocator>::at(size_t pos) const {
+		if (pos >= m_size) throw OutOfRangeException("PersistentVector");
+		return (*this)[pos];
+	}
+
+	template<typename T, typename Allocator>
+	const T& PersistentVector<T, Allocator>::operator[](size_t pos) const {
+		return const_cast<Leaf*>(leaf_for(pos))->data()[pos % branching];
+	}
+
+	template<typename T, typename Allocator>
+	const T& PersistentVector<T, Allocator>::front() const {
+		if (!m_size) throw OutOfRangeException("PersistentVector");
+		return (*this)[0];
+	}
+
+	template<typename T, typename Allocator>
+	const T& PersistentVector<T, Allocator>::back() const {
+		if (!m_size) throw OutOfRangeException("PersistentVector");
+		return (*this)[m_size - 1];
+	}
+
+	// Capacity
+	template<typename T, typename Allocator>
+	bool PersistentVector<T, Allocator>::empty() const noexcept { return m_size == 0; }
+
+	template<typename T, typename Allocator>
+	size_t PersistentVector<T, Allocator>::size() const noexcept { return m_size; }
+
+	// Iterators
+	template<typename T, typename Allocator>
+	typename PersistentVector<T, Allocator>::Iterator PersistentVector<T, Allocator>::begin() const noexcept {
+		return Iterator(this, 0);
+	}
+
+	template<typename T, typename Allocator>
+	typename PersistentVector<T, Allocator>::Iterator PersistentVector<T, Allocator>::end() const noexcept {
+		return Iterator(this, m_size);
+	}
+
+	// Modifiers
+	template<typename T, typename Allocator>
+	void PersistentVector<T, Allocator>::set(size_t pos, const T& value) {
+		assign(pos, value);
+	}
+
+	template<typename T, typename Allocator>
+	void PersistentVector<T, Allocator>::set(size_t pos, T&& value) {
+		assign(pos, std::move(value));
+	}
+
+	template<typename T, typename Allocator>
+	void PersistentVector<T, Allocator>::clear() noexcept {
+		release(m_root, m_shift);
+		release(m_tail, 0);
+		m_root = m_tail = nullptr;
+		m_shift = bits;
+		m_size = 0;
+	}
+
+	template<typename T, typename Allocator>
+	void PersistentVector<T, Allocator>::push_back(const T& value) {
+		emplace_back(value);
+	}
+
+	template<typename T, typename Allocator>
+	void PersistentVector<T, Allocator>::push_back(T&& value) {
+		emplace_back(std::move(value));
+	}
+
+	// A full tail moves into the trie whole and a new one is started, so each element is
+	// constructed once and never copied while the vector grows
+	template<typename T, typename Allocator>
+	template<typename...Args>
+	void PersistentVector<T, Allocator>::emplace_back(Args&&...args) {
+		if (m_tail && m_size - tail_offset() < branching) {
+			make_unique(m_tail, 0);
+			Leaf* tail = static_cast<Leaf*>(m_tail);
+			AllocTraits::construct(m_allocator, tail->data() + tail->count, std::forward<Args>(args)...);
+			++tail->count;
+			++m_size;
+			return;
+		}
+
+		Leaf* leaf = new_leaf();
+		try {
+			AllocTraits::construct(m_allocator, leaf->data(), std::forward<Args>(args)...);
+			leaf->count = 1;
+			if (m_tail) {
+				if (!m_root) {
+					m_root = new_branch();
+					m_shift = bits;
+				}
+				if ((m_size >> bits) > (size_t(1) << m_shift)) {
+					// the trie is full: grow a level
+					Node* path = new_path(m_shift, m_tail);
+					Branch* root;
+					try {
+						root = new_branch();
+					}
+					catch (...) {
+						for (size_t level = m_shift; level > 0; level -= bits) {
+							Node* child = static_cast<Branch*>(path)->children[0];
+							free_branch(static_cast<Branch*>(path));
+							path = child;
+						}
+						throw;
+					}
+					root->children[0] = m_root;
+					root->children[1] = path;
+					m_root = root;
+					m_shift += bits;
+				}
+				else {
+					make_unique(m_root, m_shift);
+					push_tail(m_root, m_shift, m_tail);
+				}
+			}
+		}
+		catch (...) {
+			release(leaf, 0);
+			throw;
+		}
+		m_tail = leaf;
+		++m_size;
+	}
+
+	template<typename T, typename Allocator>
+	void PersistentVector<T, Allocator>::pop_back() {
+		if (!m_size) throw OutOfRangeException("PersistentVector");
+		Leaf* tail = static_cast<Leaf*>(m_tail);
+		if (tail->count > 1) {
+			make_unique(m_tail, 0);
+			tail = static_cast<Leaf*>(m_tail);
+			AllocTraits::destroy(m_allocator, tail->data() + --tail->count);
+			--m_size;
+			return;
+		}
+
+		// the last leaf of the trie becomes the tail
+		Node* leaf = nullptr;
+		if (m_size > 1) {
+			leaf = const_cast<Leaf*>(leaf_for(m_size - 2));
+			retain(leaf);
+			try {
+				make_unique(m_root, m_shift);
+				if (pop_tail(m_root, m_shift)) {
+					release(m_root, m_shift);
+					m_root = nullptr;
+				}
+			}
+			catch (...) {
+				release(leaf, 0);
+				throw;
+			}
+		}
+		release(m_tail, 0);
+		m_tail = leaf;
+		--m_size;
+
+		// drop a root left with a single child
+		while (m_root && m_shift > bits && !static_cast<Branch*>(m_root)->children[1]) {
+			Node* child = static_cast<Branch*>(m_root)->children[0];
+			retain(child);
+			release(m_root, m_shift);
+			m_root = child;
+			m_shift -= bits;
+		}
+	}
+
+	template<typename T, typename Allocator>
+	void PersistentVector<T, Allocator>::swap(PersistentVector& other) noexcept {
+		swap_storage(other);
+		if constexpr (AllocTraits::propagate_on_container_swap::value)
+			std::swap(m_allocator, other.m_allocator);
+	}
+
+	// Private Members
+	template<typename T, typename Allocator>
+	size_t PersistentVector<T, Allocator>::tail_offset() const noexcept {
+		return m_size < branching ? 0 : ((m_size - 1) >> bits) << bits;
+	}
+
+	template<typename T, typename Allocator>
+	const typename PersistentVector<T, Allocator>::Leaf* PersistentVector<T, Allocator>::leaf_for(size_t pos) const noexcept {
+		if (pos >= tail_offset()) return static_cast<const Leaf*>(m_tail);
+		const Node* node = m_root;
+		for (size_t level = m_shift; level > 0; level -= bits)
+			node = static_cast<const Branch*>(node)->children[(pos >> level) & (branching - 1)];
+		return static_cast<const Leaf*>(node);
+	}
+
+	template<typename T, typename Allocator>
+	typename PersistentVector<T, Allocator>::Branch* PersistentVector<T, Allocator>::new_branch() {
+		BranchAllocator allocator(m_allocator);
+		Branch* branch = std::allocator_traits<BranchAllocator>::allocate(allocator, 1);
+		::new (static_cast<void*>(branch)) Branch();
+		return branch;
+	}
+
+	template<typename T, typename Allocator>
+	typename PersistentVector<T, Allocator>::Leaf* PersistentVector<T, Allocator>::new_leaf() {
+		LeafAllocator allocator(m_allocator);
+		Leaf* leaf = std::allocator_traits<LeafAllocator>::allocate(allocator, 1);
+		::new (static_cast<void*>(leaf)) Leaf();
+		return leaf;
+	}
+
+	template<typename T, typename Allocator>
+	void PersistentVector<T, Allocator>::free_branch(Branch* branch) noexcept {
+		BranchAllocator allocator(m_allocator);
+		branch->~Branch();
+		std::allocator_traits<BranchAllocator>::deallocate(allocator, branch, 1);
+	}
+
+	template<typename T, typename Allocator>
+	void PersistentVector<T, Allocator>::free_leaf(Leaf* leaf) noexcept {
+		LeafAllocator allocator(m_allocator);
+		for (size_t i = leaf->count; i > 0; --i)
+			AllocTraits::destroy(m_allocator, leaf->data() + i - 1);
+		leaf->~Leaf();
+		std::allocator_traits<LeafAllocator>::deallocate(allocator, leaf, 1);
+	}
+
+	template<typename T, typename Allocator>
+	void PersistentVector<T, Allocator>::retain(Node* node) noexcept {
+		if (node) node->refs.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	template<typename T, typename Allocator>
+	void PersistentVector<T, Allocator>::release(Node* node, size_t level) noexcept {
+		if (!node || node->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+		if (!level) return free_leaf(static_cast<Leaf*>(node));
+		Branch* branch = static_cast<Branch*>(node);
+		for (Node* child : branch->children) release(child, level - bits);
+		free_branch(branch);
+	}
+
+	// A count of one means no other object refers to the node, and only this object could
+	// add a reference, so the check does not race with readers of other snapshots
+	template<typename T, typename Allocator>
+	void PersistentVector<T, Allocator>::make_unique(Node*& node, size_t level) {
+		if (node->refs.load(std::memory_order_acquire) == 1) return;
+		Node* copy;
+		if (level) {
+			Branch* branch = new_branch();
+			const Branch* source = static_cast<const Branch*>(node);
+			for (size_t i = 0; i < branching; ++i) {
+				branch->children[i] = source->children[i];
+				retain(branch->children[i]);
+			}
+			copy = branch;
+		}
+		else {
+			Leaf* leaf = new_leaf();
+			Leaf* source = static_cast<Leaf*>(node);
+			try {
+				for (; leaf->count < source->count; ++leaf->count)
+					AllocTraits::construct(m_allocator, leaf->data() + leaf->count, source->data()[leaf->count]);
+			}
+			catch (...) {
+				free_leaf(leaf);
+				throw;
+			}
+			copy = leaf;
+		}
+		release(node, level);
+		node = copy;
+	}
+
+	// Chain of single-child branches from the given level down to the leaf
+	template<typename T, typename Allocator>
+	typename PersistentVector<T, Allocator>::Node* PersistentVector<T, Allocator>::new_path(size_t level, Node* leaf) {
+		if (!level) return leaf;
+		Branch* branch = new_branch();
+		try {
+			branch->children[0] = new_path(level - bits, leaf);
+		}
+		catch (...) {
+			free_branch(branch);
+			throw;
+		}
+		return branch;
+	}
+
+	// Hangs the full tail under the trie as its new rightmost leaf; node must be private
+	template<typename T, typename Allocator>
+	void PersistentVector<T, Allocator>::push_tail(Node* node, size_t level, Node* tail) {
+		Branch* branch = static_cast<Branch*>(node);
+		size_t index = ((m_size - 1) >> level) & (branching - 1);
+		if (level == bits) {
+			branch->children[index] = tail;
+			return;
+		}
+		Node*& child = branch->children[index];
+		if (!child) {
+			child = new_path(level - bits, tail);
+			return;
+		}
+		make_unique(child, level - bits);
+		push_tail(child, level - bits, tail);
+	}
+
+	// Unlinks the trie's rightmost leaf from a private node; returns true when the node is
+	// left with no children
+	template<typename T, typename Allocator>
+	bool PersistentVector<T, Allocator>::pop_tail(Node* node, size_t level) {
+		Branch* branch = static_cast<Branch*>(node);
+		size_t index = ((m_size - 2) >> level) & (branching - 1);
+		Node*& child = branch->children[index];
+		if (level > bits) {
+			make_unique(child, level - bits);
+			if (!pop_tail(child, level - bits)) return false;
+		}
+		release(child, level - bits);
+		child = nullptr;
+		return index == 0;
+	}
+
+	template<typename T, typename Allocator>
+	template<typename V>
+	void PersistentVector<T, Allocator>::assign(size_t pos, V&& value) {
+		if (pos >= m_size) throw OutOfRangeException("PersistentVector");
+		Node** node = pos >= tail_offset() ? &m_tail : &m_root;
+		for (size_t level = node == &m_tail ? 0 : m_shift;; level -= bits) {
+			make_unique(*node, level);
+			if (!level) break;
+			node = &static_cast<Branch*>(*node)->children[(pos >> level) & (branching - 1)];
+		}
+		static_cast<Leaf*>(*node)->data()[pos % branching] = std::forward<V>(value);
+	}
+
+	template<typename T, typename Allocator>
+	void PersistentVector<T, Allocator>::swap_storage(PersistentVector& other) noexcept {
+		std::swap(m_root, other.m_root);
+		std::swap(m_tail, other.m_tail);
+		std::swap(m_shift, other.m_shift);
+		std::swap(m_size, other.m_size);
+	}
+
+	namespace pmr {
+		template<typename T>
+		using PersistentVector = Containers::PersistentVector<T, std::pmr::polymorphic_allocator<T>>;
+	}
+}
\ No newline at end of file
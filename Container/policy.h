@@ -0,0 +1,122 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include "globals.h"
+
+namespace Containers {
+
+	// Vector growth policies
+	// grow(capacity, required) returns the capacity to allocate when at least required
+	// slots are needed and capacity slots are already held.
+
+	template<size_t Numerator, size_t Denominator, size_t InitSize = Global::VECTOR_INIT_SIZE>
+	struct GeometricGrowth {
+		static_assert(Numerator > Denominator && Denominator > 0, "growth factor must exceed 1");
+
+		static constexpr size_t init_size = InitSize;
+
+		static constexpr size_t grow(size_t capacity, size_t required) noexcept {
+			size_t grown = capacity / Denominator * Numerator + capacity % Denominator * Numerator / Denominator;
+			return std::max({ required, grown, init_size });
+		}
+	};
+
+	template<size_t InitSize = Global::VECTOR_INIT_SIZE>
+	struct PowerOfTwoGrowth {
+		static constexpr size_t init_size = std::bit_ceil(InitSize);
+
+		static constexpr size_t grow(size_t capacity, size_t required) noexcept {
+			return std::bit_ceil(std::max({ required, capacity + 1, init_size }));
+		}
+	};
+
+	using DoublingGrowth = GeometricGrowth<Global::VECTOR_RESIZE_FACTOR, 1>;
+
+	using OneAndHalfGrowth = GeometricGrowth<3, 2>;
+
+	using DefaultGrowth = DoublingGrowth;
+
+	// UnorderedMap hash policies
+	// bucket_count(n) rounds a requested bucket count to one the policy can index,
+	// grow(n) gives the bucket count to rehash to once the load factor is exceeded and
+	// index(hash, n) maps a hash value to its bucket.
+
+	struct ModuloHashPolicy {
+		static constexpr size_t init_bucket_count = Global::UNORDERED_MAP_INIT_BUCKET_COUNT;
+
+		static constexpr double max_load_factor = Global::UNORDERED_MAP_INIT_LOAD_FACTOR;
+
+		static constexpr size_t bucket_count(size_t requested) noexcept {
+			return std::max<size_t>(requested, 1);
+		}
+
+		static constexpr size_t grow(size_t bucket_count) noexcept {
+			return bucket_count * Global::UNORDERED_MAP_RESIZE_FACTOR;
+		}
+
+		static constexpr size_t index(size_t hash, size_t bucket_count) noexcept {
+			return hash % bucket_count;
+		}
+	};
+
+	struct PowerOfTwoHashPolicy {
+		static constexpr size_t init_bucket_count = std::bit_ceil(Global::UNORDERED_MAP_INIT_BUCKET_COUNT);
+
+		static constexpr double max_load_factor = Global::UNORDERED_MAP_INIT_LOAD_FACTOR;
+
+		static constexpr size_t bucket_count(size_t requested) noexcept {
+			return std::bit_ceil(std::max<size_t>(requested, 1));
+		}
+
+		static constexpr size_t grow(size_t bucket_count) noexcept {
+			return bucket_count << 1;
+		}
+
+		// Folds the upper half of the hash into the lower half, so keys that differ only in
+		// their high bits (pointers, shifted ids under an identity std::hash) still spread out
+		static constexpr size_t index(size_t hash, size_t bucket_count) noexcept {
+			hash ^= hash >> (sizeof(size_t) * 4);
+			return hash & (bucket_count - 1);
+		}
+	};
+
+	struct PrimeHashPolicy {
+		static constexpr size_t init_bucket_count = 17;
+
+		static constexpr double max_load_factor = Global::UNORDERED_MAP_INIT_LOAD_FACTOR;
+
+		static constexpr size_t bucket_count(size_t requested) noexcept {
+			for (uint64_t prime : primes) {
+				if (prime >= requested) return static_cast<size_t>(prime);
+			}
+			return requested;
+		}
+
+		static constexpr size_t grow(size_t bucket_count) noexcept {
+			return PrimeHashPolicy::bucket_count(bucket_count + 1);
+		}
+
+		static constexpr size_t index(size_t hash, size_t bucket_count) noexcept {
+			return hash % bucket_count;
+		}
+
+	private:
+		// Smallest prime above each power of two
+		static constexpr uint64_t primes[] = {
+			2, 3, 5, 7, 11, 17, 37, 67, 131, 257, 521, 1031, 2053, 4099, 8209, 16411, 32771,
+			65537, 131101, 262147, 524309, 1048583, 2097169, 4194319, 8388617, 16777259,
+			33554467, 67108879, 134217757, 268435459, 536870923, 1073741827, 2147483659,
+			4294967311, 8589934609, 17179869209, 34359738421, 68719476767, 137438953481,
+			274877906951, 549755813911, 1099511627791, 2199023255579, 4398046511119,
+			8796093022237, 17592186044423, 35184372088891, 70368744177679, 140737488355333,
+			281474976710677, 562949953421381, 1125899906842679, 2251799813685269,
+			4503599627370517, 9007199254740997, 18014398509482143, 36028797018963971,
+			72057594037928017, 144115188075855881, 288230376151711813, 576460752303423619,
+			1152921504606847009, 2305843009213693967, 4611686018427388039, 9223372036854775837ULL
+		};
+	};
+
+	using DefaultHashPolicy = ModuloHashPolicy;
+}
\ No newline at end of file
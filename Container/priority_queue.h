@@ -0,0 +1,376 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include "exception.h"
+#include "vector.h"
+
+namespace Containers {
+
+	// Arity-ary heap in a Vector with addressable elements
+	// The top is the element no other compares after, as with std::priority_queue: the
+	// largest for std::less, the smallest for std::greater. A node's children sit next to
+	// each other at Arity * i + 1 ..., so with Arity 4 a sift-down step compares children
+	// on one cache line and the heap is half as deep as a binary one. Sifting moves a hole
+	// instead of swapping. push returns a Handle naming the element until it leaves the
+	// queue; handles are then reused, so a stale one may name a newer element. A position
+	// table maps handles to heap slots for update, increase_key, decrease_key and erase,
+	// and freed handles are chained through the same table so pop never allocates.
+	// Keys rise and fall in Compare order, as in Boost.Heap: with std::less a larger value
+	// is an increase, with std::greater a smaller one, and increasing a key moves it toward
+	// the top.
+	template<typename T, typename Compare = std::less<T>, size_t Arity = 4, typename Allocator = std::allocator<T>>
+	class PriorityQueue {
+		static_assert(Arity >= 2, "a heap needs at least two children per node");
+
+	public:
+		using Handle = size_t;
+
+		explicit PriorityQueue(const Compare& = Compare(), const Allocator& = Allocator());
+
+		// Builds the heap in O(n); element i of the range gets handle i
+		template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
+		PriorityQueue(IT, IT, const Compare& = Compare(), const Allocator& = Allocator());
+
+		PriorityQueue(std::initializer_list<T>, const Compare& = Compare(), const Allocator& = Allocator());
+
+		Allocator get_allocator() const noexcept;
+
+		// Element Access
+		const T& top() const;
+
+		Handle top_handle() const;
+
+		// Value of a queued element
+		const T& operator[](Handle) const;
+
+		bool contains(Handle) const noexcept;
+
+		// Capacity
+		bool empty() const noexcept;
+
+		size_t size() const noexcept;
+
+		void reserve(size_t);
+
+		// Modifiers
+		Handle push(const T&);
+
+		Handle push(T&&);
+
+		template<typename...Args>
+		Handle emplace(Args&&...);
+
+		void pop();
+
+		// Replaces the queue's contents with the range in O(n); element i gets handle i. If
+		// copying an element or comparing throws, the queue is left empty.
+		template<class IT>
+		void assign(IT, IT);
+
+		// Gives an element a new value, moving it either way
+		void update(Handle, const T&);
+
+		// Gives an element a value that does not compare before its old one and sifts it
+		// toward the top only
+		void increase_key(Handle, const T&);
+
+		// Gives an element a value that does not compare after its old one and sifts it
+		// away from the top only
+		void decrease_key(Handle, const T&);
+
+		void erase(Handle);
+
+		void clear() noexcept;
+
+		void swap(PriorityQueue&) noexcept;
+
+	private:
+		struct Entry {
+			T value;
+			Handle handle;
+
+			template<typename...Args>
+			Entry(Handle handle, Args&&...args) : value(std::forward<Args>(args)...), handle(handle) {}
+		};
+
+		using EntryAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Entry>;
+		using SizeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<size_t>;
+
+		// Position entries with this bit set are free handles holding the next free one
+		static constexpr size_t free_bit = ~(~size_t(0) >> 1);
+		static constexpr size_t no_handle = ~size_t(0);
+
+		Vector<Entry, DefaultGrowth, EntryAllocator> m_heap;
+		Vector<size_t, DefaultGrowth, SizeAllocator> m_position;
+		size_t m_free;
+		Compare m_compare;
+
+		Handle acquire_handle();
+
+		void release_handle(Handle) noexcept;
+
+		size_t position(Handle) const;
+
+		template<bool Track = true>
+		void place(size_t, Entry&&);
+
+		void sift_up(size_t);
+
+		template<bool Track = true>
+		void sift_down(size_t);
+	};
+
+	// Constructors
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	PriorityQueue<T, Compare, Arity, Allocator>::PriorityQueue(const Compare& compare, const Allocator& allocator) :
+		m_heap(EntryAllocator(allocator)), m_position(SizeAllocator(allocator)), m_free(no_handle), m_compare(compare) {}
+
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
+	PriorityQueue<T, Compare, Arity, Allocator>::PriorityQueue(IT first, IT last, const Compare& compare, const Allocator& allocator) :
+		PriorityQueue(compare, allocator) {
+		assign(first, last);
+	}
+
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	PriorityQueue<T, Compare, Arity, Allocator>::PriorityQueue(std::initializer_list<T> il, const Compare& compare, const Allocator& allocator) :
+		PriorityQueue(il.begin(), il.end(), compare, allocator) {}
+
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	Allocator PriorityQueue<T, Compare, Arity, Allocator>::get_allocator() const noexcept {
+		return Allocator(m_heap.get_allocator());
+	}
+
+	// Element Access
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	const T& PriorityQueue<T, Compare, Arity, Allocator>::top() const {
+		if (m_heap.empty()) throw OutOfRangeException("PriorityQueue");
+		return m_heap[0].value;
+	}
+
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	typename PriorityQueue<T, Compare, Arity, Allocator>::Handle PriorityQueue<T, Compare, Arity, Allocator>::top_handle() const {
+		if (m_heap.empty()) throw OutOfRangeException("PriorityQueue");
+		return m_heap[0].handle;
+	}
+
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	const T& PriorityQueue<T, Compare, Arity, Allocator>::operator[](Handle handle) const {
+		return m_heap[position(handle)].value;
+	}
+
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	bool PriorityQueue<T, Compare, Arity, Allocator>::contains(Handle handle) const noexcept {
+		return handle < m_position.size() && !(m_position[handle] & free_bit);
+	}
+
+	// Capacity
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	bool PriorityQueue<T, Compare, Arity, Allocator>::empty() const noexcept { return m_heap.empty(); }
+
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	size_t PriorityQueue<T, Compare, Arity, Allocator>::size() const noexcept { return m_heap.size(); }
+
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	void PriorityQueue<T, Compare, Arity, Allocator>::reserve(size_t capacity) {
+		m_heap.reserve(capacity);
+		m_position.reserve(capacity);
+	}
+
+	// Modifiers
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	typename PriorityQueue<T, Compare, Arity, Allocator>::Handle PriorityQueue<T, Compare, Arity, Allocator>::push(const T& value) {
+		return emplace(value);
+	}
+
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	typename PriorityQueue<T, Compare, Arity, Allocator>::Handle PriorityQueue<T, Compare, Arity, Allocator>::push(T&& value) {
+		return emplace(std::move(value));
+	}
+
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	template<typename...Args>
+	typename PriorityQueue<T, Compare, Arity, Allocator>::Handle PriorityQueue<T, Compare, Arity, Allocator>::emplace(Args&&...args) {
+		Handle handle = acquire_handle();
+		try {
+			m_heap.emplace_back(handle, std::forward<Args>(args)...);
+		}
+		catch (...) {
+			release_handle(handle);
+			throw;
+		}
+		m_position[handle] = m_heap.size() - 1;
+		sift_up(m_heap.size() - 1);
+		return handle;
+	}
+
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	void PriorityQueue<T, Compare, Arity, Allocator>::pop() {
+		if (m_heap.empty()) throw OutOfRangeException("PriorityQueue");
+		release_handle(m_heap[0].handle);
+		if (m_heap.size() > 1) {
+			Entry last = std::move(m_heap.back());
+			m_heap.pop_back();
+			place(0, std::move(last));
+			sift_down(0);
+		}
+		else m_heap.pop_back();
+	}
+
+	// Floyd's construction: sift down every internal node, deepest first, then fill the
+	// position table in one sequential pass rather than on every move
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	template<class IT>
+	void PriorityQueue<T, Compare, Arity, Allocator>::assign(IT first, IT last) {
+		clear();
+		m_position.clear();
+		m_free = no_handle;
+		try {
+			if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<IT>::iterator_category>)
+				m_heap.reserve(static_cast<size_t>(std::distance(first, last)));
+			for (; first != last; ++first)
+				m_heap.emplace_back(m_heap.size(), *first);
+			m_position.resize(m_heap.size());
+			for (size_t i = m_heap.size() > 1 ? (m_heap.size() - 2) / Arity + 1 : 0; i > 0; --i)
+				sift_down<false>(i - 1);
+		}
+		catch (...) {
+			// the entries have no positions yet, so none of them can stay
+			m_heap.clear();
+			m_position.clear();
+			throw;
+		}
+		for (size_t i = 0; i < m_heap.size(); ++i)
+			m_position[m_heap[i].handle] = i;
+	}
+
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	void PriorityQueue<T, Compare, Arity, Allocator>::update(Handle handle, const T& value) {
+		size_t pos = position(handle);
+		m_heap[pos].value = value;
+		if (pos && m_compare(m_heap[(pos - 1) / Arity].value, m_heap[pos].value)) sift_up(pos);
+		else sift_down(pos);
+	}
+
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	void PriorityQueue<T, Compare, Arity, Allocator>::increase_key(Handle handle, const T& value) {
+		size_t pos = position(handle);
+		if (m_compare(value, m_heap[pos].value)) throw ContainerException("PriorityQueue", "Key moves away from the top");
+		m_heap[pos].value = value;
+		sift_up(pos);
+	}
+
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	void PriorityQueue<T, Compare, Arity, Allocator>::decrease_key(Handle handle, const T& value) {
+		size_t pos = position(handle);
+		if (m_compare(m_heap[pos].value, value)) throw ContainerException("PriorityQueue", "Key moves toward the top");
+		m_heap[pos].value = value;
+		sift_down(pos);
+	}
+
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	void PriorityQueue<T, Compare, Arity, Allocator>::erase(Handle handle) {
+		size_t pos = position(handle);
+		release_handle(handle);
+		if (pos + 1 == m_heap.size()) {
+			m_heap.pop_back();
+			return;
+		}
+		Entry last = std::move(m_heap.back());
+		m_heap.pop_back();
+		place(pos, std::move(last));
+		if (pos && m_compare(m_heap[(pos - 1) / Arity].value, m_heap[pos].value)) sift_up(pos);
+		else sift_down(pos);
+	}
+
+	// Frees every handle; the position table keeps its size so handles stay distinct
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	void PriorityQueue<T, Compare, Arity, Allocator>::clear() noexcept {
+		for (size_t i = 0; i < m_heap.size(); ++i)
+			release_handle(m_heap[i].handle);
+		m_heap.clear();
+	}
+
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	void PriorityQueue<T, Compare, Arity, Allocator>::swap(PriorityQueue& other) noexcept {
+		m_heap.swap(other.m_heap);
+		m_position.swap(other.m_position);
+		std::swap(m_free, other.m_free);
+		std::swap(m_compare, other.m_compare);
+	}
+
+	// Private Members
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	typename PriorityQueue<T, Compare, Arity, Allocator>::Handle PriorityQueue<T, Compare, Arity, Allocator>::acquire_handle() {
+		if (m_free == no_handle) {
+			m_position.push_back(free_bit | no_handle);
+			return m_position.size() - 1;
+		}
+		Handle handle = m_free;
+		size_t next = m_position[handle] & ~free_bit;
+		m_free = next == (no_handle & ~free_bit) ? no_handle : next;
+		return handle;
+	}
+
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	void PriorityQueue<T, Compare, Arity, Allocator>::release_handle(Handle handle) noexcept {
+		m_position[handle] = free_bit | m_free;
+		m_free = handle;
+	}
+
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	size_t PriorityQueue<T, Compare, Arity, Allocator>::position(Handle handle) const {
+		if (!contains(handle)) throw OutOfRangeException("PriorityQueue");
+		return m_position[handle];
+	}
+
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	template<bool Track>
+	void PriorityQueue<T, Compare, Arity, Allocator>::place(size_t pos, Entry&& entry) {
+		if constexpr (Track) m_position[entry.handle] = pos;
+		m_heap[pos] = std::move(entry);
+	}
+
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	void PriorityQueue<T, Compare, Arity, Allocator>::sift_up(size_t pos) {
+		Entry entry = std::move(m_heap[pos]);
+		while (pos) {
+			size_t parent = (pos - 1) / Arity;
+			if (!m_compare(m_heap[parent].value, entry.value)) break;
+			place(pos, std::move(m_heap[parent]));
+			pos = parent;
+		}
+		place(pos, std::move(entry));
+	}
+
+	template<typename T, typename Compare, size_t Arity, typename Allocator>
+	template<bool Track>
+	void PriorityQueue<T, Compare, Arity, Allocator>::sift_down(size_t pos) {
+		size_t size = m_heap.size();
+		Entry entry = std::move(m_heap[pos]);
+		for (;;) {
+			size_t first = pos * Arity + 1;
+			if (first >= size) break;
+			size_t last = first + Arity < size ? first + Arity : size;
+			size_t best = first;
+			for (size_t child = first + 1; child < last; ++child) {
+				if (m_compare(m_heap[best].value, m_heap[child].value)) best = child;
+			}
+			if (!m_compare(entry.value, m_heap[best].value)) break;
+			place<Track>(pos, std::move(m_heap[best]));
+			pos = best;
+		}
+		place<Track>(pos, std::move(entry));
+	}
+
+	namespace pmr {
+		template<typename T, typename Compare = std::less<T>, size_t Arity = 4>
+		using PriorityQueue = Containers::PriorityQueue<T, Compare, Arity, std::pmr::polymorphic_allocator<T>>;
+	}
+}
\ No newline at end of file
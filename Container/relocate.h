@@ -0,0 +1,74 @@
+#pragma once
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace Containers {
+
+	// Types whose objects can be moved to new storage with a plain memcpy, leaving the
+	// source storage to be reused without running its destructor. Specialize this for
+	// user types that own no self-referential state, e.g. a handle around a heap pointer.
+	template<typename T>
+	struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+	template<typename T>
+	inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+	// Moves n live objects from first into the raw storage at dest and ends their lifetime
+	// at the source. The ranges must not overlap. If an element copy throws, everything
+	// built at dest is destroyed and the source is left untouched.
+	template<typename T>
+	void relocate(T* first, size_t n, T* dest) {
+		if (!n) return;
+		if constexpr (is_trivially_relocatable_v<T>) {
+			std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), n * sizeof(T));
+		}
+		else {
+			if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+				std::uninitialized_move_n(first, n, dest);
+			else
+				std::uninitialized_copy_n(first, n, dest);
+			std::destroy_n(first, n);
+		}
+	}
+
+	// As above, but constructs and destroys non-trivially relocatable elements through
+	// allocator_traits, for containers that take an Allocator
+	template<typename T, typename Allocator>
+	void relocate(Allocator& allocator, T* first, size_t n, T* dest) {
+		using AllocTraits = std::allocator_traits<Allocator>;
+		if (!n) return;
+		if constexpr (is_trivially_relocatable_v<T>) {
+			std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), n * sizeof(T));
+		}
+		else {
+			size_t built = 0;
+			try {
+				for (; built < n; ++built)
+					AllocTraits::construct(allocator, dest + built, std::move_if_noexcept(first[built]));
+			}
+			catch (...) {
+				for (size_t i = 0; i < built; ++i)
+					AllocTraits::destroy(allocator, dest + i);
+				throw;
+			}
+			for (size_t i = 0; i < n; ++i)
+				AllocTraits::destroy(allocator, first + i);
+		}
+	}
+
+	// Allocators that can resize a block without the caller copying it, e.g. by remapping
+	// its pages. reallocate(p, old_n, new_n) returns the block holding the bytes of the
+	// first min(old_n, new_n) objects, or nullptr when it left p untouched. Only sound for
+	// trivially relocatable elements.
+	template<typename Allocator, typename = void>
+	struct has_reallocate : std::false_type {};
+
+	template<typename Allocator>
+	struct has_reallocate<Allocator, std::void_t<decltype(std::declval<Allocator&>().reallocate(
+		std::declval<typename std::allocator_traits<Allocator>::pointer>(), size_t(), size_t()))>> : std::true_type {};
+
+	template<typename Allocator>
+	inline constexpr bool has_reallocate_v = has_reallocate<Allocator>::value;
+}
\ No newline at end of file
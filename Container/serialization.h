@@ -0,0 +1,519 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "exception.h"
+#include "linked_list.h"
+#include "unordered_map.h"
+#include "vector.h"
+
+#if defined(_WIN32)
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace Containers {
+
+	// Binary snapshots of Vector, LinkedList and UnorderedMap
+	// save() writes a 12 byte header (magic "CNTR", format version, container kind, byte
+	// order, element size) followed by the container: a 64-bit element count and then each
+	// element through Serializer<T>. Elements Serializer writes bitwise go out as one block
+	// in a single write/writev, and a bitwise Vector is read straight into its storage.
+	// Files are read back on a machine with the same byte order and element layout.
+	// Counts are checked against what is left of the file before anything is reserved, and
+	// when that is unknown (a pipe) storage grows a chunk at a time as the data arrives.
+
+	inline constexpr uint16_t serialization_version = 1;
+
+	enum class ContainerKind : uint8_t { Vector = 1, LinkedList = 2, UnorderedMap = 3 };
+
+	// Buffered writer to a file descriptor. Errors are reported as exceptions from write()
+	// and flush(); call flush() before the writer goes away, as the destructor drops them.
+	class BinaryWriter {
+	public:
+		explicit BinaryWriter(int, size_t = 64 * 1024);
+
+		BinaryWriter(const BinaryWriter&) = delete;
+
+		BinaryWriter& operator=(const BinaryWriter&) = delete;
+
+		~BinaryWriter();
+
+		void write(const void*, size_t);
+
+		void flush();
+
+	private:
+		int m_fd;
+		std::unique_ptr<unsigned char[]> m_buffer;
+		size_t m_capacity;
+		size_t m_size;
+
+		void write_all(const void*, size_t, const void*, size_t);
+	};
+
+	// Buffered reader from a file descriptor that never holds more than its buffer, so a
+	// snapshot can be streamed in bounded memory. Reads that do not fit the buffer go
+	// straight to their destination.
+	class BinaryReader {
+	public:
+		explicit BinaryReader(int, size_t = 64 * 1024);
+
+		BinaryReader(const BinaryReader&) = delete;
+
+		BinaryReader& operator=(const BinaryReader&) = delete;
+
+		void read(void*, size_t);
+
+		// Bytes left to read, or unknown_size when the descriptor is not a regular file
+		uint64_t remaining() const noexcept;
+
+		static constexpr uint64_t unknown_size = ~uint64_t(0);
+
+	private:
+		int m_fd;
+		std::unique_ptr<unsigned char[]> m_buffer;
+		size_t m_capacity;
+		size_t m_position;
+		size_t m_size;
+
+		size_t read_some(void*, size_t);
+	};
+
+	// Element serializers
+	// Specialize Serializer<T> with static write(BinaryWriter&, const T&) and
+	// static T read(BinaryReader&) for element types of your own. Trivially copyable types
+	// are written bitwise unless specialized; a specialization that also declares
+	// static constexpr bool bitwise = true lets containers move its elements in blocks.
+	template<typename T, typename = void>
+	struct Serializer;
+
+	template<typename T, typename = void>
+	struct is_bitwise_serializable : std::false_type {};
+
+	template<typename T>
+	struct is_bitwise_serializable<T, std::enable_if_t<Serializer<T>::bitwise>> : std::true_type {};
+
+	template<typename T>
+	inline constexpr bool is_bitwise_serializable_v = is_bitwise_serializable<T>::value;
+
+	namespace detail {
+
+		// Largest block read or reserved at once while the data behind it is unconfirmed
+		inline constexpr size_t read_chunk = 1 << 20;
+
+		// Fewest bytes a value can take in a file; 0 when Serializer<T> gives no bound
+		template<typename T, typename = void>
+		struct min_serialized_size : std::integral_constant<size_t, 0> {};
+
+		template<typename T>
+		struct min_serialized_size<T, std::enable_if_t<is_bitwise_serializable_v<T>>> : std::integral_constant<size_t, sizeof(T)> {};
+
+		// Written field by field
+		template<typename A, typename B>
+		struct min_serialized_size<std::pair<A, B>, std::enable_if_t<!is_bitwise_serializable_v<std::pair<A, B>>>> :
+			std::integral_constant<size_t, min_serialized_size<std::remove_const_t<A>>::value + min_serialized_size<std::remove_const_t<B>>::value> {};
+
+		// Strings and containers start with their count
+		template<typename C, typename Traits, typename A>
+		struct min_serialized_size<std::basic_string<C, Traits, A>> : std::integral_constant<size_t, sizeof(uint64_t)> {};
+
+		template<typename T, typename Growth, typename Allocator>
+		struct min_serialized_size<Vector<T, Growth, Allocator>> : std::integral_constant<size_t, sizeof(uint64_t)> {};
+
+		template<typename T, typename Allocator>
+		struct min_serialized_size<LinkedList<T, Allocator>> : std::integral_constant<size_t, sizeof(uint64_t)> {};
+
+		template<typename K, typename V, typename Hash, typename Equal, typename Policy, typename Allocator>
+		struct min_serialized_size<UnorderedMap<K, V, Hash, Equal, Policy, Allocator>> : std::integral_constant<size_t, sizeof(uint64_t)> {};
+
+		// Reads an element count and returns it with how many elements may be reserved for
+		// up front: all of them when the rest of the file can hold them, a chunk's worth of
+		// Size-byte elements when the file or Element (their smallest size in it) is unknown.
+		// A count the file cannot hold is truncated data and throws.
+		template<size_t Element, size_t Size>
+		std::pair<size_t, size_t> read_count(BinaryReader& reader) {
+			uint64_t count;
+			reader.read(&count, sizeof(count));
+			uint64_t remaining = reader.remaining();
+			if (remaining == BinaryReader::unknown_size || !Element)
+				return { static_cast<size_t>(count), static_cast<size_t>(std::min<uint64_t>(count, std::max<size_t>(read_chunk / Size, 1))) };
+			if (count > remaining / Element) throw ContainerException("BinaryReader", "Unexpected End of File");
+			return { static_cast<size_t>(count), static_cast<size_t>(count) };
+		}
+	}
+
+	template<typename T>
+	struct Serializer<T, std::enable_if_t<std::is_trivially_copyable_v<T>>> {
+		static constexpr bool bitwise = true;
+
+		static void write(BinaryWriter& writer, const T& value) {
+			writer.write(std::addressof(value), sizeof(T));
+		}
+
+		static T read(BinaryReader& reader) {
+			std::array<unsigned char, sizeof(T)> bytes;
+			reader.read(bytes.data(), sizeof(T));
+			return std::bit_cast<T>(bytes);
+		}
+	};
+
+	template<typename C, typename Traits, typename A>
+	struct Serializer<std::basic_string<C, Traits, A>, std::enable_if_t<std::is_trivially_copyable_v<C>>> {
+		static void write(BinaryWriter& writer, const std::basic_string<C, Traits, A>& value) {
+			uint64_t length = value.size();
+			writer.write(&length, sizeof(length));
+			writer.write(value.data(), value.size() * sizeof(C));
+		}
+
+		static std::basic_string<C, Traits, A> read(BinaryReader& reader) {
+			auto [length, reserved] = detail::read_count<sizeof(C), sizeof(C)>(reader);
+			std::basic_string<C, Traits, A> value;
+			value.reserve(reserved);
+			while (value.size() < length) {
+				size_t done = value.size();
+				value.resize(done + std::min(length - done, detail::read_chunk / sizeof(C)));
+				reader.read(value.data() + done, (value.size() - done) * sizeof(C));
+			}
+			return value;
+		}
+	};
+
+	template<typename A, typename B>
+	struct Serializer<std::pair<A, B>, std::enable_if_t<!std::is_trivially_copyable_v<std::pair<A, B>>>> {
+		static void write(BinaryWriter& writer, const std::pair<A, B>& value) {
+			Serializer<std::remove_const_t<A>>::write(writer, value.first);
+			Serializer<std::remove_const_t<B>>::write(writer, value.second);
+		}
+
+		static std::pair<std::remove_const_t<A>, std::remove_const_t<B>> read(BinaryReader& reader) {
+			auto first = Serializer<std::remove_const_t<A>>::read(reader);
+			return { std::move(first), Serializer<std::remove_const_t<B>>::read(reader) };
+		}
+	};
+
+	// Containers nest without headers of their own, e.g. UnorderedMap<std::string, Vector<int>>
+	template<typename T, typename Growth, typename Allocator>
+	struct Serializer<Vector<T, Growth, Allocator>> {
+		static void write(BinaryWriter& writer, const Vector<T, Growth, Allocator>& vector) {
+			uint64_t count = vector.size();
+			writer.write(&count, sizeof(count));
+			if constexpr (is_bitwise_serializable_v<T>) {
+				if (count) writer.write(vector.data(), vector.size() * sizeof(T));
+			}
+			else {
+				for (const T& value : vector) Serializer<T>::write(writer, value);
+			}
+		}
+
+		static Vector<T, Growth, Allocator> read(BinaryReader& reader) {
+			Vector<T, Growth, Allocator> vector;
+			read_into(reader, vector);
+			return vector;
+		}
+
+		// Bitwise elements are read into spare capacity a chunk at a time without being
+		// constructed first
+		static void read_into(BinaryReader& reader, Vector<T, Growth, Allocator>& vector) {
+			auto [count, reserved] = detail::read_count<detail::min_serialized_size<T>::value, sizeof(T)>(reader);
+			vector.clear();
+			vector.reserve(reserved);
+			if constexpr (is_bitwise_serializable_v<T> && (std::is_trivially_copyable_v<T> || std::is_default_constructible_v<T>)) {
+				while (vector.m_size < count) {
+					size_t done = vector.m_size;
+					size_t n = std::min(count - done, std::max<size_t>(detail::read_chunk / sizeof(T), 1));
+					if (vector.m_capacity - done < n) vector.reserve(vector.grow_capacity(done + n));
+					if constexpr (std::is_trivially_copyable_v<T>) {
+						reader.read(vector.m_data + done, n * sizeof(T));
+						vector.m_size += n;
+					}
+					else {
+						vector.resize(done + n);
+						reader.read(vector.m_data + done, n * sizeof(T));
+					}
+				}
+			}
+			else {
+				for (size_t i = 0; i < count; ++i) vector.push_back(Serializer<T>::read(reader));
+			}
+		}
+	};
+
+	template<typename T, typename Allocator>
+	struct Serializer<LinkedList<T, Allocator>> {
+		static void write(BinaryWriter& writer, const LinkedList<T, Allocator>& list) {
+			uint64_t count = list.size();
+			writer.write(&count, sizeof(count));
+			for (const T& value : list) Serializer<T>::write(writer, value);
+		}
+
+		static LinkedList<T, Allocator> read(BinaryReader& reader) {
+			LinkedList<T, Allocator> list;
+			read_into(reader, list);
+			return list;
+		}
+
+		static void read_into(BinaryReader& reader, LinkedList<T, Allocator>& list) {
+			size_t count = detail::read_count<detail::min_serialized_size<T>::value, sizeof(T)>(reader).first;
+			list.clear();
+			for (size_t i = 0; i < count; ++i) list.push_back(Serializer<T>::read(reader));
+		}
+	};
+
+	template<typename K, typename V, typename Hash, typename Equal, typename Policy, typename Allocator>
+	struct Serializer<UnorderedMap<K, V, Hash, Equal, Policy, Allocator>> {
+		using Map = UnorderedMap<K, V, Hash, Equal, Policy, Allocator>;
+
+		static void write(BinaryWriter& writer, const Map& map) {
+			uint64_t count = map.size();
+			writer.write(&count, sizeof(count));
+			for (const auto& entry : map) {
+				Serializer<K>::write(writer, entry.first);
+				Serializer<V>::write(writer, entry.second);
+			}
+		}
+
+		static Map read(BinaryReader& reader) {
+			Map map;
+			read_into(reader, map);
+			return map;
+		}
+
+		// Sized once up front when the file size is known, so loading never rehashes
+		static void read_into(BinaryReader& reader, Map& map) {
+			auto [count, reserved] = detail::read_count<detail::min_serialized_size<K>::value + detail::min_serialized_size<V>::value, sizeof(std::pair<const K, V>)>(reader);
+			map.clear();
+			map.reserve(reserved);
+			for (size_t i = 0; i < count; ++i) {
+				K key = Serializer<K>::read(reader);
+				map.insert_or_assign(std::move(key), Serializer<V>::read(reader));
+			}
+		}
+	};
+
+	namespace detail {
+
+		template<typename C>
+		struct container_kind;
+
+		template<typename T, typename Growth, typename Allocator>
+		struct container_kind<Vector<T, Growth, Allocator>> {
+			static constexpr ContainerKind kind = ContainerKind::Vector;
+			static constexpr const char* name = "Vector";
+			using value_type = T;
+		};
+
+		template<typename T, typename Allocator>
+		struct container_kind<LinkedList<T, Allocator>> {
+			static constexpr ContainerKind kind = ContainerKind::LinkedList;
+			static constexpr const char* name = "LinkedList";
+			using value_type = T;
+		};
+
+		template<typename K, typename V, typename Hash, typename Equal, typename Policy, typename Allocator>
+		struct container_kind<UnorderedMap<K, V, Hash, Equal, Policy, Allocator>> {
+			static constexpr ContainerKind kind = ContainerKind::UnorderedMap;
+			static constexpr const char* name = "UnorderedMap";
+			using value_type = std::pair<K, V>;
+		};
+
+		// Bytes per element for bitwise elements, 0 for elements written field by field
+		template<typename C>
+		constexpr uint32_t element_size() noexcept {
+			using T = typename container_kind<C>::value_type;
+			if constexpr (is_bitwise_serializable_v<T>) return sizeof(T);
+			else return 0;
+		}
+
+		inline constexpr uint8_t byte_order = std::endian::native == std::endian::little ? 1 : 2;
+
+		template<typename C>
+		void write_header(BinaryWriter& writer) {
+			unsigned char header[12] = { 'C', 'N', 'T', 'R' };
+			uint16_t version = serialization_version;
+			uint32_t size = element_size<C>();
+			std::memcpy(header + 4, &version, sizeof(version));
+			header[6] = static_cast<uint8_t>(container_kind<C>::kind);
+			header[7] = byte_order;
+			std::memcpy(header + 8, &size, sizeof(size));
+			writer.write(header, sizeof(header));
+		}
+
+		template<typename C>
+		void read_header(BinaryReader& reader) {
+			const char* name = container_kind<C>::name;
+			unsigned char header[12];
+			reader.read(header, sizeof(header));
+			uint16_t version;
+			uint32_t size;
+			std::memcpy(&version, header + 4, sizeof(version));
+			std::memcpy(&size, header + 8, sizeof(size));
+			if (std::memcmp(header, "CNTR", 4) || header[6] != static_cast<uint8_t>(container_kind<C>::kind))
+				throw ContainerException(name, "Invalid Header");
+			if (!version || version > serialization_version)
+				throw ContainerException(name, "Unsupported Version");
+			if (header[7] != byte_order || size != element_size<C>())
+				throw ContainerException(name, "Size Mismatch");
+		}
+	}
+
+	template<typename C>
+	void save(BinaryWriter& writer, const C& container) {
+		detail::write_header<C>(writer);
+		Serializer<C>::write(writer, container);
+	}
+
+	// Replaces the contents of container, reusing its allocator and, for a Vector, its storage
+	template<typename C>
+	void load(BinaryReader& reader, C& container) {
+		detail::read_header<C>(reader);
+		Serializer<C>::read_into(reader, container);
+	}
+
+	// Reads a saved Vector or LinkedList one element at a time, handing each to visit
+	// instead of building the container
+	template<typename C, typename F>
+	void load_each(BinaryReader& reader, F visit) {
+		using T = typename detail::container_kind<C>::value_type;
+		static_assert(detail::container_kind<C>::kind != ContainerKind::UnorderedMap, "load_each streams sequences");
+		detail::read_header<C>(reader);
+		size_t count = detail::read_count<detail::min_serialized_size<T>::value, sizeof(T)>(reader).first;
+		for (size_t i = 0; i < count; ++i) visit(Serializer<T>::read(reader));
+	}
+
+	// BinaryWriter
+	inline BinaryWriter::BinaryWriter(int fd, size_t capacity) :
+		m_fd(fd), m_buffer(new unsigned char[capacity ? capacity : 1]), m_capacity(capacity ? capacity : 1), m_size(0) {}
+
+	inline BinaryWriter::~BinaryWriter() {
+		try {
+			flush();
+		}
+		catch (...) {}
+	}
+
+	// Small writes are gathered in the buffer; a block at least as large as the buffer
+	// goes out together with what is buffered in one writev
+	inline void BinaryWriter::write(const void* data, size_t size) {
+		if (size <= m_capacity - m_size) {
+			std::memcpy(m_buffer.get() + m_size, data, size);
+			m_size += size;
+			return;
+		}
+		if (size < m_capacity) {
+			flush();
+			std::memcpy(m_buffer.get(), data, size);
+			m_size = size;
+			return;
+		}
+		write_all(m_buffer.get(), m_size, data, size);
+		m_size = 0;
+	}
+
+	inline void BinaryWriter::flush() {
+		if (!m_size) return;
+		write_all(m_buffer.get(), m_size, nullptr, 0);
+		m_size = 0;
+	}
+
+	inline void BinaryWriter::write_all(const void* first, size_t first_size, const void* second, size_t second_size) {
+		const unsigned char* parts[2] = { static_cast<const unsigned char*>(first), static_cast<const unsigned char*>(second) };
+		size_t sizes[2] = { first_size, second_size };
+		while (sizes[0] || sizes[1]) {
+#if defined(_WIN32)
+			size_t part = sizes[0] ? 0 : 1;
+			int written = _write(m_fd, parts[part], static_cast<unsigned int>(std::min<size_t>(sizes[part], 1u << 30)));
+			if (written < 0) throw ContainerException("BinaryWriter", "Cannot Write File");
+#else
+			iovec vectors[2];
+			int count = 0;
+			for (size_t i = 0; i < 2; ++i) {
+				if (!sizes[i]) continue;
+				vectors[count].iov_base = const_cast<unsigned char*>(parts[i]);
+				vectors[count].iov_len = sizes[i];
+				++count;
+			}
+			ssize_t written = writev(m_fd, vectors, count);
+			if (written < 0) {
+				if (errno == EINTR) continue;
+				throw ContainerException("BinaryWriter", "Cannot Write File");
+			}
+#endif
+			size_t done = static_cast<size_t>(written);
+			for (size_t i = 0; i < 2; ++i) {
+				size_t step = std::min(done, sizes[i]);
+				parts[i] += step;
+				sizes[i] -= step;
+				done -= step;
+			}
+		}
+	}
+
+	// BinaryReader
+	inline BinaryReader::BinaryReader(int fd, size_t capacity) :
+		m_fd(fd), m_buffer(new unsigned char[capacity ? capacity : 1]), m_capacity(capacity ? capacity : 1), m_position(0), m_size(0) {}
+
+	inline void BinaryReader::read(void* data, size_t size) {
+		unsigned char* out = static_cast<unsigned char*>(data);
+		size_t buffered = std::min(size, m_size - m_position);
+		std::memcpy(out, m_buffer.get() + m_position, buffered);
+		m_position += buffered;
+		out += buffered;
+		size -= buffered;
+		while (size) {
+			if (size >= m_capacity) {
+				size_t got = read_some(out, size);
+				out += got;
+				size -= got;
+				continue;
+			}
+			m_size = read_some(m_buffer.get(), m_capacity);
+			m_position = std::min(size, m_size);
+			std::memcpy(out, m_buffer.get(), m_position);
+			out += m_position;
+			size -= m_position;
+		}
+	}
+
+	inline uint64_t BinaryReader::remaining() const noexcept {
+#if defined(_WIN32)
+		struct _stat64 status;
+		if (_fstat64(m_fd, &status) || !(status.st_mode & _S_IFREG)) return unknown_size;
+		int64_t offset = _lseeki64(m_fd, 0, SEEK_CUR);
+#else
+		struct stat status;
+		if (fstat(m_fd, &status) || !S_ISREG(status.st_mode)) return unknown_size;
+		int64_t offset = lseek(m_fd, 0, SEEK_CUR);
+#endif
+		if (offset < 0) return unknown_size;
+		uint64_t unread = status.st_size > offset ? static_cast<uint64_t>(status.st_size - offset) : 0;
+		return unread + (m_size - m_position);
+	}
+
+	// Reads at least one byte, throwing at end of file
+	inline size_t BinaryReader::read_some(void* data, size_t size) {
+		for (;;) {
+#if defined(_WIN32)
+			int got = _read(m_fd, data, static_cast<unsigned int>(std::min<size_t>(size, 1u << 30)));
+#else
+			ssize_t got = ::read(m_fd, data, size);
+			if (got < 0 && errno == EINTR) continue;
+#endif
+			if (got < 0) throw ContainerException("BinaryReader", "Cannot Read File");
+			if (got == 0) throw ContainerException("BinaryReader", "Unexpected End of File");
+			return static_cast<size_t>(got);
+		}
+	}
+}
\ No newline at end of file
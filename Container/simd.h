@@ -0,0 +1,609 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CONTAINERS_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#else
+#define CONTAINERS_SIMD_X86 0
+#endif
+
+// GCC and Clang only emit AVX2/AVX-512 instructions inside functions marked for that
+// target; MSVC accepts the intrinsics anywhere
+#if CONTAINERS_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+#define CONTAINERS_SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define CONTAINERS_SIMD_TARGET(isa)
+#endif
+
+// A kernel that hands a target-specific functor to a generic helper needs everything
+// inlined into itself: GCC will not inline target-specific code into the generic helper
+#if CONTAINERS_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+#define CONTAINERS_SIMD_FLATTEN __attribute__((flatten))
+#else
+#define CONTAINERS_SIMD_FLATTEN
+#endif
+
+namespace Containers {
+	namespace simd {
+
+		enum class Isa { Scalar, SSE2, AVX2, AVX512 };
+
+		// Element types the kernels handle: integers compare bitwise, float and double with
+		// the same semantics as == (NaN never matches, -0.0 matches 0.0)
+		template<typename T>
+		inline constexpr bool is_searchable_v =
+			(std::is_integral_v<T> && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)) ||
+			std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+		// Widest instruction set both the CPU and the OS (saved register state) support
+		inline Isa detect_isa() noexcept {
+#if CONTAINERS_SIMD_X86
+			unsigned int regs[4] = {};
+			auto cpuid = [&regs](unsigned int leaf, unsigned int subleaf) {
+#if defined(_MSC_VER) && !defined(__clang__)
+				int out[4];
+				__cpuidex(out, static_cast<int>(leaf), static_cast<int>(subleaf));
+				for (int i = 0; i < 4; ++i) regs[i] = static_cast<unsigned int>(out[i]);
+#else
+				if (!__get_cpuid_count(leaf, subleaf, &regs[0], &regs[1], &regs[2], &regs[3]))
+					regs[0] = regs[1] = regs[2] = regs[3] = 0;
+#endif
+			};
+			auto xgetbv = []() -> uint64_t {
+#if defined(_MSC_VER) && !defined(__clang__)
+				return _xgetbv(0);
+#else
+				unsigned int lo, hi;
+				__asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+				return (static_cast<uint64_t>(hi) << 32) | lo;
+#endif
+			};
+
+			cpuid(0, 0);
+			unsigned int max_leaf = regs[0];
+			cpuid(1, 0);
+			bool sse2 = regs[3] & (1u << 26);
+			bool osxsave = regs[2] & (1u << 27);
+			if (!sse2) return Isa::Scalar;
+			if (!osxsave || max_leaf < 7) return Isa::SSE2;
+
+			uint64_t xcr0 = xgetbv();
+			bool ymm_state = (xcr0 & 0x6) == 0x6;
+			bool zmm_state = (xcr0 & 0xe6) == 0xe6;
+			cpuid(7, 0);
+			bool avx2 = regs[1] & (1u << 5);
+			bool avx512 = (regs[1] & (1u << 16)) && (regs[1] & (1u << 30));
+			if (avx512 && zmm_state) return Isa::AVX512;
+			if (avx2 && ymm_state) return Isa::AVX2;
+			return Isa::SSE2;
+#else
+			return Isa::Scalar;
+#endif
+		}
+
+		inline Isa active_isa() noexcept {
+			static const Isa isa = detect_isa();
+			return isa;
+		}
+
+		namespace detail {
+			template<typename T>
+			size_t find_scalar(const T* data, size_t n, T value) noexcept {
+				for (size_t i = 0; i < n; ++i) {
+					if (data[i] == value) return i;
+				}
+				return n;
+			}
+
+			template<typename T>
+			size_t count_scalar(const T* data, size_t n, T value) noexcept {
+				size_t count = 0;
+				for (size_t i = 0; i < n; ++i)
+					count += data[i] == value;
+				return count;
+			}
+
+#if CONTAINERS_SIMD_X86
+			// Lane masks: the SSE2 and AVX2 compares yield one bit per byte, so a matching
+			// element sets sizeof(T) bits; the AVX-512 compares yield one bit per element
+
+			template<typename T>
+			CONTAINERS_SIMD_TARGET("sse2") inline uint32_t match_sse2(const T* data, T value) noexcept {
+				if constexpr (std::is_same_v<T, float>) {
+					__m128 eq = _mm_cmpeq_ps(_mm_loadu_ps(data), _mm_set1_ps(value));
+					return static_cast<uint32_t>(_mm_movemask_epi8(_mm_castps_si128(eq)));
+				}
+				else if constexpr (std::is_same_v<T, double>) {
+					__m128d eq = _mm_cmpeq_pd(_mm_loadu_pd(data), _mm_set1_pd(value));
+					return static_cast<uint32_t>(_mm_movemask_epi8(_mm_castpd_si128(eq)));
+				}
+				else {
+					__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+					__m128i eq;
+					if constexpr (sizeof(T) == 1) eq = _mm_cmpeq_epi8(block, _mm_set1_epi8(static_cast<char>(value)));
+					else if constexpr (sizeof(T) == 2) eq = _mm_cmpeq_epi16(block, _mm_set1_epi16(static_cast<short>(value)));
+					else if constexpr (sizeof(T) == 4) eq = _mm_cmpeq_epi32(block, _mm_set1_epi32(static_cast<int>(value)));
+					else {
+						// no 64-bit compare before SSE4.1: both 32-bit halves have to match
+						eq = _mm_cmpeq_epi32(block, _mm_set1_epi64x(static_cast<long long>(value)));
+						eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+					}
+					return static_cast<uint32_t>(_mm_movemask_epi8(eq));
+				}
+			}
+
+			template<typename T>
+			CONTAINERS_SIMD_TARGET("avx2") inline uint32_t match_avx2(const T* data, T value) noexcept {
+				if constexpr (std::is_same_v<T, float>) {
+					__m256 eq = _mm256_cmp_ps(_mm256_loadu_ps(data), _mm256_set1_ps(value), _CMP_EQ_OQ);
+					return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_castps_si256(eq)));
+				}
+				else if constexpr (std::is_same_v<T, double>) {
+					__m256d eq = _mm256_cmp_pd(_mm256_loadu_pd(data), _mm256_set1_pd(value), _CMP_EQ_OQ);
+					return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_castpd_si256(eq)));
+				}
+				else {
+					__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+					__m256i eq;
+					if constexpr (sizeof(T) == 1) eq = _mm256_cmpeq_epi8(block, _mm256_set1_epi8(static_cast<char>(value)));
+					else if constexpr (sizeof(T) == 2) eq = _mm256_cmpeq_epi16(block, _mm256_set1_epi16(static_cast<short>(value)));
+					else if constexpr (sizeof(T) == 4) eq = _mm256_cmpeq_epi32(block, _mm256_set1_epi32(static_cast<int>(value)));
+					else eq = _mm256_cmpeq_epi64(block, _mm256_set1_epi64x(static_cast<long long>(value)));
+					return static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+				}
+			}
+
+			template<typename T>
+			CONTAINERS_SIMD_TARGET("avx512f,avx512bw") inline uint64_t match_avx512(const T* data, T value) noexcept {
+				if constexpr (std::is_same_v<T, float>)
+					return _mm512_cmp_ps_mask(_mm512_loadu_ps(data), _mm512_set1_ps(value), _CMP_EQ_OQ);
+				else if constexpr (std::is_same_v<T, double>)
+					return _mm512_cmp_pd_mask(_mm512_loadu_pd(data), _mm512_set1_pd(value), _CMP_EQ_OQ);
+				else {
+					__m512i block = _mm512_loadu_si512(data);
+					if constexpr (sizeof(T) == 1) return _mm512_cmpeq_epi8_mask(block, _mm512_set1_epi8(static_cast<char>(value)));
+					else if constexpr (sizeof(T) == 2) return _mm512_cmpeq_epi16_mask(block, _mm512_set1_epi16(static_cast<short>(value)));
+					else if constexpr (sizeof(T) == 4) return _mm512_cmpeq_epi32_mask(block, _mm512_set1_epi32(static_cast<int>(value)));
+					else return _mm512_cmpeq_epi64_mask(block, _mm512_set1_epi64(static_cast<long long>(value)));
+				}
+			}
+
+			template<typename T>
+			CONTAINERS_SIMD_TARGET("sse2") size_t find_sse2(const T* data, size_t n, T value) noexcept {
+				constexpr size_t lanes = 16 / sizeof(T);
+				size_t i = 0;
+				for (; i + lanes <= n; i += lanes) {
+					if (uint32_t mask = match_sse2(data + i, value))
+						return i + std::countr_zero(mask) / sizeof(T);
+				}
+				return i + find_scalar(data + i, n - i, value);
+			}
+
+			template<typename T>
+			CONTAINERS_SIMD_TARGET("sse2") size_t count_sse2(const T* data, size_t n, T value) noexcept {
+				constexpr size_t lanes = 16 / sizeof(T);
+				size_t i = 0, bits = 0;
+				for (; i + lanes <= n; i += lanes)
+					bits += std::popcount(match_sse2(data + i, value));
+				return bits / sizeof(T) + count_scalar(data + i, n - i, value);
+			}
+
+			// Four vectors per iteration so the compare and branch overlap the loads
+			template<typename T>
+			CONTAINERS_SIMD_TARGET("avx2") size_t find_avx2(const T* data, size_t n, T value) noexcept {
+				constexpr size_t lanes = 32 / sizeof(T);
+				size_t i = 0;
+				for (; i + 4 * lanes <= n; i += 4 * lanes) {
+					uint32_t m0 = match_avx2(data + i, value);
+					uint32_t m1 = match_avx2(data + i + lanes, value);
+					uint32_t m2 = match_avx2(data + i + 2 * lanes, value);
+					uint32_t m3 = match_avx2(data + i + 3 * lanes, value);
+					if (m0 | m1 | m2 | m3) {
+						if (m0) return i + std::countr_zero(m0) / sizeof(T);
+						if (m1) return i + lanes + std::countr_zero(m1) / sizeof(T);
+						if (m2) return i + 2 * lanes + std::countr_zero(m2) / sizeof(T);
+						return i + 3 * lanes + std::countr_zero(m3) / sizeof(T);
+					}
+				}
+				for (; i + lanes <= n; i += lanes) {
+					if (uint32_t mask = match_avx2(data + i, value))
+						return i + std::countr_zero(mask) / sizeof(T);
+				}
+				return i + find_scalar(data + i, n - i, value);
+			}
+
+			template<typename T>
+			CONTAINERS_SIMD_TARGET("avx2") size_t count_avx2(const T* data, size_t n, T value) noexcept {
+				constexpr size_t lanes = 32 / sizeof(T);
+				size_t i = 0, bits = 0;
+				for (; i + lanes <= n; i += lanes)
+					bits += std::popcount(match_avx2(data + i, value));
+				return bits / sizeof(T) + count_scalar(data + i, n - i, value);
+			}
+
+			template<typename T>
+			CONTAINERS_SIMD_TARGET("avx512f,avx512bw") size_t find_avx512(const T* data, size_t n, T value) noexcept {
+				constexpr size_t lanes = 64 / sizeof(T);
+				size_t i = 0;
+				for (; i + 2 * lanes <= n; i += 2 * lanes) {
+					uint64_t m0 = match_avx512(data + i, value);
+					uint64_t m1 = match_avx512(data + i + lanes, value);
+					if (m0 | m1) {
+						if (m0) return i + std::countr_zero(m0);
+						return i + lanes + std::countr_zero(m1);
+					}
+				}
+				for (; i + lanes <= n; i += lanes) {
+					if (uint64_t mask = match_avx512(data + i, value))
+						return i + std::countr_zero(mask);
+				}
+				return i + find_scalar(data + i, n - i, value);
+			}
+
+			template<typename T>
+			CONTAINERS_SIMD_TARGET("avx512f,avx512bw") size_t count_avx512(const T* data, size_t n, T value) noexcept {
+				constexpr size_t lanes = 64 / sizeof(T);
+				size_t i = 0, count = 0;
+				for (; i + lanes <= n; i += lanes)
+					count += std::popcount(match_avx512(data + i, value));
+				return count + count_scalar(data + i, n - i, value);
+			}
+#endif
+		}
+
+		// Index of the first element equal to value, or n when there is none
+		template<typename T>
+		size_t find(const T* data, size_t n, const T& value) noexcept {
+			static_assert(is_searchable_v<T>, "simd::find needs an integral, float or double element type");
+#if CONTAINERS_SIMD_X86
+			switch (active_isa()) {
+			case Isa::AVX512: return detail::find_avx512(data, n, value);
+			case Isa::AVX2: return detail::find_avx2(data, n, value);
+			case Isa::SSE2: return detail::find_sse2(data, n, value);
+			default: break;
+			}
+#endif
+			return detail::find_scalar(data, n, value);
+		}
+
+		template<typename T>
+		size_t count(const T* data, size_t n, const T& value) noexcept {
+			static_assert(is_searchable_v<T>, "simd::count needs an integral, float or double element type");
+#if CONTAINERS_SIMD_X86
+			switch (active_isa()) {
+			case Isa::AVX512: return detail::count_avx512(data, n, value);
+			case Isa::AVX2: return detail::count_avx2(data, n, value);
+			case Isa::SSE2: return detail::count_sse2(data, n, value);
+			default: break;
+			}
+#endif
+			return detail::count_scalar(data, n, value);
+		}
+
+		namespace detail {
+			inline size_t popcount_scalar(const uint64_t* data, size_t n) noexcept {
+				size_t count = 0;
+				for (size_t i = 0; i < n; ++i)
+					count += std::popcount(data[i]);
+				return count;
+			}
+
+#if CONTAINERS_SIMD_X86
+			// Nibble lookup through pshufb, summed per 64-bit lane with psadbw
+
+			CONTAINERS_SIMD_TARGET("avx2") inline size_t popcount_avx2(const uint64_t* data, size_t n) noexcept {
+				const __m256i lookup = _mm256_setr_epi8(
+					0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+					0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+				const __m256i nibble = _mm256_set1_epi8(0x0f);
+				__m256i total = _mm256_setzero_si256();
+				size_t i = 0;
+				for (; i + 4 <= n; i += 4) {
+					__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+					__m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, nibble));
+					__m256i hi = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+					total = _mm256_add_epi64(total, _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256()));
+				}
+				alignas(32) uint64_t lanes[4];
+				_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), total);
+				return lanes[0] + lanes[1] + lanes[2] + lanes[3] + popcount_scalar(data + i, n - i);
+			}
+
+			CONTAINERS_SIMD_TARGET("avx512f,avx512bw") inline size_t popcount_avx512(const uint64_t* data, size_t n) noexcept {
+				const __m512i lookup = _mm512_broadcast_i32x4(_mm_setr_epi8(
+					0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4));
+				const __m512i nibble = _mm512_set1_epi8(0x0f);
+				__m512i total = _mm512_setzero_si512();
+				size_t i = 0;
+				for (; i + 8 <= n; i += 8) {
+					__m512i v = _mm512_loadu_si512(data + i);
+					__m512i lo = _mm512_shuffle_epi8(lookup, _mm512_and_si512(v, nibble));
+					__m512i hi = _mm512_shuffle_epi8(lookup, _mm512_and_si512(_mm512_srli_epi16(v, 4), nibble));
+					total = _mm512_add_epi64(total, _mm512_sad_epu8(_mm512_add_epi8(lo, hi), _mm512_setzero_si512()));
+				}
+				return static_cast<size_t>(_mm512_reduce_add_epi64(total)) + popcount_scalar(data + i, n - i);
+			}
+#endif
+		}
+
+		// Number of set bits in n words
+		inline size_t popcount(const uint64_t* data, size_t n) noexcept {
+#if CONTAINERS_SIMD_X86
+			switch (active_isa()) {
+			case Isa::AVX512: return detail::popcount_avx512(data, n);
+			case Isa::AVX2: return detail::popcount_avx2(data, n);
+			default: break;
+			}
+#endif
+			return detail::popcount_scalar(data, n);
+		}
+
+		namespace detail {
+			// Fields [first, n) of the stream into out[first, n)
+			inline void unpack_bits_scalar(const uint64_t* words, size_t first, size_t n, unsigned width, uint64_t* out) noexcept {
+				if (!width) {
+					for (size_t i = first; i < n; ++i) out[i] = 0;
+					return;
+				}
+				uint64_t mask = width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+				for (size_t i = first, bit = first * width; i < n; ++i, bit += width) {
+					size_t word = bit / 64, shift = bit % 64;
+					uint64_t value = words[word] >> shift;
+					if (shift + width > 64) value |= words[word + 1] << (64 - shift);
+					out[i] = value & mask;
+				}
+			}
+
+#if CONTAINERS_SIMD_X86
+			// Each lane fetches the word holding its field and the next one; variable shifts of
+			// 64 or more yield zero, so a field that does not straddle drops the second word
+
+			CONTAINERS_SIMD_TARGET("avx2") inline void unpack_bits_avx2(const uint64_t* words, size_t n, unsigned width, uint64_t* out) noexcept {
+				if (!width) return unpack_bits_scalar(words, 0, n, width, out);
+				const long long* base = reinterpret_cast<const long long*>(words);
+				const __m256i mask = _mm256_set1_epi64x(width == 64 ? -1 : static_cast<long long>((uint64_t(1) << width) - 1));
+				const __m256i step = _mm256_set1_epi64x(4 * width);
+				const __m256i low_bits = _mm256_set1_epi64x(63);
+				const __m256i word_bits = _mm256_set1_epi64x(64);
+				const __m256i one = _mm256_set1_epi64x(1);
+				__m256i bits = _mm256_setr_epi64x(0, width, 2 * width, 3 * width);
+				size_t i = 0;
+				for (; i + 4 <= n; i += 4) {
+					__m256i index = _mm256_srli_epi64(bits, 6);
+					__m256i shift = _mm256_and_si256(bits, low_bits);
+					__m256i lo = _mm256_i64gather_epi64(base, index, 8);
+					__m256i hi = _mm256_i64gather_epi64(base, _mm256_add_epi64(index, one), 8);
+					__m256i value = _mm256_or_si256(_mm256_srlv_epi64(lo, shift), _mm256_sllv_epi64(hi, _mm256_sub_epi64(word_bits, shift)));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_and_si256(value, mask));
+					bits = _mm256_add_epi64(bits, step);
+				}
+				unpack_bits_scalar(words, i, n, width, out);
+			}
+
+			// A group of eight fields spans at most nine words, so instead of gathering, the words
+			// are fetched with two masked loads and the fields picked out with permutes
+			CONTAINERS_SIMD_TARGET("avx512f") inline void unpack_bits_avx512(const uint64_t* words, size_t n, unsigned width, uint64_t* out) noexcept {
+				if (!width) return unpack_bits_scalar(words, 0, n, width, out);
+				const __m512i mask = _mm512_set1_epi64(width == 64 ? -1 : static_cast<long long>((uint64_t(1) << width) - 1));
+				const __m512i lanes = _mm512_setr_epi64(0, width, 2 * width, 3 * width, 4 * width, 5 * width, 6 * width, 7 * width);
+				const __m512i low_bits = _mm512_set1_epi64(63);
+				const __m512i word_bits = _mm512_set1_epi64(64);
+				const __m512i one = _mm512_set1_epi64(1);
+				size_t i = 0;
+				for (size_t bit = 0; i + 8 <= n; i += 8, bit += 8 * width) {
+					const uint64_t* group = words + bit / 64;
+					size_t start = bit % 64;
+					unsigned span = static_cast<unsigned>((start + 8 * width + 63) / 64);
+					__m512i a = _mm512_maskz_loadu_epi64(static_cast<__mmask8>(span >= 8 ? 0xff : (1u << span) - 1), group);
+					__m512i b = _mm512_maskz_loadu_epi64(static_cast<__mmask8>(span > 8 ? 1 : 0), group + 8);
+					__m512i bits = _mm512_add_epi64(lanes, _mm512_set1_epi64(static_cast<long long>(start)));
+					__m512i index = _mm512_srli_epi64(bits, 6);
+					__m512i shift = _mm512_and_si512(bits, low_bits);
+					__m512i lo = _mm512_permutex2var_epi64(a, index, b);
+					__m512i hi = _mm512_permutex2var_epi64(a, _mm512_add_epi64(index, one), b);
+					__m512i value = _mm512_or_si512(_mm512_srlv_epi64(lo, shift), _mm512_sllv_epi64(hi, _mm512_sub_epi64(word_bits, shift)));
+					_mm512_storeu_si512(out + i, _mm512_and_si512(value, mask));
+				}
+				unpack_bits_scalar(words, i, n, width, out);
+			}
+#endif
+		}
+
+		// Splits a stream of width-bit fields, packed from the lowest bit of words[0] upward,
+		// into n values. words must hold one readable word past the last field.
+		inline void unpack_bits(const uint64_t* words, size_t n, unsigned width, uint64_t* out) noexcept {
+#if CONTAINERS_SIMD_X86
+			switch (active_isa()) {
+			case Isa::AVX512: return detail::unpack_bits_avx512(words, n, width, out);
+			case Isa::AVX2: return detail::unpack_bits_avx2(words, n, width, out);
+			default: break;
+			}
+#endif
+			detail::unpack_bits_scalar(words, 0, n, width, out);
+		}
+
+		// Requests the cache line holding address ahead of a load
+		inline void prefetch(const void* address) noexcept {
+#if CONTAINERS_SIMD_X86
+			_mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#elif defined(__GNUC__) || defined(__clang__)
+			__builtin_prefetch(address);
+#endif
+		}
+
+		namespace detail {
+			// Number of the 64 / sizeof(T) keys of a node that are less than value, or not
+			// greater than it when Inclusive
+			template<bool Inclusive, typename T>
+			struct RankScalar {
+				size_t operator()(const T* node, T value) const noexcept {
+					size_t rank = 0;
+					for (size_t i = 0; i < 64 / sizeof(T); ++i)
+						rank += Inclusive ? node[i] <= value : node[i] < value;
+					return rank;
+				}
+			};
+
+#if CONTAINERS_SIMD_X86
+			// AVX2 has only signed greater-than; unsigned keys are compared with their top bits
+			// flipped, and a node is ranked in two 32-byte halves
+
+			template<bool Inclusive, typename T>
+			struct RankAvx2 {
+				CONTAINERS_SIMD_TARGET("avx2") size_t operator()(const T* node, T value) const noexcept {
+					constexpr size_t lanes = 32 / sizeof(T);
+					size_t bits = 0;
+					for (size_t half = 0; half < 2; ++half) {
+						const T* keys = node + half * lanes;
+						uint32_t mask;
+						if constexpr (std::is_same_v<T, float>) {
+							__m256 cmp = _mm256_cmp_ps(_mm256_loadu_ps(keys), _mm256_set1_ps(value), Inclusive ? _CMP_LE_OQ : _CMP_LT_OQ);
+							mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_castps_si256(cmp)));
+						}
+						else if constexpr (std::is_same_v<T, double>) {
+							__m256d cmp = _mm256_cmp_pd(_mm256_loadu_pd(keys), _mm256_set1_pd(value), Inclusive ? _CMP_LE_OQ : _CMP_LT_OQ);
+							mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_castpd_si256(cmp)));
+						}
+						else {
+							__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys));
+							__m256i probe, flip;
+							if constexpr (sizeof(T) == 1) {
+								probe = _mm256_set1_epi8(static_cast<char>(value));
+								flip = _mm256_set1_epi8(static_cast<char>(0x80));
+							}
+							else if constexpr (sizeof(T) == 2) {
+								probe = _mm256_set1_epi16(static_cast<short>(value));
+								flip = _mm256_set1_epi16(static_cast<short>(0x8000));
+							}
+							else if constexpr (sizeof(T) == 4) {
+								probe = _mm256_set1_epi32(static_cast<int>(value));
+								flip = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+							}
+							else {
+								probe = _mm256_set1_epi64x(static_cast<long long>(value));
+								flip = _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ull));
+							}
+							if constexpr (std::is_unsigned_v<T>) {
+								block = _mm256_xor_si256(block, flip);
+								probe = _mm256_xor_si256(probe, flip);
+							}
+							// keys < value is value > keys; keys <= value is the complement of keys > value
+							__m256i lhs = Inclusive ? block : probe;
+							__m256i rhs = Inclusive ? probe : block;
+							__m256i greater;
+							if constexpr (sizeof(T) == 1) greater = _mm256_cmpgt_epi8(lhs, rhs);
+							else if constexpr (sizeof(T) == 2) greater = _mm256_cmpgt_epi16(lhs, rhs);
+							else if constexpr (sizeof(T) == 4) greater = _mm256_cmpgt_epi32(lhs, rhs);
+							else greater = _mm256_cmpgt_epi64(lhs, rhs);
+							mask = static_cast<uint32_t>(_mm256_movemask_epi8(greater));
+							if constexpr (Inclusive) mask = ~mask;
+						}
+						bits += std::popcount(mask);
+					}
+					return bits / sizeof(T);
+				}
+			};
+
+			template<bool Inclusive, typename T>
+			struct RankAvx512 {
+				CONTAINERS_SIMD_TARGET("avx512f,avx512bw") size_t operator()(const T* node, T value) const noexcept {
+					constexpr int op = Inclusive ? _MM_CMPINT_LE : _MM_CMPINT_LT;
+					uint64_t mask;
+					if constexpr (std::is_same_v<T, float>)
+						mask = _mm512_cmp_ps_mask(_mm512_loadu_ps(node), _mm512_set1_ps(value), Inclusive ? _CMP_LE_OQ : _CMP_LT_OQ);
+					else if constexpr (std::is_same_v<T, double>)
+						mask = _mm512_cmp_pd_mask(_mm512_loadu_pd(node), _mm512_set1_pd(value), Inclusive ? _CMP_LE_OQ : _CMP_LT_OQ);
+					else {
+						__m512i block = _mm512_loadu_si512(node);
+						if constexpr (std::is_signed_v<T>) {
+							if constexpr (sizeof(T) == 1) mask = _mm512_cmp_epi8_mask(block, _mm512_set1_epi8(static_cast<char>(value)), op);
+							else if constexpr (sizeof(T) == 2) mask = _mm512_cmp_epi16_mask(block, _mm512_set1_epi16(static_cast<short>(value)), op);
+							else if constexpr (sizeof(T) == 4) mask = _mm512_cmp_epi32_mask(block, _mm512_set1_epi32(static_cast<int>(value)), op);
+							else mask = _mm512_cmp_epi64_mask(block, _mm512_set1_epi64(static_cast<long long>(value)), op);
+						}
+						else {
+							if constexpr (sizeof(T) == 1) mask = _mm512_cmp_epu8_mask(block, _mm512_set1_epi8(static_cast<char>(value)), op);
+							else if constexpr (sizeof(T) == 2) mask = _mm512_cmp_epu16_mask(block, _mm512_set1_epi16(static_cast<short>(value)), op);
+							else if constexpr (sizeof(T) == 4) mask = _mm512_cmp_epu32_mask(block, _mm512_set1_epi32(static_cast<int>(value)), op);
+							else mask = _mm512_cmp_epu64_mask(block, _mm512_set1_epi64(static_cast<long long>(value)), op);
+						}
+					}
+					return std::popcount(mask);
+				}
+			};
+#endif
+
+			// Searches group values at a time, one tree level per round: while the node a value
+			// needs next is being fetched, the other values in the group are ranked
+			template<typename T, typename Rank>
+			inline void tree_search_with(const T* tree, const size_t* layers, size_t height, size_t size, const T* values, size_t count, size_t* out, Rank rank) noexcept {
+				constexpr size_t fanout = 64 / sizeof(T) + 1;
+				constexpr size_t group = 16;
+				size_t nodes[group];
+				for (size_t first = 0; first < count; first += group) {
+					size_t n = count - first < group ? count - first : group;
+					const T* batch = values + first;
+					for (size_t i = 0; i < n; ++i) nodes[i] = 0;
+					for (size_t level = height - 1; level > 0; --level) {
+						const T* layer = tree + layers[level];
+						const T* below = tree + layers[level - 1];
+						// Separators of missing children are padding, which only a value not below
+						// the padding passes; such values go to the last node, whose rank is size
+						size_t last = (layers[level] - layers[level - 1]) / (fanout - 1) - 1;
+						for (size_t i = 0; i < n; ++i) {
+							size_t child = nodes[i] * fanout + rank(layer + nodes[i] * (fanout - 1), batch[i]);
+							nodes[i] = child < last ? child : last;
+							prefetch(below + nodes[i] * (fanout - 1));
+						}
+					}
+					const T* leaves = tree + layers[0];
+					for (size_t i = 0; i < n; ++i) {
+						size_t position = nodes[i] * (fanout - 1) + rank(leaves + nodes[i] * (fanout - 1), batch[i]);
+						out[first + i] = position < size ? position : size;
+					}
+				}
+			}
+
+#if CONTAINERS_SIMD_X86
+			template<bool Inclusive, typename T>
+			CONTAINERS_SIMD_TARGET("avx2") CONTAINERS_SIMD_FLATTEN void tree_search_avx2(const T* tree, const size_t* layers, size_t height, size_t size, const T* values, size_t count, size_t* out) noexcept {
+				tree_search_with(tree, layers, height, size, values, count, out, RankAvx2<Inclusive, T>());
+			}
+
+			template<bool Inclusive, typename T>
+			CONTAINERS_SIMD_TARGET("avx512f,avx512bw") CONTAINERS_SIMD_FLATTEN void tree_search_avx512(const T* tree, const size_t* layers, size_t height, size_t size, const T* values, size_t count, size_t* out) noexcept {
+				tree_search_with(tree, layers, height, size, values, count, out, RankAvx512<Inclusive, T>());
+			}
+#endif
+		}
+
+		// Rank of each of count values among the size sorted keys of a static B+ tree (as
+		// SortedIndex lays it out): the number of keys less than the value, or not greater
+		// than it when Inclusive. Every node holds B = 64 / sizeof(T) keys; node k of layer h
+		// has children (B + 1) k ... (B + 1) k + B in layer h - 1, and a separator is the first
+		// key of the subtree right of it. Layer 0 is the keys themselves, padded to whole
+		// nodes; layer height - 1 is the root; layers[h] is where layer h starts in tree and
+		// layers[height] where the tree ends. Padding must be no less than any key.
+		template<bool Inclusive, typename T>
+		void tree_search(const T* tree, const size_t* layers, size_t height, size_t size, const T* values, size_t count, size_t* out) noexcept {
+			static_assert(is_searchable_v<T>, "simd::tree_search needs an integral, float or double element type");
+#if CONTAINERS_SIMD_X86
+			switch (active_isa()) {
+			case Isa::AVX512: return detail::tree_search_avx512<Inclusive>(tree, layers, height, size, values, count, out);
+			case Isa::AVX2: return detail::tree_search_avx2<Inclusive>(tree, layers, height, size, values, count, out);
+			default: break;
+			}
+#endif
+			detail::tree_search_with(tree, layers, height, size, values, count, out, detail::RankScalar<Inclusive, T>());
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,319 @@
+#pragma once
+#include <algorithm>
+#include <initializer_list>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include "exception.h"
+#include "expression.h"
+#include "policy.h"
+#include "relocate.h"
+#include "vector_base.h"
+
+namespace Containers {
+
+	// A Vector that keeps up to N elements in storage inside the object and only goes to
+	// the allocator once it grows past that. Elements are contiguous either way, so
+	// everything but the storage handling is VectorBase's.
+	template<typename T, size_t N, typename Growth = DefaultGrowth, typename Allocator = std::allocator<T>>
+	class SmallVector : public VectorBase<SmallVector<T, N, Growth, Allocator>, T, VectorStorage<T, Growth, Allocator>> {
+		static_assert(N > 0, "SmallVector needs room for at least one inline element");
+		using Base = VectorBase<SmallVector<T, N, Growth, Allocator>, T, VectorStorage<T, Growth, Allocator>>;
+		using AllocTraits = std::allocator_traits<Allocator>;
+	public:
+		using typename Base::Iterator;
+
+		static constexpr size_t inline_capacity = N;
+
+		SmallVector() noexcept;
+
+		explicit SmallVector(const Allocator&) noexcept;
+
+		explicit SmallVector(size_t, const Allocator& = Allocator());
+
+		SmallVector(size_t, const T&, const Allocator& = Allocator());
+
+		template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
+		SmallVector(IT, IT, const Allocator& = Allocator());
+
+		SmallVector(const SmallVector&);
+
+		SmallVector(const SmallVector&, const Allocator&);
+
+		SmallVector(SmallVector&&) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+		SmallVector(SmallVector&&, const Allocator&);
+
+		SmallVector(std::initializer_list<T>, const Allocator& = Allocator());
+
+		~SmallVector();
+
+		SmallVector& operator=(const SmallVector&);
+
+		SmallVector& operator=(SmallVector&&) noexcept(
+			std::is_nothrow_move_constructible_v<T> &&
+			(AllocTraits::propagate_on_container_move_assignment::value ||
+			AllocTraits::is_always_equal::value));
+
+		SmallVector& operator=(std::initializer_list<T>);
+
+		// Capacity
+		void reserve(size_t);
+
+		void shrink_to_fit();
+
+		bool is_inline() const noexcept;
+
+		// Modifiers
+		void swap(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+	private:
+		friend Base;
+
+		static constexpr const char* name = "SmallVector";
+
+		using Base::m_allocator;
+		using Base::m_data;
+		using Base::m_size;
+		using Base::m_capacity;
+		using Base::construct;
+		using Base::construct_n;
+		using Base::destroy;
+
+		alignas(T) unsigned char m_inline[N * sizeof(T)];
+
+		T* inline_data() noexcept;
+
+		const T* inline_data() const noexcept;
+
+		T* allocate(size_t);
+
+		void deallocate(T*, size_t) noexcept;
+
+		void reallocate(size_t);
+
+		void release() noexcept;
+
+		void steal(SmallVector&) noexcept(std::is_nothrow_move_constructible_v<T>);
+	};
+
+	template<typename T, size_t N, typename Growth, typename Allocator>
+	SmallVector<T, N, Growth, Allocator>::SmallVector() noexcept : SmallVector(Allocator()) {}
+
+	template<typename T, size_t N, typename Growth, typename Allocator>
+	SmallVector<T, N, Growth, Allocator>::SmallVector(const Allocator& allocator) noexcept : Base(allocator) {
+		m_data = inline_data();
+		m_capacity = N;
+	}
+
+	// The sized and range constructors delegate first, so the destructor cleans up
+	// whatever was built if an element constructor throws
+	template<typename T, size_t N, typename Growth, typename Allocator>
+	SmallVector<T, N, Growth, Allocator>::SmallVector(size_t size, const Allocator& allocator) :
+		SmallVector(allocator) {
+		reserve(size);
+		construct_n(m_data, size);
+		m_size = size;
+	}
+
+	template<typename T, size_t N, typename Growth, typename Allocator>
+	SmallVector<T, N, Growth, Allocator>::SmallVector(size_t size, const T& init_val, const Allocator& allocator) :
+		SmallVector(allocator) {
+		reserve(size);
+		construct_n(m_data, size, init_val);
+		m_size = size;
+	}
+
+	template<typename T, size_t N, typename Growth, typename Allocator>
+	template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
+	SmallVector<T, N, Growth, Allocator>::SmallVector(IT first, IT last, const Allocator& allocator) :
+		SmallVector(allocator) {
+		reserve(last - first);
+		for (; first != last; ++first, ++m_size)
+			construct(m_data + m_size, *first);
+	}
+
+	template<typename T, size_t N, typename Growth, typename Allocator>
+	SmallVector<T, N, Growth, Allocator>::SmallVector(const SmallVector& other) :
+		SmallVector(other, AllocTraits::select_on_container_copy_construction(other.m_allocator)) {}
+
+	template<typename T, size_t N, typename Growth, typename Allocator>
+	SmallVector<T, N, Growth, Allocator>::SmallVector(const SmallVector& other, const Allocator& allocator) :
+		SmallVector(other.begin(), other.end(), allocator) {}
+
+	template<typename T, size_t N, typename Growth, typename Allocator>
+	SmallVector<T, N, Growth, Allocator>::SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) :
+		SmallVector(other.m_allocator) {
+		steal(other);
+	}
+
+	template<typename T, size_t N, typename Growth, typename Allocator>
+	SmallVector<T, N, Growth, Allocator>::SmallVector(SmallVector&& other, const Allocator& allocator) :
+		SmallVector(allocator) {
+		if (m_allocator == other.m_allocator) {
+			steal(other);
+			return;
+		}
+		// storage from another resource cannot be adopted, so move element-wise
+		reserve(other.m_size);
+		for (; m_size < other.m_size; ++m_size)
+			construct(m_data + m_size, std::move(other.m_data[m_size]));
+	}
+
+	template<typename T, size_t N, typename Growth, typename Allocator>
+	SmallVector<T, N, Growth, Allocator>::SmallVector(std::initializer_list<T> il, const Allocator& allocator) :
+		SmallVector(il.begin(), il.end(), allocator) {}
+
+	template<typename T, size_t N, typename Growth, typename Allocator>
+	SmallVector<T, N, Growth, Allocator>::~SmallVector() {
+		release();
+	}
+
+	template<typename T, size_t N, typename Growth, typename Allocator>
+	SmallVector<T, N, Growth, Allocator>& SmallVector<T, N, Growth, Allocator>::operator=(const SmallVector& other) {
+		if (this == &other) return *this;
+		constexpr bool propagate = AllocTraits::propagate_on_container_copy_assignment::value;
+		SmallVector temp(other, propagate ? other.m_allocator : m_allocator);
+		release();
+		if constexpr (propagate) m_allocator = temp.m_allocator;
+		steal(temp);
+		return *this;
+	}
+
+	template<typename T, size_t N, typename Growth, typename Allocator>
+	SmallVector<T, N, Growth, Allocator>& SmallVector<T, N, Growth, Allocator>::operator=(SmallVector&& other) noexcept(
+		std::is_nothrow_move_constructible_v<T> &&
+		(AllocTraits::propagate_on_container_move_assignment::value ||
+		AllocTraits::is_always_equal::value)) {
+		if (this == &other) return *this;
+		constexpr bool propagate = AllocTraits::propagate_on_container_move_assignment::value;
+		SmallVector temp(std::move(other), propagate ? other.m_allocator : m_allocator);
+		release();
+		if constexpr (propagate) m_allocator = temp.m_allocator;
+		steal(temp);
+		return *this;
+	}
+
+	template<typename T, size_t N, typename Growth, typename Allocator>
+	SmallVector<T, N, Growth, Allocator>& SmallVector<T, N, Growth, Allocator>::operator=(std::initializer_list<T> il) {
+		SmallVector temp(il, m_allocator);
+		release();
+		steal(temp);
+		return *this;
+	}
+
+	// Capacity
+	template<typename T, size_t N, typename Growth, typename Allocator>
+	void SmallVector<T, N, Growth, Allocator>::reserve(size_t capacity) {
+		if (capacity <= m_capacity) return;
+		reallocate(capacity);
+	}
+
+	// Moves a spilled vector back inline once it fits again, otherwise trims the heap buffer
+	template<typename T, size_t N, typename Growth, typename Allocator>
+	void SmallVector<T, N, Growth, Allocator>::shrink_to_fit() {
+		if (is_inline() || m_size == m_capacity) return;
+		reallocate(m_size);
+	}
+
+	template<typename T, size_t N, typename Growth, typename Allocator>
+	bool SmallVector<T, N, Growth, Allocator>::is_inline() const noexcept {
+		return m_data == inline_data();
+	}
+
+	// Modifiers
+	// Heap buffers are exchanged by pointer; inline elements have to be moved across
+	template<typename T, size_t N, typename Growth, typename Allocator>
+	void SmallVector<T, N, Growth, Allocator>::swap(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+		constexpr bool propagate = AllocTraits::propagate_on_container_swap::value;
+		if (!is_inline() && !other.is_inline()) {
+			std::swap(m_size, other.m_size);
+			std::swap(m_capacity, other.m_capacity);
+			std::swap(m_data, other.m_data);
+			if constexpr (propagate) std::swap(m_allocator, other.m_allocator);
+			return;
+		}
+		SmallVector temp(std::move(other));
+		other.release();
+		if constexpr (propagate) other.m_allocator = m_allocator;
+		other.steal(*this);
+		release();
+		if constexpr (propagate) m_allocator = temp.m_allocator;
+		steal(temp);
+	}
+
+	// Private Members
+	template<typename T, size_t N, typename Growth, typename Allocator>
+	T* SmallVector<T, N, Growth, Allocator>::inline_data() noexcept {
+		return reinterpret_cast<T*>(m_inline);
+	}
+
+	template<typename T, size_t N, typename Growth, typename Allocator>
+	const T* SmallVector<T, N, Growth, Allocator>::inline_data() const noexcept {
+		return reinterpret_cast<const T*>(m_inline);
+	}
+
+	template<typename T, size_t N, typename Growth, typename Allocator>
+	T* SmallVector<T, N, Growth, Allocator>::allocate(size_t size) {
+		return AllocTraits::allocate(m_allocator, size);
+	}
+
+	template<typename T, size_t N, typename Growth, typename Allocator>
+	void SmallVector<T, N, Growth, Allocator>::deallocate(T* data, size_t size) noexcept {
+		if (data != inline_data()) AllocTraits::deallocate(m_allocator, data, size);
+	}
+
+	// Relocates the elements into a buffer of the given capacity, which is the inline
+	// storage when it is large enough
+	template<typename T, size_t N, typename Growth, typename Allocator>
+	void SmallVector<T, N, Growth, Allocator>::reallocate(size_t capacity) {
+		capacity = std::max(capacity, N);
+		T* new_data = capacity == N ? inline_data() : allocate(capacity);
+		try {
+			relocate(m_allocator, m_data, m_size, new_data);
+		}
+		catch (...) {
+			deallocate(new_data, capacity);
+			throw;
+		}
+
+		std::swap(m_capacity, capacity);
+		std::swap(m_data, new_data);
+
+		deallocate(new_data, capacity);
+	}
+
+	// Destroys the elements and returns to empty inline storage
+	template<typename T, size_t N, typename Growth, typename Allocator>
+	void SmallVector<T, N, Growth, Allocator>::release() noexcept {
+		destroy(m_data, m_data + m_size);
+		deallocate(m_data, m_capacity);
+		m_data = inline_data();
+		m_size = 0;
+		m_capacity = N;
+	}
+
+	// Takes other's elements into this empty, inline vector: a heap buffer is adopted as
+	// is, inline elements are relocated. Both must share an allocator.
+	template<typename T, size_t N, typename Growth, typename Allocator>
+	void SmallVector<T, N, Growth, Allocator>::steal(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+		if (other.is_inline()) {
+			relocate(m_allocator, other.m_data, other.m_size, m_data);
+			m_size = std::exchange(other.m_size, 0);
+		}
+		else {
+			m_data = std::exchange(other.m_data, other.inline_data());
+			m_size = std::exchange(other.m_size, 0);
+			m_capacity = std::exchange(other.m_capacity, N);
+		}
+	}
+
+	template<typename T, size_t N, typename Growth, typename Allocator>
+	struct is_numeric_container<SmallVector<T, N, Growth, Allocator>> : std::is_arithmetic<T> {};
+
+	namespace pmr {
+		template<typename T, size_t N, typename Growth = DefaultGrowth>
+		using SmallVector = Containers::SmallVector<T, N, Growth, std::pmr::polymorphic_allocator<T>>;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,672 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "exception.h"
+#include "policy.h"
+#include "relocate.h"
+
+namespace Containers {
+
+	// Structure-of-arrays vector
+	// Row i is (std::get<0>(columns)[i], std::get<1>(columns)[i], ...): each field lives in
+	// its own contiguous array, so a loop over one field streams only that field's bytes
+	// and vectorizes like a loop over a plain array. All columns share one allocation and
+	// each starts on a 64-byte boundary. Rows are accessed through tuples of references,
+	// e.g. auto [id, price] = soa[i], and whole columns through column<I>().
+	template<typename...Ts>
+	class SoAVector {
+		static_assert(sizeof...(Ts) > 0, "SoAVector needs at least one column");
+
+	public:
+		using value_type = std::tuple<Ts...>;
+
+		using Reference = std::tuple<Ts&...>;
+
+		using ConstReference = std::tuple<const Ts&...>;
+
+		template<size_t I>
+		using Column = std::tuple_element_t<I, value_type>;
+
+		static constexpr size_t column_count = sizeof...(Ts);
+
+		static constexpr size_t column_alignment = std::max({ size_t(64), alignof(Ts)... });
+
+		class Iterator;
+
+		SoAVector() noexcept;
+
+		explicit SoAVector(size_t);
+
+		SoAVector(size_t, const Ts&...);
+
+		SoAVector(const SoAVector&);
+
+		SoAVector(SoAVector&&) noexcept;
+
+		~SoAVector();
+
+		SoAVector& operator=(const SoAVector&);
+
+		SoAVector& operator=(SoAVector&&) noexcept;
+
+		// Element Access
+		Reference at(size_t);
+
+		ConstReference at(size_t) const;
+
+		Reference operator[](size_t);
+
+		ConstReference operator[](size_t) const;
+
+		Reference front();
+
+		ConstReference front() const;
+
+		Reference back();
+
+		ConstReference back() const;
+
+		template<size_t I>
+		std::span<Column<I>> column() noexcept;
+
+		template<size_t I>
+		std::span<const Column<I>> column() const noexcept;
+
+		template<size_t I>
+		Column<I>* data() noexcept;
+
+		template<size_t I>
+		const Column<I>* data() const noexcept;
+
+		// Capacity
+		bool empty() const noexcept;
+
+		size_t size() const noexcept;
+
+		void reserve(size_t);
+
+		size_t capacity() const noexcept;
+
+		void shrink_to_fit();
+
+		// Iterators
+		Iterator begin() noexcept;
+
+		const Iterator begin() const noexcept;
+
+		Iterator end() noexcept;
+
+		const Iterator end() const noexcept;
+
+		// Modifiers
+		void clear() noexcept;
+
+		void push_back(const Ts&...);
+
+		void push_back(const value_type&);
+
+		// Takes one argument per column, each constructing that column's field
+		template<typename...Args>
+		void emplace_back(Args&&...);
+
+		Iterator erase(const Iterator);
+
+		Iterator erase(const Iterator, const Iterator);
+
+		void pop_back();
+
+		void resize(size_t);
+
+		void resize(size_t, const Ts&...);
+
+		void swap(SoAVector&) noexcept;
+
+	private:
+		using Columns = std::tuple<Ts*...>;
+
+		template<typename T>
+		static constexpr bool copies_on_relocate =
+			!is_trivially_relocatable_v<T> && !std::is_nothrow_move_constructible_v<T> && std::is_copy_constructible_v<T>;
+
+		std::byte* m_block;
+		Columns m_columns;
+		size_t m_size;
+		size_t m_capacity;
+
+		template<typename F>
+		static void for_each_column(F&&);
+
+		static std::byte* allocate(size_t, Columns&);
+
+		static void deallocate(std::byte*) noexcept;
+
+		template<typename F>
+		void build_columns(size_t, size_t, F);
+
+		void destroy(size_t, size_t) noexcept;
+
+		void reallocate(size_t);
+
+		size_t grow_capacity(size_t) const noexcept;
+
+		template<size_t...I>
+		Reference row(size_t, std::index_sequence<I...>) const noexcept;
+	};
+
+	// Rows are addressed by index, so the iterator stays a cheap (vector, index) pair and
+	// dereferences to a tuple of references
+	template<typename...Ts>
+	class SoAVector<Ts...>::Iterator {
+	public:
+		Iterator() : m_vector(nullptr), m_index(0) {}
+
+		Iterator(const SoAVector* vector, size_t index) : m_vector(vector), m_index(index) {}
+
+		Iterator(const Iterator& other) : m_vector(other.m_vector), m_index(other.m_index) {}
+
+		Iterator& operator=(const Iterator&) = default;
+
+		bool operator==(const Iterator&) const;
+
+		bool operator!=(const Iterator&) const;
+
+		Iterator& operator++();
+
+		Iterator operator++(int);
+
+		Iterator operator+(int) const;
+
+		Iterator& operator+=(int);
+
+		Iterator& operator--();
+
+		Iterator operator--(int);
+
+		Iterator operator-(int) const;
+
+		Iterator& operator-=(int);
+
+		size_t operator-(const Iterator&) const;
+
+		Reference operator*() const;
+
+		size_t index() const noexcept;
+
+	private:
+		const SoAVector* m_vector;
+		size_t m_index;
+	};
+
+	template<typename...Ts>
+	bool SoAVector<Ts...>::Iterator::operator==(const Iterator& other) const {
+		return m_index == other.m_index;
+	}
+
+	template<typename...Ts>
+	bool SoAVector<Ts...>::Iterator::operator!=(const Iterator& other) const {
+		return m_index != other.m_index;
+	}
+
+	template<typename...Ts>
+	typename SoAVector<Ts...>::Iterator& SoAVector<Ts...>::Iterator::operator++() {
+		++m_index;
+		return *this;
+	}
+
+	template<typename...Ts>
+	typename SoAVector<Ts...>::Iterator SoAVector<Ts...>::Iterator::operator++(int) {
+		Iterator it = *this;
+		++(*this);
+		return it;
+	}
+
+	template<typename...Ts>
+	typename SoAVector<Ts...>::Iterator SoAVector<Ts...>::Iterator::operator+(int steps) const {
+		Iterator it = *this;
+		it.m_index += steps;
+		return it;
+	}
+
+	template<typename...Ts>
+	typename SoAVector<Ts...>::Iterator& SoAVector<Ts...>::Iterator::operator+=(int steps) {
+		m_index += steps;
+		return *this;
+	}
+
+	template<typename...Ts>
+	typename SoAVector<Ts...>::Iterator& SoAVector<Ts...>::Iterator::operator--() {
+		--m_index;
+		return *this;
+	}
+
+	template<typename...Ts>
+	typename SoAVector<Ts...>::Iterator SoAVector<Ts...>::Iterator::operator--(int) {
+		Iterator it = *this;
+		--(*this);
+		return it;
+	}
+
+	template<typename...Ts>
+	typename SoAVector<Ts...>::Iterator SoAVector<Ts...>::Iterator::operator-(int steps) const {
+		Iterator it = *this;
+		it.m_index -= steps;
+		return it;
+	}
+
+	template<typename...Ts>
+	typename SoAVector<Ts...>::Iterator& SoAVector<Ts...>::Iterator::operator-=(int steps) {
+		m_index -= steps;
+		return *this;
+	}
+
+	template<typename...Ts>
+	size_t SoAVector<Ts...>::Iterator::operator-(const Iterator& other) const {
+		return m_index - other.m_index;
+	}
+
+	template<typename...Ts>
+	typename SoAVector<Ts...>::Reference SoAVector<Ts...>::Iterator::operator*() const {
+		return m_vector->row(m_index, std::index_sequence_for<Ts...>());
+	}
+
+	template<typename...Ts>
+	size_t SoAVector<Ts...>::Iterator::index() const noexcept {
+		return m_index;
+	}
+
+	// Constructors
+	template<typename...Ts>
+	SoAVector<Ts...>::SoAVector() noexcept : m_block(nullptr), m_columns(), m_size(0), m_capacity(0) {}
+
+	template<typename...Ts>
+	SoAVector<Ts...>::SoAVector(size_t size) : SoAVector() {
+		resize(size);
+	}
+
+	template<typename...Ts>
+	SoAVector<Ts...>::SoAVector(size_t size, const Ts&...values) : SoAVector() {
+		resize(size, values...);
+	}
+
+	template<typename...Ts>
+	SoAVector<Ts...>::SoAVector(const SoAVector& other) : SoAVector() {
+		reserve(other.m_size);
+		build_columns(0, other.m_size, [&](auto column) {
+			constexpr size_t I = decltype(column)::value;
+			std::uninitialized_copy_n(std::get<I>(other.m_columns), other.m_size, std::get<I>(m_columns));
+		});
+		m_size = other.m_size;
+	}
+
+	template<typename...Ts>
+	SoAVector<Ts...>::SoAVector(SoAVector&& other) noexcept : SoAVector() {
+		swap(other);
+	}
+
+	template<typename...Ts>
+	SoAVector<Ts...>::~SoAVector() {
+		destroy(0, m_size);
+		deallocate(m_block);
+	}
+
+	template<typename...Ts>
+	SoAVector<Ts...>& SoAVector<Ts...>::operator=(const SoAVector& other) {
+		if (this == &other) return *this;
+		SoAVector temp(other);
+		swap(temp);
+		return *this;
+	}
+
+	template<typename...Ts>
+	SoAVector<Ts...>& SoAVector<Ts...>::operator=(SoAVector&& other) noexcept {
+		if (this == &other) return *this;
+		SoAVector temp(std::move(other));
+		swap(temp);
+		return *this;
+	}
+
+	// Element Access
+	template<typename...Ts>
+	typename SoAVector<Ts...>::Reference SoAVector<Ts...>::at(size_t pos) {
+		if (pos >= m_size) throw OutOfRangeException("SoAVector");
+		return (*this)[pos];
+	}
+
+	template<typename...Ts>
+	typename SoAVector<Ts...>::ConstReference SoAVector<Ts...>::at(size_t pos) const {
+		if (pos >= m_size) throw OutOfRangeException("SoAVector");
+		return (*this)[pos];
+	}
+
+	template<typename...Ts>
+	typename SoAVector<Ts...>::Reference SoAVector<Ts...>::operator[](size_t pos) {
+		return row(pos, std::index_sequence_for<Ts...>());
+	}
+
+	template<typename...Ts>
+	typename SoAVector<Ts...>::ConstReference SoAVector<Ts...>::operator[](size_t pos) const {
+		return row(pos, std::index_sequence_for<Ts...>());
+	}
+
+	template<typename...Ts>
+	typename SoAVector<Ts...>::Reference SoAVector<Ts...>::front() {
+		if (!m_size) throw OutOfRangeException("SoAVector");
+		return (*this)[0];
+	}
+
+	template<typename...Ts>
+	typename SoAVector<Ts...>::ConstReference SoAVector<Ts...>::front() const {
+		if (!m_size) throw OutOfRangeException("SoAVector");
+		return (*this)[0];
+	}
+
+	template<typename...Ts>
+	typename SoAVector<Ts...>::Reference SoAVector<Ts...>::back() {
+		if (!m_size) throw OutOfRangeException("SoAVector");
+		return (*this)[m_size - 1];
+	}
+
+	template<typename...Ts>
+	typename SoAVector<Ts...>::ConstReference SoAVector<Ts...>::back() const {
+		if (!m_size) throw OutOfRangeException("SoAVector");
+		return (*this)[m_size - 1];
+	}
+
+	template<typename...Ts>
+	template<size_t I>
+	std::span<typename SoAVector<Ts...>::template Column<I>> SoAVector<Ts...>::column() noexcept {
+		return { std::get<I>(m_columns), m_size };
+	}
+
+	template<typename...Ts>
+	template<size_t I>
+	std::span<const typename SoAVector<Ts...>::template Column<I>> SoAVector<Ts...>::column() const noexcept {
+		return { std::get<I>(m_columns), m_size };
+	}
+
+	template<typename...Ts>
+	template<size_t I>
+	typename SoAVector<Ts...>::template Column<I>* SoAVector<Ts...>::data() noexcept {
+		return std::get<I>(m_columns);
+	}
+
+	template<typename...Ts>
+	template<size_t I>
+	const typename SoAVector<Ts...>::template Column<I>* SoAVector<Ts...>::data() const noexcept {
+		return std::get<I>(m_columns);
+	}
+
+	// Capacity
+	template<typename...Ts>
+	bool SoAVector<Ts...>::empty() const noexcept { return m_size == 0; }
+
+	template<typename...Ts>
+	size_t SoAVector<Ts...>::size() const noexcept { return m_size; }
+
+	template<typename...Ts>
+	void SoAVector<Ts...>::reserve(size_t capacity) {
+		if (capacity > m_capacity) reallocate(capacity);
+	}
+
+	template<typename...Ts>
+	size_t SoAVector<Ts...>::capacity() const noexcept { return m_capacity; }
+
+	template<typename...Ts>
+	void SoAVector<Ts...>::shrink_to_fit() {
+		if (m_size != m_capacity) reallocate(m_size);
+	}
+
+	// Iterators
+	template<typename...Ts>
+	typename SoAVector<Ts...>::Iterator SoAVector<Ts...>::begin() noexcept {
+		return Iterator(this, 0);
+	}
+
+	template<typename...Ts>
+	const typename SoAVector<Ts...>::Iterator SoAVector<Ts...>::begin() const noexcept {
+		return Iterator(this, 0);
+	}
+
+	template<typename...Ts>
+	typename SoAVector<Ts...>::Iterator SoAVector<Ts...>::end() noexcept {
+		return Iterator(this, m_size);
+	}
+
+	template<typename...Ts>
+	const typename SoAVector<Ts...>::Iterator SoAVector<Ts...>::end() const noexcept {
+		return Iterator(this, m_size);
+	}
+
+	// Modifiers
+	template<typename...Ts>
+	void SoAVector<Ts...>::clear() noexcept {
+		destroy(0, m_size);
+		m_size = 0;
+	}
+
+	template<typename...Ts>
+	void SoAVector<Ts...>::push_back(const Ts&...values) {
+		emplace_back(values...);
+	}
+
+	template<typename...Ts>
+	void SoAVector<Ts...>::push_back(const value_type& values) {
+		std::apply([this](const Ts&...fields) { emplace_back(fields...); }, values);
+	}
+
+	// When growing, the row is built before the columns move, as the arguments may refer
+	// to fields of this vector
+	template<typename...Ts>
+	template<typename...Args>
+	void SoAVector<Ts...>::emplace_back(Args&&...args) {
+		static_assert(sizeof...(Args) == sizeof...(Ts), "emplace_back takes one argument per column");
+		if (m_size == m_capacity) {
+			value_type row(std::forward<Args>(args)...);
+			reserve(grow_capacity(m_size + 1));
+			build_columns(m_size, m_size + 1, [&](auto column) {
+				constexpr size_t I = decltype(column)::value;
+				std::construct_at(std::get<I>(m_columns) + m_size, std::move(std::get<I>(row)));
+			});
+		}
+		else {
+			auto forwarded = std::forward_as_tuple(std::forward<Args>(args)...);
+			build_columns(m_size, m_size + 1, [&](auto column) {
+				constexpr size_t I = decltype(column)::value;
+				using Arg = std::tuple_element_t<I, decltype(forwarded)>;
+				std::construct_at(std::get<I>(m_columns) + m_size, std::forward<Arg>(std::get<I>(forwarded)));
+			});
+		}
+		++m_size;
+	}
+
+	template<typename...Ts>
+	typename SoAVector<Ts...>::Iterator SoAVector<Ts...>::erase(const Iterator pos) {
+		return erase(pos, pos + 1);
+	}
+
+	template<typename...Ts>
+	typename SoAVector<Ts...>::Iterator SoAVector<Ts...>::erase(const Iterator first, const Iterator last) {
+		size_t start = first.index(), stop = last.index();
+		if (start > stop || stop > m_size) throw InvalidIteratorException("SoAVector");
+		if (start == stop) return first;
+		for_each_column([&](auto column) {
+			constexpr size_t I = decltype(column)::value;
+			auto* data = std::get<I>(m_columns);
+			std::move(data + stop, data + m_size, data + start);
+		});
+		destroy(m_size - (stop - start), m_size);
+		m_size -= stop - start;
+		return Iterator(this, start);
+	}
+
+	template<typename...Ts>
+	void SoAVector<Ts...>::pop_back() {
+		if (!m_size) throw OutOfRangeException("SoAVector");
+		destroy(m_size - 1, m_size);
+		--m_size;
+	}
+
+	template<typename...Ts>
+	void SoAVector<Ts...>::resize(size_t size) {
+		if (size <= m_size) {
+			destroy(size, m_size);
+			m_size = size;
+			return;
+		}
+		reserve(size);
+		build_columns(m_size, size, [&](auto column) {
+			constexpr size_t I = decltype(column)::value;
+			std::uninitialized_value_construct(std::get<I>(m_columns) + m_size, std::get<I>(m_columns) + size);
+		});
+		m_size = size;
+	}
+
+	template<typename...Ts>
+	void SoAVector<Ts...>::resize(size_t size, const Ts&...values) {
+		if (size <= m_size) {
+			destroy(size, m_size);
+			m_size = size;
+			return;
+		}
+		value_type fill(values...);
+		reserve(size);
+		build_columns(m_size, size, [&](auto column) {
+			constexpr size_t I = decltype(column)::value;
+			std::uninitialized_fill(std::get<I>(m_columns) + m_size, std::get<I>(m_columns) + size, std::get<I>(fill));
+		});
+		m_size = size;
+	}
+
+	template<typename...Ts>
+	void SoAVector<Ts...>::swap(SoAVector& other) noexcept {
+		std::swap(m_block, other.m_block);
+		std::swap(m_columns, other.m_columns);
+		std::swap(m_size, other.m_size);
+		std::swap(m_capacity, other.m_capacity);
+	}
+
+	// Private Members
+	template<typename...Ts>
+	template<typename F>
+	void SoAVector<Ts...>::for_each_column(F&& function) {
+		[&]<size_t...I>(std::index_sequence<I...>) {
+			(function(std::integral_constant<size_t, I>()), ...);
+		}(std::index_sequence_for<Ts...>());
+	}
+
+	// One block holding capacity elements of every column, each column aligned
+	template<typename...Ts>
+	std::byte* SoAVector<Ts...>::allocate(size_t capacity, Columns& columns) {
+		columns = Columns();
+		if (!capacity) return nullptr;
+		size_t offsets[column_count];
+		size_t bytes = 0;
+		for_each_column([&](auto column) {
+			constexpr size_t I = decltype(column)::value;
+			bytes = (bytes + column_alignment - 1) / column_alignment * column_alignment;
+			if (capacity > (size_t(-1) - bytes) / sizeof(Column<I>)) throw std::bad_array_new_length();
+			offsets[I] = bytes;
+			bytes += capacity * sizeof(Column<I>);
+		});
+		std::byte* block = static_cast<std::byte*>(::operator new(bytes, std::align_val_t(column_alignment)));
+		for_each_column([&](auto column) {
+			constexpr size_t I = decltype(column)::value;
+			std::get<I>(columns) = reinterpret_cast<Column<I>*>(block + offsets[I]);
+		});
+		return block;
+	}
+
+	template<typename...Ts>
+	void SoAVector<Ts...>::deallocate(std::byte* block) noexcept {
+		if (block) ::operator delete(block, std::align_val_t(column_alignment));
+	}
+
+	// Runs build for every column in order, each constructing rows [first, last) of its
+	// column; if one throws, the columns already built are destroyed again
+	template<typename...Ts>
+	template<typename F>
+	void SoAVector<Ts...>::build_columns(size_t first, size_t last, F build) {
+		size_t built = 0;
+		try {
+			for_each_column([&](auto column) {
+				build(column);
+				++built;
+			});
+		}
+		catch (...) {
+			for_each_column([&](auto column) {
+				constexpr size_t I = decltype(column)::value;
+				if (I < built) std::destroy(std::get<I>(m_columns) + first, std::get<I>(m_columns) + last);
+			});
+			throw;
+		}
+	}
+
+	template<typename...Ts>
+	void SoAVector<Ts...>::destroy(size_t first, size_t last) noexcept {
+		for_each_column([&](auto column) {
+			constexpr size_t I = decltype(column)::value;
+			std::destroy(std::get<I>(m_columns) + first, std::get<I>(m_columns) + last);
+		});
+	}
+
+	// Moves every column to a block of the new capacity. Columns whose move may throw are
+	// copied first, keeping the old block intact until nothing can fail; the rest are then
+	// relocated, so a throw leaves the vector unchanged.
+	template<typename...Ts>
+	void SoAVector<Ts...>::reallocate(size_t capacity) {
+		Columns fresh;
+		std::byte* block = allocate(capacity, fresh);
+		size_t copied = 0;
+		try {
+			for_each_column([&](auto column) {
+				constexpr size_t I = decltype(column)::value;
+				if constexpr (copies_on_relocate<Column<I>>) {
+					std::uninitialized_copy_n(std::get<I>(m_columns), m_size, std::get<I>(fresh));
+					++copied;
+				}
+			});
+		}
+		catch (...) {
+			for_each_column([&](auto column) {
+				constexpr size_t I = decltype(column)::value;
+				if constexpr (copies_on_relocate<Column<I>>) {
+					if (copied) {
+						std::destroy_n(std::get<I>(fresh), m_size);
+						--copied;
+					}
+				}
+			});
+			deallocate(block);
+			throw;
+		}
+		for_each_column([&](auto column) {
+			constexpr size_t I = decltype(column)::value;
+			if constexpr (copies_on_relocate<Column<I>>)
+				std::destroy_n(std::get<I>(m_columns), m_size);
+			else
+				relocate(std::get<I>(m_columns), m_size, std::get<I>(fresh));
+		});
+		deallocate(m_block);
+		m_block = block;
+		m_columns = fresh;
+		m_capacity = capacity;
+	}
+
+	template<typename...Ts>
+	size_t SoAVector<Ts...>::grow_capacity(size_t required) const noexcept {
+		return DefaultGrowth::grow(m_capacity, required);
+	}
+
+	template<typename...Ts>
+	template<size_t...I>
+	typename SoAVector<Ts...>::Reference SoAVector<Ts...>::row(size_t pos, std::index_sequence<I...>) const noexcept {
+		return Reference(std::get<I>(m_columns)[pos]...);
+	}
+}
\ No newline at end of file
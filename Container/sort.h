@@ -0,0 +1,603 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "globals.h"
+#include "vector.h"
+
+namespace Containers {
+
+	// Sorting for contiguous ranges and Vector
+	// sort uses LSD radix sort when the elements are integers or floating-point numbers and
+	// there are at least Global::RADIX_SORT_THRESHOLD of them, and pattern-defeating
+	// quicksort otherwise: introsort with ninther pivots, a partition that detects sorted
+	// input and falls back to insertion sort, shuffles on bad splits, and branch-free block
+	// partitioning when comparisons are cheap. sort_by_key radix-sorts on the number a
+	// projection extracts from each element. The stable variants merge with scratch space
+	// for half the range; radix sort is stable already. Scratch space comes from the
+	// Vector's allocator. Radix order puts -0.0 before 0.0 and NaNs at the ends by sign;
+	// the stable variants radix-sort with -0.0 read as 0.0, so the two stay in input order.
+
+	namespace sorting {
+
+		namespace detail {
+
+			inline constexpr size_t insertion_sort_threshold = 24;
+			inline constexpr size_t ninther_threshold = 128;
+			inline constexpr size_t partial_insertion_sort_limit = 8;
+			inline constexpr size_t block_size = 64;
+
+			// Key types radix sort handles, mapped to unsigned integers of the same order
+			template<typename K>
+			inline constexpr bool is_radix_key_v = (std::is_integral_v<K> && !std::is_same_v<K, bool>) ||
+				(std::is_floating_point_v<K> && std::numeric_limits<K>::is_iec559 && (sizeof(K) == 4 || sizeof(K) == 8));
+
+			template<typename K>
+			auto radix_key(K key) noexcept {
+				if constexpr (std::is_integral_v<K>) {
+					using U = std::make_unsigned_t<K>;
+					U bits = static_cast<U>(key);
+					if constexpr (std::is_signed_v<K>) bits ^= U(1) << (sizeof(K) * 8 - 1);
+					return bits;
+				}
+				else {
+					using U = std::conditional_t<sizeof(K) == 4, uint32_t, uint64_t>;
+					U bits = std::bit_cast<U>(key);
+					U sign = U(1) << (sizeof(K) * 8 - 1);
+					return bits & sign ? U(~bits) : U(bits | sign);
+				}
+			}
+
+			struct Identity {
+				template<typename T>
+				const T& operator()(const T& value) const noexcept { return value; }
+			};
+
+			template<typename Key>
+			struct KeyLess {
+				Key key;
+
+				template<typename T>
+				bool operator()(const T& lhs, const T& rhs) const { return key(lhs) < key(rhs); }
+			};
+
+			// Reads -0.0 as 0.0, which compare equal but differ in radix order
+			template<typename Key>
+			struct UnsignedZero {
+				Key key;
+
+				template<typename T>
+				auto operator()(const T& value) const {
+					std::decay_t<std::invoke_result_t<const Key&, const T&>> k = key(value);
+					return k == 0 ? decltype(k)(0) : k;
+				}
+			};
+
+			template<typename Compare>
+			inline constexpr bool is_builtin_compare_v = std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::greater<>>;
+
+			template<typename T, typename Compare>
+			struct is_cheap_compare : std::bool_constant<std::is_arithmetic_v<T> &&
+				(is_builtin_compare_v<Compare> || std::is_same_v<Compare, std::less<T>> || std::is_same_v<Compare, std::greater<T>>)> {};
+
+			template<typename T, typename Key>
+			struct is_cheap_compare<T, KeyLess<Key>> : std::bool_constant<std::is_trivially_copyable_v<T> && sizeof(T) <= 16 &&
+				std::is_arithmetic_v<std::decay_t<std::invoke_result_t<const Key&, const T&>>>> {};
+
+			// Block partitioning pays off only when comparing and moving are cheap
+			template<typename T, typename Compare>
+			inline constexpr bool use_branchless_v = is_cheap_compare<T, Compare>::value;
+
+			// Raw storage for n elements from a container's allocator
+			template<typename Allocator>
+			class ScratchBuffer {
+			private:
+				using AllocTraits = std::allocator_traits<Allocator>;
+				using T = typename AllocTraits::value_type;
+
+			public:
+				ScratchBuffer(const Allocator& allocator, size_t n) : m_allocator(allocator), m_data(AllocTraits::allocate(m_allocator, n)), m_size(n) {}
+
+				ScratchBuffer(const ScratchBuffer&) = delete;
+
+				ScratchBuffer& operator=(const ScratchBuffer&) = delete;
+
+				~ScratchBuffer() { AllocTraits::deallocate(m_allocator, m_data, m_size); }
+
+				T* data() const noexcept { return m_data; }
+
+			private:
+				Allocator m_allocator;
+				T* m_data;
+				size_t m_size;
+			};
+
+			// Insertion sort; unguarded when an element before first is known to be no greater
+			// than everything in the range
+			template<bool Guarded, typename T, typename Compare>
+			void insertion_sort(T* first, T* last, const Compare& comp) {
+				if (first == last) return;
+				for (T* current = first + 1; current != last; ++current) {
+					T* hole = current;
+					if (comp(*hole, *(hole - 1))) {
+						T value(std::move(*hole));
+						do {
+							*hole = std::move(*(hole - 1));
+							--hole;
+						} while ((!Guarded || hole != first) && comp(value, *(hole - 1)));
+						*hole = std::move(value);
+					}
+				}
+			}
+
+			// Insertion sort that gives up after moving partial_insertion_sort_limit elements;
+			// true when the range ended up sorted
+			template<typename T, typename Compare>
+			bool partial_insertion_sort(T* first, T* last, const Compare& comp) {
+				if (first == last) return true;
+				size_t moved = 0;
+				for (T* current = first + 1; current != last; ++current) {
+					T* hole = current;
+					if (comp(*hole, *(hole - 1))) {
+						T value(std::move(*hole));
+						do {
+							*hole = std::move(*(hole - 1));
+							--hole;
+						} while (hole != first && comp(value, *(hole - 1)));
+						*hole = std::move(value);
+						moved += current - hole;
+						if (moved > partial_insertion_sort_limit) return false;
+					}
+				}
+				return true;
+			}
+
+			template<typename T, typename Compare>
+			void sort2(T* a, T* b, const Compare& comp) {
+				if (comp(*b, *a)) std::iter_swap(a, b);
+			}
+
+			template<typename T, typename Compare>
+			void sort3(T* a, T* b, T* c, const Compare& comp) {
+				sort2(a, b, comp);
+				sort2(b, c, comp);
+				sort2(a, b, comp);
+			}
+
+			// Exchanges the num elements at first + left[i] with those at last - right[i]. With
+			// equal counts on both sides plain swaps keep descending input linear; otherwise a
+			// cyclic rotation moves each element once.
+			template<typename T>
+			void swap_offsets(T* first, T* last, const unsigned char* left, const unsigned char* right, size_t num, bool use_swaps) {
+				if (use_swaps) {
+					for (size_t i = 0; i < num; ++i)
+						std::iter_swap(first + left[i], last - right[i]);
+				}
+				else if (num) {
+					T* l = first + left[0];
+					T* r = last - right[0];
+					T value(std::move(*l));
+					*l = std::move(*r);
+					for (size_t i = 1; i < num; ++i) {
+						l = first + left[i];
+						*r = std::move(*l);
+						r = last - right[i];
+						*l = std::move(*r);
+					}
+					*r = std::move(value);
+				}
+			}
+
+			// Partitions around *first, putting elements equal to the pivot on the right.
+			// Returns the pivot's final position and whether the range was already partitioned.
+			template<bool Branchless, typename T, typename Compare>
+			std::pair<T*, bool> partition_right(T* begin, T* end, const Compare& comp) {
+				T pivot(std::move(*begin));
+				T* first = begin;
+				T* last = end;
+
+				// The median-of-three left a guard on each side, except when nothing is smaller
+				while (comp(*++first, pivot));
+				if (first - 1 == begin) {
+					while (first < last && !comp(*--last, pivot));
+				}
+				else {
+					while (!comp(*--last, pivot));
+				}
+
+				bool already_partitioned = first >= last;
+				if (!already_partitioned) {
+					std::iter_swap(first, last);
+					++first;
+					if constexpr (Branchless) {
+						// Collect the offsets of misplaced elements a block at a time without
+						// branching on the comparisons, then swap them in bulk
+						alignas(64) unsigned char offsets_l[block_size];
+						alignas(64) unsigned char offsets_r[block_size];
+						T* base_l = first;
+						T* base_r = last;
+						size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+						while (first < last) {
+							size_t unknown = last - first;
+							size_t split_l = num_l == 0 ? (num_r == 0 ? unknown / 2 : unknown) : 0;
+							size_t split_r = num_r == 0 ? unknown - split_l : 0;
+							if (split_l > block_size) split_l = block_size;
+							if (split_r > block_size) split_r = block_size;
+							for (size_t i = 0; i < split_l; ++i) {
+								offsets_l[num_l] = static_cast<unsigned char>(i);
+								num_l += !comp(*first, pivot);
+								++first;
+							}
+							for (size_t i = 0; i < split_r;) {
+								offsets_r[num_r] = static_cast<unsigned char>(++i);
+								num_r += comp(*--last, pivot);
+							}
+
+							size_t num = num_l < num_r ? num_l : num_r;
+							swap_offsets(base_l, base_r, offsets_l + start_l, offsets_r + start_r, num, num_l == num_r);
+							num_l -= num;
+							num_r -= num;
+							start_l += num;
+							start_r += num;
+							if (num_l == 0) {
+								start_l = 0;
+								base_l = first;
+							}
+							if (num_r == 0) {
+								start_r = 0;
+								base_r = last;
+							}
+						}
+
+						// One side has leftover misplaced elements; move them next to the boundary
+						if (num_l) {
+							while (num_l--) std::iter_swap(base_l + offsets_l[start_l + num_l], --last);
+							first = last;
+						}
+						if (num_r) {
+							while (num_r--) std::iter_swap(base_r - offsets_r[start_r + num_r], first++);
+							last = first;
+						}
+					}
+					else {
+						while (first < last) {
+							while (comp(*first, pivot)) ++first;
+							while (!comp(*--last, pivot));
+							if (first >= last) break;
+							std::iter_swap(first, last);
+							++first;
+						}
+					}
+				}
+
+				T* pivot_position = first - 1;
+				*begin = std::move(*pivot_position);
+				*pivot_position = std::move(pivot);
+				return { pivot_position, already_partitioned };
+			}
+
+			// Partitions around *first, putting elements equal to the pivot on the left. Used
+			// when the pivot equals the element before the range, i.e. a run of duplicates.
+			template<typename T, typename Compare>
+			T* partition_left(T* begin, T* end, const Compare& comp) {
+				T pivot(std::move(*begin));
+				T* first = begin;
+				T* last = end;
+
+				while (comp(pivot, *--last));
+				if (last + 1 == end) {
+					while (first < last && !comp(pivot, *++first));
+				}
+				else {
+					while (!comp(pivot, *++first));
+				}
+
+				while (first < last) {
+					std::iter_swap(first, last);
+					while (comp(pivot, *--last));
+					while (!comp(pivot, *++first));
+				}
+
+				*begin = std::move(*last);
+				*last = std::move(pivot);
+				return last;
+			}
+
+			template<bool Branchless, typename T, typename Compare>
+			void pdqsort(T* begin, T* end, const Compare& comp, int bad_allowed, bool leftmost) {
+				for (;;) {
+					size_t size = end - begin;
+					if (size < insertion_sort_threshold) {
+						if (leftmost) insertion_sort<true>(begin, end, comp);
+						else insertion_sort<false>(begin, end, comp);
+						return;
+					}
+
+					// Pivot is the median of three, or the pseudomedian of nine on large ranges
+					size_t half = size / 2;
+					if (size > ninther_threshold) {
+						sort3(begin, begin + half, end - 1, comp);
+						sort3(begin + 1, begin + (half - 1), end - 2, comp);
+						sort3(begin + 2, begin + (half + 1), end - 3, comp);
+						sort3(begin + (half - 1), begin + half, begin + (half + 1), comp);
+						std::iter_swap(begin, begin + half);
+					}
+					else {
+						sort3(begin + half, begin, end - 1, comp);
+					}
+
+					// A pivot equal to the element before the range means everything up to the
+					// pivot's last copy is already in place
+					if (!leftmost && !comp(*(begin - 1), *begin)) {
+						begin = partition_left(begin, end, comp) + 1;
+						continue;
+					}
+
+					auto [pivot_position, already_partitioned] = partition_right<Branchless>(begin, end, comp);
+					size_t left_size = pivot_position - begin;
+					size_t right_size = end - (pivot_position + 1);
+
+					if (left_size < size / 8 || right_size < size / 8) {
+						// Too many bad splits: guarantee O(n log n) with heapsort
+						if (--bad_allowed == 0) {
+							std::make_heap(begin, end, comp);
+							std::sort_heap(begin, end, comp);
+							return;
+						}
+
+						// Otherwise break up the pattern that produced the bad split
+						if (left_size >= insertion_sort_threshold) {
+							std::iter_swap(begin, begin + left_size / 4);
+							std::iter_swap(pivot_position - 1, pivot_position - left_size / 4);
+							if (left_size > ninther_threshold) {
+								std::iter_swap(begin + 1, begin + (left_size / 4 + 1));
+								std::iter_swap(begin + 2, begin + (left_size / 4 + 2));
+								std::iter_swap(pivot_position - 2, pivot_position - (left_size / 4 + 1));
+								std::iter_swap(pivot_position - 3, pivot_position - (left_size / 4 + 2));
+							}
+						}
+						if (right_size >= insertion_sort_threshold) {
+							std::iter_swap(pivot_position + 1, pivot_position + (1 + right_size / 4));
+							std::iter_swap(end - 1, end - right_size / 4);
+							if (right_size > ninther_threshold) {
+								std::iter_swap(pivot_position + 2, pivot_position + (2 + right_size / 4));
+								std::iter_swap(pivot_position + 3, pivot_position + (3 + right_size / 4));
+								std::iter_swap(end - 2, end - (1 + right_size / 4));
+								std::iter_swap(end - 3, end - (2 + right_size / 4));
+							}
+						}
+					}
+					else if (already_partitioned && partial_insertion_sort(begin, pivot_position, comp) &&
+						partial_insertion_sort(pivot_position + 1, end, comp)) {
+						// A partition that moved nothing suggests sorted input; accept it if both
+						// halves sort with only a few moves
+						return;
+					}
+
+					// Recurse into the left part and loop on the right one
+					pdqsort<Branchless>(begin, pivot_position, comp, bad_allowed, leftmost);
+					begin = pivot_position + 1;
+					leftmost = false;
+				}
+			}
+
+			// Sorts n elements by merging halves through buffer, which has raw storage for n / 2
+			template<typename T, typename Compare>
+			void merge_sort(T* first, size_t n, T* buffer, const Compare& comp) {
+				if (n < insertion_sort_threshold) {
+					insertion_sort<true>(first, first + n, comp);
+					return;
+				}
+				size_t half = n / 2;
+				merge_sort(first, half, buffer, comp);
+				merge_sort(first + half, n - half, buffer, comp);
+
+				// Left elements no greater than the first right one are already in place
+				T* middle = first + half;
+				T* last = first + n;
+				if (!comp(*middle, *(middle - 1))) return;
+				T* out = std::upper_bound(first, middle, *middle, comp);
+
+				T* buffer_end = std::uninitialized_move(out, middle, buffer);
+				T* left = buffer;
+				T* right = middle;
+				try {
+					while (left != buffer_end && right != last) {
+						if (comp(*right, *left)) *out++ = std::move(*right++);
+						else *out++ = std::move(*left++);
+					}
+				}
+				catch (...) {
+					// The holes left in the range are exactly as many as the buffered elements
+					std::move(left, buffer_end, out);
+					std::destroy(buffer, buffer_end);
+					throw;
+				}
+				std::move(left, buffer_end, out);
+				std::destroy(buffer, buffer_end);
+			}
+
+			// Ranges up to this size finish with LSD passes that stay in cache; shorter ones than
+			// the insertion threshold are not worth a histogram
+			inline constexpr size_t radix_cache_bytes = 512 * 1024;
+			inline constexpr size_t radix_insertion_threshold = 32;
+
+			// Sorts the n elements at data by the lowest digits bytes of their keys, using buffer
+			// as scratch. A first read notices input that is sorted or strictly descending and
+			// which bytes vary; bytes that are the same for every element are skipped.
+			// A range larger than radix_cache_bytes is first split on its most significant
+			// varying byte, and each bucket is sorted on the bytes below; otherwise LSD passes
+			// sort it one byte at a time from the least significant up. Every step is stable.
+			template<typename T, typename Key>
+			void radix_sort(T* data, T* buffer, size_t n, const Key& key, size_t digits) {
+				using U = decltype(radix_key(key(data[0])));
+				if (n < radix_insertion_threshold) {
+					insertion_sort<true>(data, data + n, [&key](const T& lhs, const T& rhs) {
+						return radix_key(key(lhs)) < radix_key(key(rhs));
+					});
+					return;
+				}
+
+				// Bits that differ from the first key tell which bytes vary at all
+				U first = radix_key(key(data[0]));
+				U last = first;
+				U varying = 0;
+				bool ascending = true;
+				bool descending = true;
+				for (size_t i = 1; i < n; ++i) {
+					U bits = radix_key(key(data[i]));
+					varying |= bits ^ first;
+					ascending &= last <= bits;
+					descending &= last > bits;
+					last = bits;
+				}
+				if (ascending) return;
+				if (descending) {
+					std::reverse(data, data + n);
+					return;
+				}
+				if constexpr (sizeof(U) > 1) {
+					if (digits < sizeof(U)) varying &= (U(1) << (digits * 8)) - 1;
+				}
+				size_t top = (std::bit_width(varying) + 7) / 8;
+				auto uniform = [varying](size_t digit) { return ((varying >> (digit * 8)) & 0xFF) == 0; };
+
+				if (n * sizeof(T) > radix_cache_bytes && top > 1) {
+					size_t digit = top - 1;
+					size_t starts[257] = {};
+					size_t next[256];
+					for (size_t i = 0; i < n; ++i)
+						++starts[((radix_key(key(data[i])) >> (digit * 8)) & 0xFF) + 1];
+					for (size_t byte = 0; byte < 256; ++byte) {
+						next[byte] = starts[byte];
+						starts[byte + 1] += starts[byte];
+					}
+					for (size_t i = 0; i < n; ++i)
+						std::memcpy(buffer + next[(radix_key(key(data[i])) >> (digit * 8)) & 0xFF]++, data + i, sizeof(T));
+					for (size_t byte = 0; byte < 256; ++byte) {
+						size_t begin = starts[byte];
+						size_t size = starts[byte + 1] - begin;
+						if (size > 1) radix_sort(buffer + begin, data + begin, size, key, digit);
+						std::memcpy(data + begin, buffer + begin, size * sizeof(T));
+					}
+					return;
+				}
+
+				size_t counts[sizeof(U)][256];
+				std::memset(counts, 0, top * sizeof(counts[0]));
+				for (size_t i = 0; i < n; ++i) {
+					U bits = radix_key(key(data[i]));
+					for (size_t digit = 0; digit < top; ++digit)
+						++counts[digit][(bits >> (digit * 8)) & 0xFF];
+				}
+
+				T* from = data;
+				T* to = buffer;
+				for (size_t digit = 0; digit < top; ++digit) {
+					if (uniform(digit)) continue;
+					size_t* count = counts[digit];
+					size_t offset = 0;
+					for (size_t byte = 0; byte < 256; ++byte) {
+						size_t c = count[byte];
+						count[byte] = offset;
+						offset += c;
+					}
+					for (size_t i = 0; i < n; ++i)
+						std::memcpy(to + count[(radix_key(key(from[i])) >> (digit * 8)) & 0xFF]++, from + i, sizeof(T));
+					std::swap(from, to);
+				}
+				if (from != data) std::memcpy(data, from, n * sizeof(T));
+			}
+		}
+
+		// Unstable sort of [first, last)
+		template<typename T, typename Compare = std::less<>>
+		void pdqsort(T* first, T* last, Compare comp = Compare()) {
+			if (last - first < 2) return;
+			detail::pdqsort<detail::use_branchless_v<T, Compare>>(first, last, comp, std::bit_width(static_cast<size_t>(last - first)), true);
+		}
+
+		// Stable sort of [first, last); buffer has raw storage for (last - first) / 2 elements
+		template<typename T, typename Compare = std::less<>>
+		void merge_sort(T* first, T* last, T* buffer, Compare comp = Compare()) {
+			detail::merge_sort(first, last - first, buffer, comp);
+		}
+
+		// Stable sort of [first, last) by key(element), which must be an integer or
+		// floating-point number; buffer has raw storage for last - first elements
+		template<typename T, typename Key = detail::Identity>
+		void radix_sort(T* first, T* last, T* buffer, Key key = Key()) {
+			static_assert(std::is_trivially_copyable_v<T>, "radix sort copies elements bytewise");
+			static_assert(detail::is_radix_key_v<std::decay_t<std::invoke_result_t<const Key&, const T&>>>, "radix sort needs integer or floating-point keys");
+			if (last - first < 2) return;
+			detail::radix_sort(first, buffer, last - first, key, sizeof(std::invoke_result_t<const Key&, const T&>));
+		}
+	}
+
+	template<typename T, typename Growth, typename Allocator, typename Compare>
+	void sort(Vector<T, Growth, Allocator>& vector, Compare comp) {
+		sorting::pdqsort(vector.data(), vector.data() + vector.size(), std::move(comp));
+	}
+
+	template<typename T, typename Growth, typename Allocator>
+	void sort(Vector<T, Growth, Allocator>& vector) {
+		if constexpr (sorting::detail::is_radix_key_v<T>) {
+			if (vector.size() >= Global::RADIX_SORT_THRESHOLD) {
+				sorting::detail::ScratchBuffer<Allocator> buffer(vector.get_allocator(), vector.size());
+				sorting::radix_sort(vector.data(), vector.data() + vector.size(), buffer.data());
+				return;
+			}
+		}
+		sort(vector, std::less<>());
+	}
+
+	// Sorts by key(element); radix sort when the key is a number and T is trivially copyable
+	template<typename T, typename Growth, typename Allocator, typename Key>
+	void sort_by_key(Vector<T, Growth, Allocator>& vector, Key key) {
+		using K = std::decay_t<std::invoke_result_t<const Key&, const T&>>;
+		if constexpr (sorting::detail::is_radix_key_v<K> && std::is_trivially_copyable_v<T>) {
+			if (vector.size() >= Global::RADIX_SORT_THRESHOLD) {
+				sorting::detail::ScratchBuffer<Allocator> buffer(vector.get_allocator(), vector.size());
+				sorting::radix_sort(vector.data(), vector.data() + vector.size(), buffer.data(), key);
+				return;
+			}
+		}
+		sort(vector, sorting::detail::KeyLess<Key>{ std::move(key) });
+	}
+
+	template<typename T, typename Growth, typename Allocator, typename Compare>
+	void stable_sort(Vector<T, Growth, Allocator>& vector, Compare comp) {
+		if (vector.size() < 2) return;
+		sorting::detail::ScratchBuffer<Allocator> buffer(vector.get_allocator(), vector.size() / 2);
+		sorting::merge_sort(vector.data(), vector.data() + vector.size(), buffer.data(), std::move(comp));
+	}
+
+	template<typename T, typename Growth, typename Allocator, typename Key>
+	void stable_sort_by_key(Vector<T, Growth, Allocator>& vector, Key key) {
+		using K = std::decay_t<std::invoke_result_t<const Key&, const T&>>;
+		if constexpr (sorting::detail::is_radix_key_v<K> && std::is_trivially_copyable_v<T>) {
+			if (vector.size() >= Global::RADIX_SORT_THRESHOLD) {
+				if constexpr (std::is_floating_point_v<K>) sort_by_key(vector, sorting::detail::UnsignedZero<Key>{ std::move(key) });
+				else sort_by_key(vector, std::move(key));
+				return;
+			}
+		}
+		stable_sort(vector, sorting::detail::KeyLess<Key>{ std::move(key) });
+	}
+
+	// Equal integers are indistinguishable, so any sort is stable for them
+	template<typename T, typename Growth, typename Allocator>
+	void stable_sort(Vector<T, Growth, Allocator>& vector) {
+		if constexpr (std::is_floating_point_v<T>) stable_sort_by_key(vector, sorting::detail::Identity());
+		else if constexpr (sorting::detail::is_radix_key_v<T>) sort(vector);
+		else stable_sort(vector, std::less<>());
+	}
+}
\ No newline at end of file
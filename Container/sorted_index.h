@@ -0,0 +1,254 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include "aligned_allocator.h"
+#include "exception.h"
+#include "simd.h"
+#include "vector.h"
+
+namespace Containers {
+
+	// Read-only set of sorted keys laid out for searching
+	// Binary search over a large array takes a cache miss on nearly every probe. Here the
+	// keys sit in a static B+ tree whose nodes are one cache line each: B = 64 / sizeof(T)
+	// keys and B + 1 implicit children, so a lookup touches about log_(B+1) n lines instead
+	// of log_2 n, and each node is ranked with one SIMD compare. The bottom layer is the
+	// keys themselves in order, which makes a search's answer its position in that layer.
+	// The batch lookups walk 16 searches down the tree together and prefetch each one's
+	// next node, so their misses overlap. Answers are ranks: lower_bound(x) is the number
+	// of keys less than x, as std::lower_bound would return on the sorted keys. The default
+	// allocator aligns the nodes to cache lines; with tens of millions of keys,
+	// HugePageAllocator also saves a TLB miss per level. NaN keys are not supported.
+	template<typename T, typename Allocator = AlignedAllocator<T, 64>>
+	class SortedIndex {
+		static_assert(simd::is_searchable_v<T>, "SortedIndex needs an integral, float or double key type");
+
+	public:
+		static constexpr size_t node_size = 64 / sizeof(T);
+
+		explicit SortedIndex(const Allocator& = Allocator());
+
+		// The range must be sorted
+		template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
+		SortedIndex(IT, IT, const Allocator& = Allocator());
+
+		template<typename Growth, typename A>
+		explicit SortedIndex(const Vector<T, Growth, A>&, const Allocator& = Allocator());
+
+		SortedIndex(const SortedIndex&) = default;
+
+		SortedIndex(SortedIndex&&) noexcept;
+
+		SortedIndex& operator=(const SortedIndex&) = default;
+
+		SortedIndex& operator=(SortedIndex&&) noexcept(std::is_nothrow_move_assignable_v<Vector<T, DefaultGrowth, Allocator>>);
+
+		Allocator get_allocator() const noexcept;
+
+		// Element Access
+		// Key with the given rank
+		const T& at(size_t) const;
+
+		const T& operator[](size_t) const;
+
+		// Capacity
+		bool empty() const noexcept;
+
+		size_t size() const noexcept;
+
+		// Lookup
+		size_t lower_bound(const T&) const noexcept;
+
+		size_t upper_bound(const T&) const noexcept;
+
+		bool contains(const T&) const noexcept;
+
+		// Batches: out[i] answers values[i]
+		void lower_bound(const T*, size_t, size_t*) const noexcept;
+
+		void upper_bound(const T*, size_t, size_t*) const noexcept;
+
+		void contains(const T*, size_t, bool*) const noexcept;
+
+	private:
+		static constexpr size_t max_height = 32;
+
+		Vector<T, DefaultGrowth, Allocator> m_tree;
+		size_t m_size;
+		size_t m_height;
+		size_t m_layers[max_height + 1];
+
+		static constexpr T padding() noexcept;
+
+		void build();
+	};
+
+	// Constructors
+	template<typename T, typename Allocator>
+	SortedIndex<T, Allocator>::SortedIndex(const Allocator& allocator) : m_tree(allocator), m_size(0), m_height(0), m_layers{} {}
+
+	template<typename T, typename Allocator>
+	template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
+	SortedIndex<T, Allocator>::SortedIndex(IT first, IT last, const Allocator& allocator) : SortedIndex(allocator) {
+		if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<IT>::iterator_category>)
+			m_tree.reserve(static_cast<size_t>(std::distance(first, last)));
+		for (; first != last; ++first)
+			m_tree.push_back(*first);
+		build();
+	}
+
+	template<typename T, typename Allocator>
+	template<typename Growth, typename A>
+	SortedIndex<T, Allocator>::SortedIndex(const Vector<T, Growth, A>& keys, const Allocator& allocator) :
+		SortedIndex(keys.data(), keys.data() + keys.size(), allocator) {}
+
+	template<typename T, typename Allocator>
+	SortedIndex<T, Allocator>::SortedIndex(SortedIndex&& other) noexcept :
+		m_tree(std::move(other.m_tree)), m_size(std::exchange(other.m_size, 0)), m_height(std::exchange(other.m_height, 0)) {
+		std::copy(other.m_layers, other.m_layers + max_height + 1, m_layers);
+	}
+
+	// An allocator that does not propagate may leave the keys behind, so the source is cleared
+	template<typename T, typename Allocator>
+	SortedIndex<T, Allocator>& SortedIndex<T, Allocator>::operator=(SortedIndex&& other) noexcept(std::is_nothrow_move_assignable_v<Vector<T, DefaultGrowth, Allocator>>) {
+		if (this == &other) return *this;
+		m_tree = std::move(other.m_tree);
+		m_size = std::exchange(other.m_size, 0);
+		m_height = std::exchange(other.m_height, 0);
+		std::copy(other.m_layers, other.m_layers + max_height + 1, m_layers);
+		other.m_tree.clear();
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	Allocator SortedIndex<T, Allocator>::get_allocator() const noexcept {
+		return m_tree.get_allocator();
+	}
+
+	// Element Access
+	template<typename T, typename Allocator>
+	const T& SortedIndex<T, Allocator>::at(size_t pos) const {
+		if (pos >= m_size) throw OutOfRangeException("SortedIndex");
+		return m_tree[pos];
+	}
+
+	template<typename T, typename Allocator>
+	const T& SortedIndex<T, Allocator>::operator[](size_t pos) const {
+		return m_tree[pos];
+	}
+
+	// Capacity
+	template<typename T, typename Allocator>
+	bool SortedIndex<T, Allocator>::empty() const noexcept { return m_size == 0; }
+
+	template<typename T, typename Allocator>
+	size_t SortedIndex<T, Allocator>::size() const noexcept { return m_size; }
+
+	// Lookup
+	template<typename T, typename Allocator>
+	size_t SortedIndex<T, Allocator>::lower_bound(const T& value) const noexcept {
+		size_t position;
+		lower_bound(&value, 1, &position);
+		return position;
+	}
+
+	template<typename T, typename Allocator>
+	size_t SortedIndex<T, Allocator>::upper_bound(const T& value) const noexcept {
+		size_t position;
+		upper_bound(&value, 1, &position);
+		return position;
+	}
+
+	template<typename T, typename Allocator>
+	bool SortedIndex<T, Allocator>::contains(const T& value) const noexcept {
+		size_t position = lower_bound(value);
+		return position < m_size && m_tree[position] == value;
+	}
+
+	template<typename T, typename Allocator>
+	void SortedIndex<T, Allocator>::lower_bound(const T* values, size_t count, size_t* out) const noexcept {
+		if (!m_height) {
+			for (size_t i = 0; i < count; ++i) out[i] = 0;
+			return;
+		}
+		simd::tree_search<false>(m_tree.data(), m_layers, m_height, m_size, values, count, out);
+	}
+
+	template<typename T, typename Allocator>
+	void SortedIndex<T, Allocator>::upper_bound(const T* values, size_t count, size_t* out) const noexcept {
+		if (!m_height) {
+			for (size_t i = 0; i < count; ++i) out[i] = 0;
+			return;
+		}
+		simd::tree_search<true>(m_tree.data(), m_layers, m_height, m_size, values, count, out);
+	}
+
+	template<typename T, typename Allocator>
+	void SortedIndex<T, Allocator>::contains(const T* values, size_t count, bool* out) const noexcept {
+		constexpr size_t chunk = 256;
+		size_t positions[chunk];
+		for (size_t first = 0; first < count; first += chunk) {
+			size_t n = count - first < chunk ? count - first : chunk;
+			lower_bound(values + first, n, positions);
+			for (size_t i = 0; i < n; ++i)
+				out[first + i] = positions[i] < m_size && m_tree[positions[i]] == values[first + i];
+		}
+	}
+
+	// Private Members
+	template<typename T, typename Allocator>
+	constexpr T SortedIndex<T, Allocator>::padding() noexcept {
+		if constexpr (std::is_floating_point_v<T>) return std::numeric_limits<T>::infinity();
+		else return std::numeric_limits<T>::max();
+	}
+
+	// Pads the keys to whole leaves, then adds layers of separators up to a single root:
+	// the separator between children c and c + 1 is the first key under child c + 1
+	template<typename T, typename Allocator>
+	void SortedIndex<T, Allocator>::build() {
+		m_size = m_tree.size();
+		for (size_t i = 1; i < m_size; ++i) {
+			if (m_tree[i] < m_tree[i - 1]) throw ContainerException("SortedIndex", "Keys are not sorted");
+		}
+		if (!m_size) return;
+
+		size_t layer_nodes[max_height];
+		layer_nodes[0] = (m_size + node_size - 1) / node_size;
+		size_t height = 1;
+		size_t total = layer_nodes[0];
+		while (layer_nodes[height - 1] > 1) {
+			layer_nodes[height] = (layer_nodes[height - 1] + node_size) / (node_size + 1);
+			total += layer_nodes[height++];
+		}
+		m_tree.reserve(total * node_size);
+		m_tree.resize(layer_nodes[0] * node_size, padding());
+
+		m_layers[0] = 0;
+		for (size_t level = 1; level < height; ++level) {
+			m_layers[level] = m_tree.size();
+			for (size_t slot = 0; slot < layer_nodes[level] * node_size; ++slot) {
+				size_t child = slot / node_size * (node_size + 1) + slot % node_size + 1;
+				T separator = padding();
+				if (child < layer_nodes[level - 1]) {
+					size_t leaf = child;
+					for (size_t below = 1; below < level; ++below) leaf *= node_size + 1;
+					separator = m_tree[leaf * node_size];
+				}
+				m_tree.push_back(separator);
+			}
+		}
+		m_layers[height] = m_tree.size();
+		m_height = height;
+	}
+
+	namespace pmr {
+		template<typename T>
+		using SortedIndex = Containers::SortedIndex<T, std::pmr::polymorphic_allocator<T>>;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,243 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include "exception.h"
+
+namespace Containers {
+
+	// Bounded lock-free queue for exactly one producer thread and one consumer thread
+	// A ring of power-of-two capacity indexed by two ever-increasing counters: the
+	// producer alone writes the tail and the consumer alone writes the head, each
+	// publishing with a release store that the other side reads with an acquire load.
+	// Each counter shares its cache line only with the owner's cached copy of the other
+	// counter, so the sides touch each other's line only when the cached copy says the
+	// ring looks full (producer) or empty (consumer). The bulk calls move many elements
+	// per publication, which is where most of the throughput comes from.
+	template<typename T, typename Allocator = std::allocator<T>>
+	class SpscQueue {
+	private:
+		using AllocTraits = std::allocator_traits<Allocator>;
+
+	public:
+		static constexpr size_t cache_line = 64;
+
+		// Capacity is rounded up to a power of two
+		explicit SpscQueue(size_t, const Allocator& = Allocator());
+
+		SpscQueue(const SpscQueue&) = delete;
+
+		SpscQueue& operator=(const SpscQueue&) = delete;
+
+		~SpscQueue();
+
+		Allocator get_allocator() const noexcept;
+
+		// Capacity
+		// Exact when called from either side while the other is idle; otherwise a snapshot
+		size_t size() const noexcept;
+
+		bool empty() const noexcept;
+
+		size_t capacity() const noexcept;
+
+		// Producer
+		bool try_push(const T&);
+
+		bool try_push(T&&);
+
+		template<typename...Args>
+		bool try_emplace(Args&&...);
+
+		// Moves up to n elements from first into the queue and returns how many fit
+		template<class IT>
+		size_t try_push_bulk(IT, size_t);
+
+		// Consumer
+		bool try_pop(T&);
+
+		// Moves up to n elements out of the queue into out and returns how many there were
+		template<class OutIT>
+		size_t try_pop_bulk(OutIT, size_t);
+
+		// Oldest element, or nullptr when empty; stays queued until pop
+		T* front() noexcept;
+
+		void pop();
+
+	private:
+		// read-only after construction
+		alignas(cache_line) Allocator m_allocator;
+		T* m_data;
+		size_t m_mask;
+
+		// consumer side
+		alignas(cache_line) std::atomic<size_t> m_head;
+		size_t m_cached_tail;
+
+		// producer side
+		alignas(cache_line) std::atomic<size_t> m_tail;
+		size_t m_cached_head;
+
+		size_t free_slots(size_t, size_t);
+
+		size_t ready_slots(size_t, size_t);
+	};
+
+	// Constructors
+	template<typename T, typename Allocator>
+	SpscQueue<T, Allocator>::SpscQueue(size_t capacity, const Allocator& allocator) :
+		m_allocator(allocator), m_data(nullptr), m_mask(0), m_head(0), m_cached_tail(0), m_tail(0), m_cached_head(0) {
+		if (!capacity) throw ContainerException("SpscQueue", "Zero capacity");
+		capacity = std::bit_ceil(capacity);
+		m_data = AllocTraits::allocate(m_allocator, capacity);
+		m_mask = capacity - 1;
+	}
+
+	template<typename T, typename Allocator>
+	SpscQueue<T, Allocator>::~SpscQueue() {
+		size_t tail = m_tail.load(std::memory_order_acquire);
+		for (size_t i = m_head.load(std::memory_order_relaxed); i != tail; ++i)
+			AllocTraits::destroy(m_allocator, m_data + (i & m_mask));
+		AllocTraits::deallocate(m_allocator, m_data, m_mask + 1);
+	}
+
+	template<typename T, typename Allocator>
+	Allocator SpscQueue<T, Allocator>::get_allocator() const noexcept {
+		return m_allocator;
+	}
+
+	// Capacity
+	template<typename T, typename Allocator>
+	size_t SpscQueue<T, Allocator>::size() const noexcept {
+		size_t head = m_head.load(std::memory_order_acquire);
+		return m_tail.load(std::memory_order_acquire) - head;
+	}
+
+	template<typename T, typename Allocator>
+	bool SpscQueue<T, Allocator>::empty() const noexcept {
+		return size() == 0;
+	}
+
+	template<typename T, typename Allocator>
+	size_t SpscQueue<T, Allocator>::capacity() const noexcept {
+		return m_mask + 1;
+	}
+
+	// Producer
+	template<typename T, typename Allocator>
+	bool SpscQueue<T, Allocator>::try_push(const T& value) {
+		return try_emplace(value);
+	}
+
+	template<typename T, typename Allocator>
+	bool SpscQueue<T, Allocator>::try_push(T&& value) {
+		return try_emplace(std::move(value));
+	}
+
+	template<typename T, typename Allocator>
+	template<typename...Args>
+	bool SpscQueue<T, Allocator>::try_emplace(Args&&...args) {
+		size_t tail = m_tail.load(std::memory_order_relaxed);
+		if (!free_slots(tail, 1)) return false;
+		AllocTraits::construct(m_allocator, m_data + (tail & m_mask), std::forward<Args>(args)...);
+		m_tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Elements built before a throwing one are still published
+	template<typename T, typename Allocator>
+	template<class IT>
+	size_t SpscQueue<T, Allocator>::try_push_bulk(IT first, size_t n) {
+		size_t tail = m_tail.load(std::memory_order_relaxed);
+		size_t count = free_slots(tail, n);
+		size_t built = 0;
+		try {
+			for (; built < count; ++built, ++first)
+				AllocTraits::construct(m_allocator, m_data + ((tail + built) & m_mask), std::move(*first));
+		}
+		catch (...) {
+			m_tail.store(tail + built, std::memory_order_release);
+			throw;
+		}
+		m_tail.store(tail + count, std::memory_order_release);
+		return count;
+	}
+
+	// Consumer
+	template<typename T, typename Allocator>
+	bool SpscQueue<T, Allocator>::try_pop(T& out) {
+		size_t head = m_head.load(std::memory_order_relaxed);
+		if (!ready_slots(head, 1)) return false;
+		T* element = m_data + (head & m_mask);
+		out = std::move(*element);
+		AllocTraits::destroy(m_allocator, element);
+		m_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	// An element whose move throws stays queued, as do the ones after it
+	template<typename T, typename Allocator>
+	template<class OutIT>
+	size_t SpscQueue<T, Allocator>::try_pop_bulk(OutIT out, size_t n) {
+		size_t head = m_head.load(std::memory_order_relaxed);
+		size_t count = ready_slots(head, n);
+		size_t moved = 0;
+		try {
+			for (; moved < count; ++moved, ++out) {
+				T* element = m_data + ((head + moved) & m_mask);
+				*out = std::move(*element);
+				AllocTraits::destroy(m_allocator, element);
+			}
+		}
+		catch (...) {
+			m_head.store(head + moved, std::memory_order_release);
+			throw;
+		}
+		m_head.store(head + count, std::memory_order_release);
+		return count;
+	}
+
+	template<typename T, typename Allocator>
+	T* SpscQueue<T, Allocator>::front() noexcept {
+		size_t head = m_head.load(std::memory_order_relaxed);
+		return ready_slots(head, 1) ? m_data + (head & m_mask) : nullptr;
+	}
+
+	template<typename T, typename Allocator>
+	void SpscQueue<T, Allocator>::pop() {
+		size_t head = m_head.load(std::memory_order_relaxed);
+		if (!ready_slots(head, 1)) throw OutOfRangeException("SpscQueue");
+		AllocTraits::destroy(m_allocator, m_data + (head & m_mask));
+		m_head.store(head + 1, std::memory_order_release);
+	}
+
+	// Private Members
+	// Up to wanted slots the producer may fill, refreshing its copy of the head only when
+	// the cached one shows too little room
+	template<typename T, typename Allocator>
+	size_t SpscQueue<T, Allocator>::free_slots(size_t tail, size_t wanted) {
+		size_t capacity = m_mask + 1;
+		if (capacity - (tail - m_cached_head) < wanted)
+			m_cached_head = m_head.load(std::memory_order_acquire);
+		size_t available = capacity - (tail - m_cached_head);
+		return available < wanted ? available : wanted;
+	}
+
+	template<typename T, typename Allocator>
+	size_t SpscQueue<T, Allocator>::ready_slots(size_t head, size_t wanted) {
+		if (m_cached_tail - head < wanted)
+			m_cached_tail = m_tail.load(std::memory_order_acquire);
+		size_t available = m_cached_tail - head;
+		return available < wanted ? available : wanted;
+	}
+
+	namespace pmr {
+		template<typename T>
+		using SpscQueue = Containers::SpscQueue<T, std::pmr::polymorphic_allocator<T>>;
+	}
+}
\ No newline at end of file
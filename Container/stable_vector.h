@@ -0,0 +1,548 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include "exception.h"
+#include "globals.h"
+
+namespace Containers {
+
+	// Segmented vector whose elements never move
+	// Elements live in blocks of first_block, 2 * first_block, 4 * first_block, ...
+	// elements, found through a fixed directory inside the object, so element i sits in
+	// block bit_width(i + first_block) - 1 - log2(first_block) and indexing is O(1).
+	// Growing allocates the next block and leaves the others alone: push_back never copies
+	// or moves existing elements, and pointers, references and iterators to them stay valid
+	// until that element is removed. Like Vector, at most half the capacity is unused.
+	template<typename T, typename Allocator = std::allocator<T>>
+	class StableVector {
+	private:
+		using AllocTraits = std::allocator_traits<Allocator>;
+
+	public:
+		class Iterator;
+
+		static constexpr size_t first_block = Global::STABLE_VECTOR_FIRST_BLOCK;
+
+		static_assert(std::has_single_bit(first_block), "the first block size must be a power of two");
+
+		static constexpr size_t max_blocks = sizeof(size_t) * 8 - std::countr_zero(first_block);
+
+		StableVector() : StableVector(Allocator()) {}
+
+		explicit StableVector(const Allocator&) noexcept;
+
+		explicit StableVector(size_t, const Allocator& = Allocator());
+
+		StableVector(size_t, const T&, const Allocator& = Allocator());
+
+		template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
+		StableVector(IT, IT, const Allocator& = Allocator());
+
+		StableVector(const StableVector&);
+
+		StableVector(const StableVector&, const Allocator&);
+
+		StableVector(StableVector&&) noexcept;
+
+		StableVector(StableVector&&, const Allocator&);
+
+		StableVector(std::initializer_list<T>, const Allocator& = Allocator());
+
+		~StableVector();
+
+		StableVector& operator=(const StableVector&);
+
+		StableVector& operator=(StableVector&&) noexcept(
+			AllocTraits::propagate_on_container_move_assignment::value ||
+			AllocTraits::is_always_equal::value);
+
+		StableVector& operator=(std::initializer_list<T>);
+
+		Allocator get_allocator() const noexcept;
+
+		// Element Access
+		T& at(size_t);
+
+		const T& at(size_t) const;
+
+		T& operator[](size_t);
+
+		const T& operator[](size_t) const;
+
+		T& front();
+
+		const T& front() const;
+
+		T& back();
+
+		const T& back() const;
+
+		// Capacity
+		bool empty() const noexcept;
+
+		size_t size() const noexcept;
+
+		void reserve(size_t);
+
+		size_t capacity() const noexcept;
+
+		// Frees the blocks holding no elements
+		void shrink_to_fit() noexcept;
+
+		// Iterators
+		Iterator begin() noexcept;
+
+		const Iterator begin() const noexcept;
+
+		Iterator end() noexcept;
+
+		const Iterator end() const noexcept;
+
+		// Modifiers
+		void clear() noexcept;
+
+		void push_back(const T&);
+
+		void push_back(T&&);
+
+		template<typename...Args>
+		void emplace_back(Args&&...);
+
+		void pop_back();
+
+		void resize(size_t);
+
+		void resize(size_t, const T&);
+
+		void swap(StableVector&) noexcept;
+
+	private:
+		Allocator m_allocator;
+		T* m_blocks[max_blocks];
+		size_t m_block_count;
+		size_t m_size;
+
+		static constexpr size_t block_size(size_t) noexcept;
+
+		static constexpr size_t capacity_of(size_t) noexcept;
+
+		T* slot(size_t) const noexcept;
+
+		void add_block();
+
+		void release() noexcept;
+
+		void swap_storage(StableVector&) noexcept;
+	};
+
+	template<typename T, typename Allocator>
+	class StableVector<T, Allocator>::Iterator {
+	public:
+		Iterator() : m_vector(nullptr), m_index(0) {}
+
+		Iterator(const StableVector* vector, size_t index) : m_vector(vector), m_index(index) {}
+
+		Iterator(const Iterator& other) : m_vector(other.m_vector), m_index(other.m_index) {}
+
+		Iterator& operator=(const Iterator&) = default;
+
+		bool operator==(const Iterator&) const;
+
+		bool operator!=(const Iterator&) const;
+
+		Iterator& operator++();
+
+		Iterator operator++(int);
+
+		Iterator operator+(int) const;
+
+		Iterator& operator+=(int);
+
+		Iterator& operator--();
+
+		Iterator operator--(int);
+
+		Iterator operator-(int) const;
+
+		Iterator& operator-=(int);
+
+		size_t operator-(const Iterator&) const;
+
+		T& operator*() const;
+
+		T* operator->() const;
+
+	private:
+		const StableVector* m_vector;
+		size_t m_index;
+	};
+
+	template<typename T, typename Allocator>
+	bool StableVector<T, Allocator>::Iterator::operator==(const Iterator& other) const {
+		return m_index == other.m_index;
+	}
+
+	template<typename T, typename Allocator>
+	bool StableVector<T, Allocator>::Iterator::operator!=(const Iterator& other) const {
+		return m_index != other.m_index;
+	}
+
+	template<typename T, typename Allocator>
+	typename StableVector<T, Allocator>::Iterator& StableVector<T, Allocator>::Iterator::operator++() {
+		++m_index;
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	typename StableVector<T, Allocator>::Iterator StableVector<T, Allocator>::Iterator::operator++(int) {
+		Iterator it = *this;
+		++(*this);
+		return it;
+	}
+
+	template<typename T, typename Allocator>
+	typename StableVector<T, Allocator>::Iterator StableVector<T, Allocator>::Iterator::operator+(int steps) const {
+		Iterator it = *this;
+		it.m_index += steps;
+		return it;
+	}
+
+	template<typename T, typename Allocator>
+	typename StableVector<T, Allocator>::Iterator& StableVector<T, Allocator>::Iterator::operator+=(int steps) {
+		m_index += steps;
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	typename StableVector<T, Allocator>::Iterator& StableVector<T, Allocator>::Iterator::operator--() {
+		--m_index;
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	typename StableVector<T, Allocator>::Iterator StableVector<T, Allocator>::Iterator::operator--(int) {
+		Iterator it = *this;
+		--(*this);
+		return it;
+	}
+
+	template<typename T, typename Allocator>
+	typename StableVector<T, Allocator>::Iterator StableVector<T, Allocator>::Iterator::operator-(int steps) const {
+		Iterator it = *this;
+		it.m_index -= steps;
+		return it;
+	}
+
+	template<typename T, typename Allocator>
+	typename StableVector<T, Allocator>::Iterator& StableVector<T, Allocator>::Iterator::operator-=(int steps) {
+		m_index -= steps;
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	size_t StableVector<T, Allocator>::Iterator::operator-(const Iterator& other) const {
+		return m_index - other.m_index;
+	}
+
+	template<typename T, typename Allocator>
+	T& StableVector<T, Allocator>::Iterator::operator*() const {
+		return *m_vector->slot(m_index);
+	}
+
+	template<typename T, typename Allocator>
+	T* StableVector<T, Allocator>::Iterator::operator->() const {
+		return m_vector->slot(m_index);
+	}
+
+	// Constructors
+	template<typename T, typename Allocator>
+	StableVector<T, Allocator>::StableVector(const Allocator& allocator) noexcept :
+		m_allocator(allocator), m_blocks(), m_block_count(0), m_size(0) {}
+
+	// The delegating constructors leave cleanup after a throw to the destructor
+	template<typename T, typename Allocator>
+	StableVector<T, Allocator>::StableVector(size_t size, const Allocator& allocator) : StableVector(allocator) {
+		resize(size);
+	}
+
+	template<typename T, typename Allocator>
+	StableVector<T, Allocator>::StableVector(size_t size, const T& value, const Allocator& allocator) : StableVector(allocator) {
+		resize(size, value);
+	}
+
+	template<typename T, typename Allocator>
+	template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
+	StableVector<T, Allocator>::StableVector(IT first, IT last, const Allocator& allocator) : StableVector(allocator) {
+		for (; first != last; ++first) emplace_back(*first);
+	}
+
+	template<typename T, typename Allocator>
+	StableVector<T, Allocator>::StableVector(const StableVector& other) :
+		StableVector(other, AllocTraits::select_on_container_copy_construction(other.m_allocator)) {}
+
+	template<typename T, typename Allocator>
+	StableVector<T, Allocator>::StableVector(const StableVector& other, const Allocator& allocator) : StableVector(allocator) {
+		reserve(other.m_size);
+		for (size_t i = 0; i < other.m_size; ++i) emplace_back(other[i]);
+	}
+
+	template<typename T, typename Allocator>
+	StableVector<T, Allocator>::StableVector(StableVector&& other) noexcept :
+		m_allocator(std::move(other.m_allocator)), m_blocks(), m_block_count(0), m_size(0) {
+		swap_storage(other);
+	}
+
+	template<typename T, typename Allocator>
+	StableVector<T, Allocator>::StableVector(StableVector&& other, const Allocator& allocator) : StableVector(allocator) {
+		if (m_allocator == other.m_allocator) {
+			swap_storage(other);
+			return;
+		}
+		// blocks from another resource cannot be adopted, so move element-wise
+		reserve(other.m_size);
+		for (size_t i = 0; i < other.m_size; ++i) emplace_back(std::move(other[i]));
+	}
+
+	template<typename T, typename Allocator>
+	StableVector<T, Allocator>::StableVector(std::initializer_list<T> il, const Allocator& allocator) :
+		StableVector(il.begin(), il.end(), allocator) {}
+
+	template<typename T, typename Allocator>
+	StableVector<T, Allocator>::~StableVector() {
+		release();
+	}
+
+	template<typename T, typename Allocator>
+	StableVector<T, Allocator>& StableVector<T, Allocator>::operator=(const StableVector& other) {
+		if (this == &other) return *this;
+		constexpr bool propagate = AllocTraits::propagate_on_container_copy_assignment::value;
+		StableVector temp(other, propagate ? other.m_allocator : m_allocator);
+		swap_storage(temp);
+		if constexpr (propagate) std::swap(m_allocator, temp.m_allocator);
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	StableVector<T, Allocator>& StableVector<T, Allocator>::operator=(StableVector&& other) noexcept(
+		AllocTraits::propagate_on_container_move_assignment::value ||
+		AllocTraits::is_always_equal::value) {
+		constexpr bool propagate = AllocTraits::propagate_on_container_move_assignment::value;
+		StableVector temp(std::move(other), propagate ? other.m_allocator : m_allocator);
+		swap_storage(temp);
+		if constexpr (propagate) std::swap(m_allocator, temp.m_allocator);
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	StableVector<T, Allocator>& StableVector<T, Allocator>::operator=(std::initializer_list<T> il) {
+		StableVector temp(il, m_allocator);
+		swap_storage(temp);
+		return *this;
+	}
+
+	template<typename T, typename Allocator>
+	Allocator StableVector<T, Allocator>::get_allocator() const noexcept {
+		return m_allocator;
+	}
+
+	// Element Access
+	template<typename T, typename Allocator>
+	T& StableVector<T, Allocator>::at(size_t pos) {
+		if (pos >= m_size) throw OutOfRangeException("StableVector");
+		return *slot(pos);
+	}
+
+	template<typename T, typename Allocator>
+	const T& StableVector<T, Allocator>::at(size_t pos) const {
+		if (pos >= m_size) throw OutOfRangeException("StableVector");
+		return *slot(pos);
+	}
+
+	template<typename T, typename Allocator>
+	T& StableVector<T, Allocator>::operator[](size_t pos) {
+		return *slot(pos);
+	}
+
+	template<typename T, typename Allocator>
+	const T& StableVector<T, Allocator>::operator[](size_t pos) const {
+		return *slot(pos);
+	}
+
+	template<typename T, typename Allocator>
+	T& StableVector<T, Allocator>::front() {
+		if (!m_size) throw OutOfRangeException("StableVector");
+		return *slot(0);
+	}
+
+	template<typename T, typename Allocator>
+	const T& StableVector<T, Allocator>::front() const {
+		if (!m_size) throw OutOfRangeException("StableVector");
+		return *slot(0);
+	}
+
+	template<typename T, typename Allocator>
+	T& StableVector<T, Allocator>::back() {
+		if (!m_size) throw OutOfRangeException("StableVector");
+		return *slot(m_size - 1);
+	}
+
+	template<typename T, typename Allocator>
+	const T& StableVector<T, Allocator>::back() const {
+		if (!m_size) throw OutOfRangeException("StableVector");
+		return *slot(m_size - 1);
+	}
+
+	// Capacity
+	template<typename T, typename Allocator>
+	bool StableVector<T, Allocator>::empty() const noexcept { return m_size == 0; }
+
+	template<typename T, typename Allocator>
+	size_t StableVector<T, Allocator>::size() const noexcept { return m_size; }
+
+	template<typename T, typename Allocator>
+	void StableVector<T, Allocator>::reserve(size_t capacity) {
+		while (capacity_of(m_block_count) < capacity) add_block();
+	}
+
+	template<typename T, typename Allocator>
+	size_t StableVector<T, Allocator>::capacity() const noexcept { return capacity_of(m_block_count); }
+
+	template<typename T, typename Allocator>
+	void StableVector<T, Allocator>::shrink_to_fit() noexcept {
+		while (m_block_count && capacity_of(m_block_count - 1) >= m_size) {
+			--m_block_count;
+			AllocTraits::deallocate(m_allocator, m_blocks[m_block_count], block_size(m_block_count));
+			m_blocks[m_block_count] = nullptr;
+		}
+	}
+
+	// Iterators
+	template<typename T, typename Allocator>
+	typename StableVector<T, Allocator>::Iterator StableVector<T, Allocator>::begin() noexcept {
+		return Iterator(this, 0);
+	}
+
+	template<typename T, typename Allocator>
+	const typename StableVector<T, Allocator>::Iterator StableVector<T, Allocator>::begin() const noexcept {
+		return Iterator(this, 0);
+	}
+
+	template<typename T, typename Allocator>
+	typename StableVector<T, Allocator>::Iterator StableVector<T, Allocator>::end() noexcept {
+		return Iterator(this, m_size);
+	}
+
+	template<typename T, typename Allocator>
+	const typename StableVector<T, Allocator>::Iterator StableVector<T, Allocator>::end() const noexcept {
+		return Iterator(this, m_size);
+	}
+
+	// Modifiers
+	template<typename T, typename Allocator>
+	void StableVector<T, Allocator>::clear() noexcept {
+		for (size_t i = m_size; i > 0; --i)
+			AllocTraits::destroy(m_allocator, slot(i - 1));
+		m_size = 0;
+	}
+
+	template<typename T, typename Allocator>
+	void StableVector<T, Allocator>::push_back(const T& value) {
+		emplace_back(value);
+	}
+
+	template<typename T, typename Allocator>
+	void StableVector<T, Allocator>::push_back(T&& value) {
+		emplace_back(std::move(value));
+	}
+
+	// Existing elements stay put when a block is added, so args may refer to them
+	template<typename T, typename Allocator>
+	template<typename...Args>
+	void StableVector<T, Allocator>::emplace_back(Args&&...args) {
+		if (m_size == capacity_of(m_block_count)) add_block();
+		AllocTraits::construct(m_allocator, slot(m_size), std::forward<Args>(args)...);
+		++m_size;
+	}
+
+	template<typename T, typename Allocator>
+	void StableVector<T, Allocator>::pop_back() {
+		if (!m_size) throw OutOfRangeException("StableVector");
+		AllocTraits::destroy(m_allocator, slot(--m_size));
+	}
+
+	template<typename T, typename Allocator>
+	void StableVector<T, Allocator>::resize(size_t size) {
+		while (m_size > size) pop_back();
+		reserve(size);
+		while (m_size < size) emplace_back();
+	}
+
+	template<typename T, typename Allocator>
+	void StableVector<T, Allocator>::resize(size_t size, const T& value) {
+		while (m_size > size) pop_back();
+		reserve(size);
+		while (m_size < size) emplace_back(value);
+	}
+
+	template<typename T, typename Allocator>
+	void StableVector<T, Allocator>::swap(StableVector& other) noexcept {
+		swap_storage(other);
+		if constexpr (AllocTraits::propagate_on_container_swap::value)
+			std::swap(m_allocator, other.m_allocator);
+	}
+
+	// Private Members
+	template<typename T, typename Allocator>
+	constexpr size_t StableVector<T, Allocator>::block_size(size_t block) noexcept {
+		return first_block << block;
+	}
+
+	template<typename T, typename Allocator>
+	constexpr size_t StableVector<T, Allocator>::capacity_of(size_t blocks) noexcept {
+		return blocks ? first_block * ((size_t(2) << (blocks - 1)) - 1) : 0;
+	}
+
+	// Block k starts at index first_block * (2^k - 1), so offsetting the index by first_block
+	// turns the block number into the position of its highest set bit
+	template<typename T, typename Allocator>
+	T* StableVector<T, Allocator>::slot(size_t pos) const noexcept {
+		constexpr size_t shift = std::countr_zero(first_block);
+		size_t shifted = pos + first_block;
+		size_t block = std::bit_width(shifted) - 1 - shift;
+		return m_blocks[block] + (shifted - (first_block << block));
+	}
+
+	template<typename T, typename Allocator>
+	void StableVector<T, Allocator>::add_block() {
+		if (m_block_count == max_blocks) throw OutOfRangeException("StableVector");
+		m_blocks[m_block_count] = AllocTraits::allocate(m_allocator, block_size(m_block_count));
+		++m_block_count;
+	}
+
+	template<typename T, typename Allocator>
+	void StableVector<T, Allocator>::release() noexcept {
+		clear();
+		while (m_block_count) {
+			--m_block_count;
+			AllocTraits::deallocate(m_allocator, m_blocks[m_block_count], block_size(m_block_count));
+			m_blocks[m_block_count] = nullptr;
+		}
+	}
+
+	template<typename T, typename Allocator>
+	void StableVector<T, Allocator>::swap_storage(StableVector& other) noexcept {
+		std::swap(m_blocks, other.m_blocks);
+		std::swap(m_block_count, other.m_block_count);
+		std::swap(m_size, other.m_size);
+	}
+
+	namespace pmr {
+		template<typename T>
+		using StableVector = Containers::StableVector<T, std::pmr::polymorphic_allocator<T>>;
+	}
+}
\ No newline at end of file
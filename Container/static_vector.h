@@ -0,0 +1,361 @@
+#pragma once
+#include <algorithm>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "exception.h"
+#include "expression.h"
+#include "vector_base.h"
+
+namespace Containers {
+
+	// Storage policy for StaticVector: N raw slots inside the object. They are a union so
+	// nothing is constructed up front and so the storage stays trivially copyable exactly
+	// when T is.
+	template<typename T, size_t N>
+	class StaticStorage {
+	public:
+		constexpr T* data() noexcept;
+
+		constexpr const T* data() const noexcept;
+
+		static constexpr size_t capacity() noexcept;
+
+	protected:
+		union Slots {
+			constexpr Slots() noexcept {}
+
+			constexpr ~Slots() requires std::is_trivially_destructible_v<T> = default;
+
+			constexpr ~Slots() {}
+
+			T elements[N];
+		};
+
+		Slots m_slots;
+		size_t m_size;
+
+		constexpr StaticStorage() noexcept;
+
+		template<typename...Args>
+		constexpr void construct(T*, Args&&...);
+
+		constexpr void destroy(T*, T*) noexcept;
+
+		constexpr size_t grow_capacity(size_t) const noexcept;
+	};
+
+	// A Vector with a fixed capacity of N whose elements live inside the object, so it
+	// never allocates. Every member is constexpr, and for trivially copyable T the whole
+	// vector is trivially copyable too. Growing past N throws OutOfRangeException from the
+	// usual members, and building its message allocates. The try_ members check the room
+	// first and report an overflow by returning nullptr or false instead, leaving the
+	// vector unchanged, so code that must not allocate can use them.
+	template<typename T, size_t N>
+	class StaticVector : public VectorBase<StaticVector<T, N>, T, StaticStorage<T, N>> {
+		using Base = VectorBase<StaticVector<T, N>, T, StaticStorage<T, N>>;
+	public:
+		using typename Base::Iterator;
+
+		static constexpr size_t static_capacity = N;
+
+		constexpr StaticVector() noexcept;
+
+		constexpr explicit StaticVector(size_t);
+
+		constexpr StaticVector(size_t, const T&);
+
+		template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
+		constexpr StaticVector(IT, IT);
+
+		constexpr StaticVector(const StaticVector&) requires std::is_trivially_copyable_v<T> = default;
+
+		constexpr StaticVector(const StaticVector&);
+
+		constexpr StaticVector(StaticVector&&) noexcept requires std::is_trivially_copyable_v<T> = default;
+
+		constexpr StaticVector(StaticVector&&) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+		constexpr StaticVector(std::initializer_list<T>);
+
+		constexpr ~StaticVector() requires std::is_trivially_destructible_v<T> = default;
+
+		constexpr ~StaticVector();
+
+		constexpr StaticVector& operator=(const StaticVector&) requires std::is_trivially_copyable_v<T> = default;
+
+		constexpr StaticVector& operator=(const StaticVector&);
+
+		constexpr StaticVector& operator=(StaticVector&&) noexcept requires std::is_trivially_copyable_v<T> = default;
+
+		constexpr StaticVector& operator=(StaticVector&&) noexcept(
+			std::is_nothrow_move_constructible_v<T> &&
+			std::is_nothrow_move_assignable_v<T>);
+
+		constexpr StaticVector& operator=(std::initializer_list<T>);
+
+		// Capacity
+		constexpr bool full() const noexcept;
+
+		constexpr void reserve(size_t);
+
+		constexpr void shrink_to_fit() noexcept;
+
+		// Modifiers
+		constexpr T* try_push_back(const T&);
+
+		constexpr T* try_push_back(T&&);
+
+		template<typename...Args>
+		constexpr T* try_emplace_back(Args&&...);
+
+		template<typename...Args>
+		constexpr T* try_emplace(const Iterator, Args&&...);
+
+		constexpr T* try_insert(const Iterator, const T&);
+
+		constexpr T* try_insert(const Iterator, T&&);
+
+		constexpr bool try_insert(const Iterator, size_t, const T&);
+
+		template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
+		constexpr bool try_insert(const Iterator, IT, IT);
+
+		constexpr bool try_resize(size_t);
+
+		constexpr bool try_resize(size_t, const T&);
+
+		constexpr void swap(StaticVector&) noexcept(
+			std::is_nothrow_move_constructible_v<T> &&
+			std::is_nothrow_swappable_v<T>);
+
+	private:
+		friend Base;
+
+		static constexpr const char* name = "StaticVector";
+
+		using Base::m_size;
+
+		template<class IT>
+		constexpr void assign(IT, IT);
+	};
+
+	// StaticStorage
+	template<typename T, size_t N>
+	constexpr StaticStorage<T, N>::StaticStorage() noexcept :
+		m_size(0) {}
+
+	template<typename T, size_t N>
+	constexpr T* StaticStorage<T, N>::data() noexcept { return m_slots.elements; }
+
+	template<typename T, size_t N>
+	constexpr const T* StaticStorage<T, N>::data() const noexcept { return m_slots.elements; }
+
+	template<typename T, size_t N>
+	constexpr size_t StaticStorage<T, N>::capacity() noexcept { return N; }
+
+	template<typename T, size_t N>
+	template<typename...Args>
+	constexpr void StaticStorage<T, N>::construct(T* dest, Args&&...args) {
+		std::construct_at(dest, std::forward<Args>(args)...);
+	}
+
+	template<typename T, size_t N>
+	constexpr void StaticStorage<T, N>::destroy(T* first, T* last) noexcept {
+		std::destroy(first, last);
+	}
+
+	// There is nothing to grow into, so the request goes to reserve as it is and throws
+	// there when it exceeds N
+	template<typename T, size_t N>
+	constexpr size_t StaticStorage<T, N>::grow_capacity(size_t required) const noexcept {
+		return required;
+	}
+
+	// Constructors
+	template<typename T, size_t N>
+	constexpr StaticVector<T, N>::StaticVector() noexcept {}
+
+	template<typename T, size_t N>
+	constexpr StaticVector<T, N>::StaticVector(size_t size) :
+		StaticVector() {
+		this->resize(size);
+	}
+
+	template<typename T, size_t N>
+	constexpr StaticVector<T, N>::StaticVector(size_t size, const T& init_val) :
+		StaticVector() {
+		this->insert(this->end(), size, init_val);
+	}
+
+	template<typename T, size_t N>
+	template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
+	constexpr StaticVector<T, N>::StaticVector(IT first, IT last) :
+		StaticVector() {
+		if (static_cast<size_t>(last - first) > N) throw OutOfRangeException("StaticVector");
+		for (; first != last; ++first, ++m_size)
+			std::construct_at(this->data() + m_size, *first);
+	}
+
+	template<typename T, size_t N>
+	constexpr StaticVector<T, N>::StaticVector(const StaticVector& other) :
+		StaticVector(other.begin(), other.end()) {}
+
+	template<typename T, size_t N>
+	constexpr StaticVector<T, N>::StaticVector(StaticVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) :
+		StaticVector() {
+		for (; m_size < other.m_size; ++m_size)
+			std::construct_at(this->data() + m_size, std::move(other[m_size]));
+		other.clear();
+	}
+
+	template<typename T, size_t N>
+	constexpr StaticVector<T, N>::StaticVector(std::initializer_list<T> il) :
+		StaticVector(il.begin(), il.end()) {}
+
+	template<typename T, size_t N>
+	constexpr StaticVector<T, N>::~StaticVector() {
+		this->clear();
+	}
+
+	template<typename T, size_t N>
+	constexpr StaticVector<T, N>& StaticVector<T, N>::operator=(const StaticVector& other) {
+		if (this != &other) assign(other.data(), other.data() + other.m_size);
+		return *this;
+	}
+
+	template<typename T, size_t N>
+	constexpr StaticVector<T, N>& StaticVector<T, N>::operator=(StaticVector&& other) noexcept(
+		std::is_nothrow_move_constructible_v<T> &&
+		std::is_nothrow_move_assignable_v<T>) {
+		if (this == &other) return *this;
+		assign(std::make_move_iterator(other.data()), std::make_move_iterator(other.data() + other.m_size));
+		other.clear();
+		return *this;
+	}
+
+	template<typename T, size_t N>
+	constexpr StaticVector<T, N>& StaticVector<T, N>::operator=(std::initializer_list<T> il) {
+		assign(il.begin(), il.end());
+		return *this;
+	}
+
+	// Capacity
+	template<typename T, size_t N>
+	constexpr bool StaticVector<T, N>::full() const noexcept { return m_size == N; }
+
+	template<typename T, size_t N>
+	constexpr void StaticVector<T, N>::reserve(size_t capacity) {
+		if (capacity > N) throw OutOfRangeException("StaticVector");
+	}
+
+	template<typename T, size_t N>
+	constexpr void StaticVector<T, N>::shrink_to_fit() noexcept {}
+
+	// Modifiers
+	template<typename T, size_t N>
+	constexpr T* StaticVector<T, N>::try_push_back(const T& value) {
+		return try_emplace_back(value);
+	}
+
+	template<typename T, size_t N>
+	constexpr T* StaticVector<T, N>::try_push_back(T&& value) {
+		return try_emplace_back(std::move(value));
+	}
+
+	// Constructs the element in place and returns it, or returns nullptr when the vector
+	// is full and leaves args untouched
+	template<typename T, size_t N>
+	template<typename...Args>
+	constexpr T* StaticVector<T, N>::try_emplace_back(Args&&...args) {
+		if (m_size == N) return nullptr;
+		T* element = std::construct_at(this->data() + m_size, std::forward<Args>(args)...);
+		++m_size;
+		return element;
+	}
+
+	// Inserts the element before pos and returns it, or returns nullptr when the vector is
+	// full. An invalid pos still throws InvalidIteratorException.
+	template<typename T, size_t N>
+	template<typename...Args>
+	constexpr T* StaticVector<T, N>::try_emplace(const Iterator pos, Args&&...args) {
+		if (m_size == N) return nullptr;
+		return &*this->emplace(pos, std::forward<Args>(args)...);
+	}
+
+	template<typename T, size_t N>
+	constexpr T* StaticVector<T, N>::try_insert(const Iterator pos, const T& value) {
+		return try_emplace(pos, value);
+	}
+
+	template<typename T, size_t N>
+	constexpr T* StaticVector<T, N>::try_insert(const Iterator pos, T&& value) {
+		return try_emplace(pos, std::move(value));
+	}
+
+	template<typename T, size_t N>
+	constexpr bool StaticVector<T, N>::try_insert(const Iterator pos, size_t n, const T& value) {
+		if (n > N - m_size) return false;
+		this->insert(pos, n, value);
+		return true;
+	}
+
+	template<typename T, size_t N>
+	template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
+	constexpr bool StaticVector<T, N>::try_insert(const Iterator pos, IT first, IT last) {
+		if (static_cast<size_t>(last - first) > N - m_size) return false;
+		this->insert(pos, first, last);
+		return true;
+	}
+
+	template<typename T, size_t N>
+	constexpr bool StaticVector<T, N>::try_resize(size_t size) {
+		if (size > N) return false;
+		this->resize(size);
+		return true;
+	}
+
+	template<typename T, size_t N>
+	constexpr bool StaticVector<T, N>::try_resize(size_t size, const T& value) {
+		if (size > N) return false;
+		this->resize(size, value);
+		return true;
+	}
+
+	template<typename T, size_t N>
+	constexpr void StaticVector<T, N>::swap(StaticVector& other) noexcept(
+		std::is_nothrow_move_constructible_v<T> &&
+		std::is_nothrow_swappable_v<T>) {
+		StaticVector& shorter = m_size < other.m_size ? *this : other;
+		StaticVector& longer = m_size < other.m_size ? other : *this;
+		size_t common = shorter.m_size;
+		for (size_t i = 0; i < common; ++i) {
+			using std::swap;
+			swap(shorter[i], longer[i]);
+		}
+		for (; shorter.m_size < longer.m_size; ++shorter.m_size)
+			std::construct_at(shorter.data() + shorter.m_size, std::move(longer[shorter.m_size]));
+		std::destroy(longer.data() + common, longer.data() + longer.m_size);
+		longer.m_size = common;
+	}
+
+	// Private Members
+	// Replaces the contents with [first, last), assigning over the live elements and
+	// constructing or destroying the difference
+	template<typename T, size_t N>
+	template<class IT>
+	constexpr void StaticVector<T, N>::assign(IT first, IT last) {
+		if (static_cast<size_t>(last - first) > N) throw OutOfRangeException("StaticVector");
+		size_t assigned = 0;
+		for (; assigned < m_size && first != last; ++assigned, ++first)
+			this->data()[assigned] = *first;
+		std::destroy(this->data() + assigned, this->data() + m_size);
+		m_size = assigned;
+		for (; first != last; ++first, ++m_size)
+			std::construct_at(this->data() + m_size, *first);
+	}
+
+	template<typename T, size_t N>
+	struct is_numeric_container<StaticVector<T, N>> : std::is_arithmetic<T> {};
+}
\ No newline at end of file
@@ -0,0 +1,280 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Containers {
+
+	// Work-stealing thread pool
+	// Every worker owns a deque of tasks. A worker pushes the tasks it spawns onto the back
+	// of its own deque and pops from the back, so recently split work stays in its cache;
+	// when the deque runs dry it steals from the front of another worker's, taking the
+	// oldest and therefore largest piece. Tasks submitted from outside the pool are dealt
+	// round-robin across the workers.
+
+	class ThreadPool {
+	public:
+		using Task = std::function<void()>;
+
+		explicit ThreadPool(size_t threads = std::thread::hardware_concurrency());
+
+		ThreadPool(const ThreadPool&) = delete;
+
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		~ThreadPool();
+
+		// Shared pool sized to the machine, started on first use
+		static ThreadPool& global();
+
+		size_t size() const noexcept;
+
+		// Tasks must not throw; spawn through a TaskGroup to get exceptions back
+		void submit(Task);
+
+		// Runs one queued task on the calling thread, if any can be found. Lets a thread
+		// that waits on spawned work help with it instead of blocking a core.
+		bool try_run_one();
+
+	private:
+		struct Worker {
+			std::mutex mutex;
+			std::deque<Task> tasks;
+		};
+
+		std::vector<std::unique_ptr<Worker>> m_workers;
+		std::vector<std::thread> m_threads;
+		std::atomic<size_t> m_pending;
+		std::atomic<size_t> m_next;
+		std::mutex m_sleep_mutex;
+		std::condition_variable m_wake;
+		bool m_stop;
+
+		static inline thread_local ThreadPool* t_pool = nullptr;
+		static inline thread_local size_t t_index = 0;
+
+		bool pop(size_t, Task&);
+
+		bool steal(size_t, Task&);
+
+		bool take(Task&);
+
+		void run(size_t);
+	};
+
+	// Fork-join scope over a pool
+	// run() spawns a task and wait() returns once all spawned tasks finished, running queued
+	// tasks on the waiting thread meanwhile, so tasks may themselves spawn and wait without
+	// starving the pool. The first exception thrown by a task is rethrown from wait().
+
+	class TaskGroup {
+	public:
+		explicit TaskGroup(ThreadPool& = ThreadPool::global());
+
+		TaskGroup(const TaskGroup&) = delete;
+
+		TaskGroup& operator=(const TaskGroup&) = delete;
+
+		~TaskGroup();
+
+		template<typename F>
+		void run(F&&);
+
+		void wait();
+
+	private:
+		ThreadPool& m_pool;
+		std::atomic<size_t> m_outstanding;
+		std::mutex m_mutex;
+		std::condition_variable m_done;
+		std::exception_ptr m_error;
+
+		void join() noexcept;
+
+		void finish(std::exception_ptr) noexcept;
+	};
+
+	// ThreadPool
+
+	inline ThreadPool::ThreadPool(size_t threads) : m_pending(0), m_next(0), m_stop(false) {
+		threads = std::max<size_t>(threads, 1);
+		m_workers.reserve(threads);
+		for (size_t i = 0; i < threads; ++i)
+			m_workers.push_back(std::make_unique<Worker>());
+		m_threads.reserve(threads);
+		try {
+			for (size_t i = 0; i < threads; ++i)
+				m_threads.emplace_back(&ThreadPool::run, this, i);
+		}
+		catch (...) {
+			{
+				std::lock_guard<std::mutex> lock(m_sleep_mutex);
+				m_stop = true;
+			}
+			m_wake.notify_all();
+			for (std::thread& thread : m_threads) thread.join();
+			throw;
+		}
+	}
+
+	// Queued tasks are still run before the workers exit
+	inline ThreadPool::~ThreadPool() {
+		{
+			std::lock_guard<std::mutex> lock(m_sleep_mutex);
+			m_stop = true;
+		}
+		m_wake.notify_all();
+		for (std::thread& thread : m_threads) thread.join();
+	}
+
+	inline ThreadPool& ThreadPool::global() {
+		static ThreadPool pool;
+		return pool;
+	}
+
+	inline size_t ThreadPool::size() const noexcept {
+		return m_workers.size();
+	}
+
+	inline void ThreadPool::submit(Task task) {
+		size_t index = t_pool == this ? t_index : m_next.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+		// Counted before it is queued, so a thief can never take it first and wrap the count
+		m_pending.fetch_add(1, std::memory_order_relaxed);
+		try {
+			std::lock_guard<std::mutex> lock(m_workers[index]->mutex);
+			m_workers[index]->tasks.push_back(std::move(task));
+		}
+		catch (...) {
+			m_pending.fetch_sub(1, std::memory_order_relaxed);
+			throw;
+		}
+		// Taking the sleep mutex orders this wake-up after a worker's check of m_pending,
+		// so a worker about to sleep cannot miss it
+		{
+			std::lock_guard<std::mutex> lock(m_sleep_mutex);
+		}
+		m_wake.notify_one();
+	}
+
+	inline bool ThreadPool::try_run_one() {
+		Task task;
+		if (!take(task)) return false;
+		task();
+		return true;
+	}
+
+	inline bool ThreadPool::pop(size_t index, Task& task) {
+		Worker& worker = *m_workers[index];
+		std::lock_guard<std::mutex> lock(worker.mutex);
+		if (worker.tasks.empty()) return false;
+		task = std::move(worker.tasks.back());
+		worker.tasks.pop_back();
+		return true;
+	}
+
+	inline bool ThreadPool::steal(size_t index, Task& task) {
+		Worker& worker = *m_workers[index];
+		std::unique_lock<std::mutex> lock(worker.mutex, std::try_to_lock);
+		if (!lock.owns_lock() || worker.tasks.empty()) return false;
+		task = std::move(worker.tasks.front());
+		worker.tasks.pop_front();
+		return true;
+	}
+
+	// Own deque first, then one sweep over the others starting at a neighbour
+	inline bool ThreadPool::take(Task& task) {
+		if (!m_pending.load(std::memory_order_acquire)) return false;
+		size_t count = m_workers.size();
+		size_t self = t_pool == this ? t_index : m_next.load(std::memory_order_relaxed) % count;
+		bool found = t_pool == this && pop(self, task);
+		for (size_t i = 1; !found && i <= count; ++i)
+			found = steal((self + i) % count, task);
+		// A victim that was locked may still hold work, so retry with blocking locks
+		for (size_t i = 0; !found && i < count; ++i)
+			found = pop((self + i) % count, task);
+		if (found) m_pending.fetch_sub(1, std::memory_order_relaxed);
+		return found;
+	}
+
+	inline void ThreadPool::run(size_t index) {
+		t_pool = this;
+		t_index = index;
+		Task task;
+		for (;;) {
+			if (take(task)) {
+				task();
+				task = nullptr;
+				continue;
+			}
+			std::unique_lock<std::mutex> lock(m_sleep_mutex);
+			m_wake.wait(lock, [this] { return m_stop || m_pending.load(std::memory_order_acquire); });
+			if (m_stop && !m_pending.load(std::memory_order_acquire)) return;
+		}
+	}
+
+	// TaskGroup
+
+	inline TaskGroup::TaskGroup(ThreadPool& pool) : m_pool(pool), m_outstanding(0) {}
+
+	// Tasks refer to the group, so it cannot go away while any are in flight
+	inline TaskGroup::~TaskGroup() {
+		join();
+	}
+
+	template<typename F>
+	void TaskGroup::run(F&& function) {
+		m_outstanding.fetch_add(1, std::memory_order_relaxed);
+		try {
+			m_pool.submit([this, function = std::forward<F>(function)]() mutable {
+				try {
+					function();
+					finish(nullptr);
+				}
+				catch (...) {
+					finish(std::current_exception());
+				}
+			});
+		}
+		catch (...) {
+			m_outstanding.fetch_sub(1, std::memory_order_relaxed);
+			throw;
+		}
+	}
+
+	inline void TaskGroup::wait() {
+		join();
+		std::exception_ptr error;
+		std::swap(error, m_error);
+		if (error) std::rethrow_exception(error);
+	}
+
+	// Sleeps only briefly between attempts at helping, since a task that becomes
+	// stealable while this thread is asleep would otherwise wait for a worker. Returns
+	// holding no lock but only after the last finish() released m_mutex.
+	inline void TaskGroup::join() noexcept {
+		for (;;) {
+			if (!m_outstanding.load(std::memory_order_acquire)) break;
+			if (m_pool.try_run_one()) continue;
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_done.wait_for(lock, std::chrono::microseconds(100),
+				[this] { return !m_outstanding.load(std::memory_order_acquire); });
+		}
+		std::lock_guard<std::mutex> lock(m_mutex);
+	}
+
+	inline void TaskGroup::finish(std::exception_ptr error) noexcept {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (error && !m_error) m_error = error;
+		if (m_outstanding.fetch_sub(1, std::memory_order_acq_rel) == 1) m_done.notify_all();
+	}
+}
\ No newline at end of file
@@ -1,76 +1,89 @@
 #pragma once
+#include <algorithm>
+#include <cmath>
 #include <functional>
 #include <initializer_list>
+#include <memory>
+#include <memory_resource>
+#include <tuple>
 #include <type_traits>
 #include <utility>
-#include "linked_list.h"
-#include "globals.h"
+#include "exception.h"
+#include "policy.h"
 
 
 namespace Containers {
+	template<typename Hash, typename Equal, typename Q, typename = void>
+	struct is_transparent_lookup : std::false_type {};
+
+	template<typename Hash, typename Equal, typename Q>
+	struct is_transparent_lookup<Hash, Equal, Q,
+		std::void_t<typename Hash::is_transparent, typename Equal::is_transparent>> : std::true_type {};
+
 	template<
 		typename K, typename V,
 		typename Hash = std::hash<K>,
-		typename Equal = std::equal_to<K>>
+		typename Equal = std::equal_to<K>,
+		typename Policy = DefaultHashPolicy,
+		typename Allocator = std::allocator<std::pair<const K, V>>>
 	class UnorderedMap {
 	private:
+		struct NodeBase;
 		struct MapNode;
+		using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<MapNode>;
+		using NodeTraits = std::allocator_traits<NodeAllocator>;
+		using BaseAllocator = typename NodeTraits::template rebind_alloc<NodeBase>;
+		using BaseTraits = std::allocator_traits<BaseAllocator>;
+		using BucketAllocator = typename NodeTraits::template rebind_alloc<std::pair<MapNode*, MapNode*>>;
+		using BucketTraits = std::allocator_traits<BucketAllocator>;
 	public:
-		//class Iterator;
 		using KV = std::pair<const K, V>;
-		using IRT = struct {
-			Iterator position;
-			bool inserted;
-			MapNode node;
-		};
 		using LL = std::pair<MapNode*, MapNode*>;
 
 		class Iterator;
 
-		UnorderedMap() : UnordereMap(Global::UNORDERED_MAP_INIT_BUCKET_COUNT) {}
+		struct IRT;
 
-		explicit UnorderedMap(size_t, const Hash& =Hash(), const Equal& =Equal());
+		UnorderedMap() : UnorderedMap(Policy::init_bucket_count) {}
 
-		UnorderedMap(size_t bucket_count) :
-			UnorderedMap(bucket_count, Hash(), Equal()) {}
+		explicit UnorderedMap(const Allocator& allocator) :
+			UnorderedMap(Policy::init_bucket_count, Hash(), Equal(), allocator) {}
 
-		template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
-		UnorderedMap(IT, IT, 
-			size_t = Global::UNORDERED_MAP_INIT_BUCKET_COUNT, 
-			const Hash& = Hash(), 
-			const Equal& = Equal());
-
-		template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
-		UnorderedMap(IT first, IT last, size_t bucket_count) :
-			UnorderedMap(first, last, bucket_count, Hash(), Equal()) {}
+		explicit UnorderedMap(size_t, const Hash& =Hash(), const Equal& =Equal(), const Allocator& =Allocator());
 
 		template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
-		UnorderedMap(IT first, IT last, size_t bucket_count, const Hash& hash) :
-			UnorderedMap(first, last, bucket_count, hash, Equal()) {}
+		UnorderedMap(IT, IT,
+			size_t = Policy::init_bucket_count,
+			const Hash& = Hash(),
+			const Equal& = Equal(),
+			const Allocator& = Allocator());
 
 		UnorderedMap(const UnorderedMap&);
 
+		UnorderedMap(const UnorderedMap&, const Allocator&);
+
 		UnorderedMap(UnorderedMap&&) noexcept;
 
+		UnorderedMap(UnorderedMap&&, const Allocator&);
+
 		UnorderedMap(std::initializer_list<KV>,
-			size_t = Global::UNORDERED_MAP_INIT_BUCKET_COUNT,
+			size_t = Policy::init_bucket_count,
 			const Hash& = Hash(),
-			const Equal& = Equal());
-
-		UnorderedMap(std::initializer_list<KV> il, size_t bucket_count) :
-			UnorderedMap(il, bucket_count, Hash(), Equal()) {}
-
-		UnorderedMap(std::initializer_list<KV> il, size_t bucket_count, const Hash& hash) :
-			UnorderedMap(il, bucket_count, hash, Equal()) {}
+			const Equal& = Equal(),
+			const Allocator& = Allocator());
 
 		~UnorderedMap();
 
 		UnorderedMap& operator=(const UnorderedMap&);
-		
-		UnorderedMap& operator=(UnorderedMap&&) noexcept;
-		
+
+		UnorderedMap& operator=(UnorderedMap&&) noexcept(
+			NodeTraits::propagate_on_container_move_assignment::value ||
+			NodeTraits::is_always_equal::value);
+
 		UnorderedMap& operator=(std::initializer_list<KV>);
 
+		Allocator get_allocator() const noexcept;
+
 		// Iterators
 
 		Iterator begin() noexcept;
@@ -109,7 +122,7 @@ namespace Containers {
 		void insert(std::initializer_list<KV>);
 
 		IRT insert(MapNode&&);
-		
+
 		Iterator insert(const Iterator, MapNode&&);
 
 		template <class M>
@@ -128,7 +141,7 @@ namespace Containers {
 		std::pair<Iterator, bool> emplace(Args&&...);
 
 		template<class...Args>
-		std::pair<Iterator, bool> emplace_hint(const Iterator, Args&&...);
+		Iterator emplace_hint(const Iterator, Args&&...);
 
 		template<class...Args>
 		std::pair<Iterator, bool> try_emplace(const K&, Args&&...);
@@ -142,37 +155,29 @@ namespace Containers {
 		template<class...Args>
 		Iterator try_emplace(const Iterator, K&&, Args&&...);
 
-		Iterator erase(Iterator);
-
 		Iterator erase(const Iterator);
 
 		Iterator erase(const Iterator, const Iterator);
 
 		size_t erase(const K&);
 
-		template<class Q, std::enable_if_t<Hash::is_transparent&& Equal::is_transparent>...>
+		template<class Q, std::enable_if_t<is_transparent_lookup<Hash, Equal, Q>::value>...>
 		size_t erase(Q&&);
 
 		void swap(UnorderedMap&) noexcept;
-			
+
 		MapNode extract(const Iterator);
-		
-		MapNode extract(const K&);
-		
-		template<class Q, std::enable_if_t<Hash::is_transparent&& Equal::is_transparent>...>
-		MapNode extract(Q&&);
 
-		template<class H2, class E2>
-		void merge(UnorderedMap<K, V, H2, E2>&);
+		MapNode extract(const K&);
 
-		template<class H2, class E2>
-		void merge(UnorderedMap<K, V, H2, E2>&&);
+		template<class Q, std::enable_if_t<is_transparent_lookup<Hash, Equal, Q>::value>...>
+		MapNode extract(Q&&);
 
-		template<class H2, class E2>
-		void merge(UnorderedMultiMap<K, V, H2, E2>&);
+		template<class H2, class E2, class P2, class A2>
+		void merge(UnorderedMap<K, V, H2, E2, P2, A2>&);
 
-		template<class H2, class E2>
-		void merge(UnorderedMultiMap<K, V, H2, E2>&&);
+		template<class H2, class E2, class P2, class A2>
+		void merge(UnorderedMap<K, V, H2, E2, P2, A2>&&);
 
 		// Look-Up
 		V& at(const K&);
@@ -185,33 +190,36 @@ namespace Containers {
 
 		size_t count(const K&) const;
 
-		template<class Q, std::enable_if_t<Hash::is_transparent&& Equal::is_transparent>...>
+		template<class Q, std::enable_if_t<is_transparent_lookup<Hash, Equal, Q>::value>...>
 		size_t count(const Q&) const;
 
 		Iterator find(const K&);
 
 		const Iterator find(const K&) const;
 
-		template<class Q, std::enable_if_t<Hash::is_transparent&& Equal::is_transparent>...>
+		template<class Q, std::enable_if_t<is_transparent_lookup<Hash, Equal, Q>::value>...>
 		Iterator find(const Q&);
 
-		template<class Q, std::enable_if_t<Hash::is_transparent&&Equal::is_transparent>...>
+		template<class Q, std::enable_if_t<is_transparent_lookup<Hash, Equal, Q>::value>...>
 		const Iterator find(const Q&) const;
 
 		bool contains(const K&) const;
 
-		template<class Q, std::enable_if_t<Hash::is_transparent&& Equal::is_transparent>...>
+		template<class Q, std::enable_if_t<is_transparent_lookup<Hash, Equal, Q>::value>...>
 		bool contains(const Q&) const;
 
-		std::pair<Iterator, Iterator> m_equal_range(const K&);
+		std::pair<Iterator, Iterator> equal_range(const K&);
+
+		std::pair<const Iterator, const Iterator> equal_range(const K&) const;
 
-		std::pair<const Iterator, const Iterator> m_equal_range(const K&) const;
+		template<class Q, std::enable_if_t<is_transparent_lookup<Hash, Equal, Q>::value>...>
+		std::pair<Iterator, Iterator> equal_range(const Q&);
 
-		template<class Q, std::enable_if_t<Hash::is_transparent&& Equal::is_transparent>...>
-		std::pair<Iterator, Iterator> m_equal_range(const Q&);
+		template<class Q, std::enable_if_t<is_transparent_lookup<Hash, Equal, Q>::value>...>
+		std::pair<const Iterator, const Iterator> equal_range(const Q&) const;
 
-		template<class Q, std::enable_if_t<Hash::is_transparent&& Equal::is_transparent>...>
-		std::pair<const Iterator, const Iterator> m_equal_range(const Q&) const;
+		// Bucket Interface
+		size_t bucket_count() const noexcept;
 
 		// Hash Policy
 		double load_factor() const;
@@ -230,20 +238,40 @@ namespace Containers {
 		Equal key_eq() const;
 
 	private:
-		//struct MapNode;
 		LL* m_buckets;
 		size_t m_bucket_count;
 		size_t m_size;
-		size_t m_begin_index;
+		NodeBase* m_head;
+		NodeBase* m_end;
 		double m_max_load_factor;
-		const Hash& m_hasher;
-		const Equal& m_equal;
+		Hash m_hasher;
+		Equal m_equal;
+		NodeAllocator m_allocator;
 
 		void allocate(size_t bucket_count);
 
-		size_t hash(const K&) const;
+		void deallocate() noexcept;
 
-		void insert_between(size_t, MapNode*, MapNode*, MapNode*);
+		template<class...Args>
+		MapNode* create_node(Args&&...);
+
+		void destroy_node(MapNode*) noexcept;
+
+		void swap_storage(UnorderedMap&) noexcept;
+
+		template<class Q>
+		size_t hash(const Q&) const;
+
+		template<class Q>
+		MapNode* find_node(const Q&) const;
+
+		std::pair<Iterator, bool> insert_node(MapNode*);
+
+		void link(MapNode*);
+
+		void insert_between(size_t, MapNode*, NodeBase*, NodeBase*);
+
+		void unlink(size_t, MapNode*);
 
 		Iterator erase(size_t, MapNode*);
 	};
@@ -258,15 +286,18 @@ namespace Containers {
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	class UnorderedMap<K, V, Hash, Equal>::Iterator {
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	class UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator {
 	public:
 		Iterator() : m_pointer(nullptr) {}
 
-		Iterator(ListNode* pointer) : m_pointer(pointer) {}
+		Iterator(NodeBase* pointer) : m_pointer(pointer) {}
 
 		Iterator(const Iterator& other) : m_pointer(other.m_pointer) {}
 
+		Iterator& operator=(const Iterator& other) = default;
+
 		bool operator==(const Iterator&) const;
 
 		bool operator!=(const Iterator&) const;
@@ -298,154 +329,249 @@ namespace Containers {
 		const KV* operator->() const;
 	private:
 		friend class UnorderedMap;
-		MapNode* m_pointer;
+		NodeBase* m_pointer;
 	};
 
+	// Links of the list threading every bucket; the end sentinel is a bare NodeBase, so
+	// the map never needs a default-constructed KV
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	struct UnorderedMap<K, V, Hash, Equal>::MapNode {
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	struct UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::NodeBase {
+		NodeBase* prev = nullptr;
+		NodeBase* next = nullptr;
+	};
+
+	template<
+		typename K, typename V,
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	struct UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::MapNode : NodeBase {
 		KV key_value;
-		MapNode* prev;
-		MapNode* next;
-		MapNode() : key_value(), prev(nullptr), next(nullptr) {}
-		MapNode(const KV& kv) : 
-			key_value(kv), prev(nullptr), next(nullptr) {}
-		MapNode(T&& kv) :
-			key_value(std::move(kv)), prev(nullptr), next(nullptr) {}
+		MapNode() : key_value() {}
+		MapNode(const MapNode& other) : key_value(other.key_value) {}
+		MapNode(MapNode&& other) : key_value(std::move(other.key_value)) {}
+		template<class...Args>
+		MapNode(std::in_place_t, Args&&...args) :
+			key_value(std::forward<Args>(args)...) {}
+	};
+
+	template<
+		typename K, typename V,
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	struct UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::IRT {
+		Iterator position;
+		bool inserted;
+		MapNode node;
 	};
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	UnorderedMap<K, V, Hash, Equal>::UnorderedMap(
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::UnorderedMap(
 		size_t bucket_count,
-		const Hash& m_hasher,
-		const Equal& m_equal) :
-		m_size(),
-		m_max_load_factor(Global::UNORDERED_MAP_INIT_LOAD_FACTOR),
-		m_hasher(m_hasher), m_equal(m_equal) {
+		const Hash& hasher,
+		const Equal& equal,
+		const Allocator& allocator) :
+		m_buckets(nullptr), m_bucket_count(0), m_size(0),
+		m_head(nullptr), m_end(nullptr),
+		m_max_load_factor(Policy::max_load_factor),
+		m_hasher(hasher), m_equal(equal), m_allocator(allocator) {
 		allocate(bucket_count);
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
 	template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
-	UnorderedMap<K, V, Hash, Equal>::UnorderedMap(
+	UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::UnorderedMap(
 		IT first, IT last,
 		size_t bucket_count,
-		const Hash& m_hasher,
-		const Equal& m_equal) :
-		m_size(),
-		m_max_load_factor(Global::UNORDERED_MAP_INIT_LOAD_FACTOR),
-		m_hasher(m_hasher), m_equal(m_equal) {
-		allocate(bucket_count);
+		const Hash& hasher,
+		const Equal& equal,
+		const Allocator& allocator) :
+		UnorderedMap(bucket_count, hasher, equal, allocator) {
 		insert(first, last);
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	UnorderedMap<K, V, Hash, Equal>::UnorderedMap(const UnorderedMap& other) :,
-		m_size(other.m_size),
-		m_hasher(other.m_hasher), m_equal(other.m_equal) {
-		allocate(other.m_bucket_count);
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::UnorderedMap(const UnorderedMap& other) :
+		UnorderedMap(other, NodeTraits::select_on_container_copy_construction(other.m_allocator)) {}
+
+
+	template<
+		typename K, typename V,
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::UnorderedMap(const UnorderedMap& other, const Allocator& allocator) :
+		UnorderedMap(other.m_bucket_count, other.m_hasher, other.m_equal, allocator) {
+		m_max_load_factor = other.m_max_load_factor;
 		insert(other.begin(), other.end());
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	UnorderedMap<K, V, Hash, Equal>::UnorderedMap(UnorderedMap&&) noexcept : 
-		m_buckets(std::move(other.m_buckets)),
-		m_bucket_count(std::move(other.m_bucket_count)),
-		m_size(std::move(other.m_size)),
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::UnorderedMap(UnorderedMap&& other) noexcept :
+		m_buckets(std::exchange(other.m_buckets, nullptr)),
+		m_bucket_count(std::exchange(other.m_bucket_count, 0)),
+		m_size(std::exchange(other.m_size, 0)),
+		m_head(std::exchange(other.m_head, nullptr)),
+		m_end(std::exchange(other.m_end, nullptr)),
+		m_max_load_factor(other.m_max_load_factor),
 		m_hasher(std::move(other.m_hasher)),
-		m_equal(std::move(other.m_equal)) {}
+		m_equal(std::move(other.m_equal)),
+		m_allocator(std::move(other.m_allocator)) {}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	UnorderedMap<K, V, Hash, Equal>::UnorderedMap(std::initializer_list<KV> il,
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::UnorderedMap(UnorderedMap&& other, const Allocator& allocator) :
+		m_buckets(nullptr), m_bucket_count(0), m_size(0),
+		m_head(nullptr), m_end(nullptr),
+		m_max_load_factor(other.m_max_load_factor),
+		m_hasher(other.m_hasher), m_equal(other.m_equal), m_allocator(allocator) {
+		if (m_allocator == other.m_allocator) {
+			swap_storage(other);
+			return;
+		}
+		// nodes from another resource cannot be adopted, so move the entries over
+		allocate(other.m_bucket_count);
+		try {
+			for (auto it = other.begin(); it != other.end(); ++it)
+				emplace(std::move(*it));
+		}
+		catch (...) {
+			clear();
+			deallocate();
+			throw;
+		}
+	}
+
+
+	template<
+		typename K, typename V,
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::UnorderedMap(std::initializer_list<KV> il,
 		size_t bucket_count,
-		const Hash& m_hasher,
-		const Equal& m_equal) :
-		m_size(), m_hasher(m_hasher), m_equal(m_equal) {
-		allocate(bucket_count);
+		const Hash& hasher,
+		const Equal& equal,
+		const Allocator& allocator) :
+		UnorderedMap(bucket_count, hasher, equal, allocator) {
 		insert(il);
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	UnorderedMap<K, V, Hash, Equal>::~UnorderedMap() {
-		erase(begin(), end());
-		delete[] m_buckets;
-		m_bucket_count = 0;
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::~UnorderedMap() {
+		clear();
+		deallocate();
 		m_size = 0;
 	}
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	UnorderedMap<K, V, Hash, Equal>& UnorderedMap<K, V, Hash, Equal>::operator=(const UnorderedMap& other) {
-		UnorderedMap<K, V, Hash, Equal> temp(other);
-		temp.swap(*this);
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	UnorderedMap<K, V, Hash, Equal, Policy, Allocator>& UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::operator=(const UnorderedMap& other) {
+		if (this == &other) return *this;
+		constexpr bool propagate = NodeTraits::propagate_on_container_copy_assignment::value;
+		UnorderedMap temp(other, Allocator(propagate ? other.m_allocator : m_allocator));
+		swap_storage(temp);
+		if constexpr (propagate) std::swap(m_allocator, temp.m_allocator);
 		return *this;
 	}
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	UnorderedMap<K, V, Hash, Equal>& UnorderedMap<K, V, Hash, Equal>::operator=(UnorderedMap&& other) noexcept {
-		other.swap(*this);
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	UnorderedMap<K, V, Hash, Equal, Policy, Allocator>& UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::operator=(UnorderedMap&& other) noexcept(
+		NodeTraits::propagate_on_container_move_assignment::value ||
+		NodeTraits::is_always_equal::value) {
+		if constexpr (NodeTraits::propagate_on_container_move_assignment::value) {
+			swap_storage(other);
+			std::swap(m_allocator, other.m_allocator);
+		}
+		else if constexpr (NodeTraits::is_always_equal::value) {
+			swap_storage(other);
+		}
+		else {
+			UnorderedMap temp(std::move(other), Allocator(m_allocator));
+			swap_storage(temp);
+		}
 		return *this;
 	}
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	UnorderedMap<K, V, Hash, Equal>& UnorderedMap<K, V, Hash, Equal>::operator=(std::initializer_list<KV> il) {
-		UnorderedMap<K, V, Hash, Equal> temp(il);
-		temp.swap(*this);
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	UnorderedMap<K, V, Hash, Equal, Policy, Allocator>& UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::operator=(std::initializer_list<KV> il) {
+		UnorderedMap temp(il, Policy::init_bucket_count, m_hasher, m_equal, Allocator(m_allocator));
+		swap_storage(temp);
 		return *this;
 	}
 
+
+	template<
+		typename K, typename V,
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	Allocator UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::get_allocator() const noexcept {
+		return Allocator(m_allocator);
+	}
+
 	// Iterators
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	bool UnorderedMap<K, V, Hash, Equal>::Iterator::operator==(const Iterator& other) const {
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	bool UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator::operator==(const Iterator& other) const {
 		return m_pointer == other.m_pointer;
 	}
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	bool UnorderedMap<K, V, Hash, Equal>::Iterator::operator!=(const Iterator& other) const {
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	bool UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator::operator!=(const Iterator& other) const {
 		return m_pointer != other.m_pointer;
 	}
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	typename UnorderedMap<K, V, Hash, Equal>::Iterator& UnorderedMap<K, V, Hash, Equal>::Iterator::operator++() {
-		if (!m_pointer->next) throw OutOfRangeException("LinkedList");
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator& UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator::operator++() {
+		if (!m_pointer->next) throw OutOfRangeException("UnorderedMap");
 		m_pointer = m_pointer->next;
 		return *this;
 	}
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	typename UnorderedMap<K, V, Hash, Equal>::Iterator UnorderedMap<K, V, Hash, Equal>::Iterator::operator++(int) {
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator::operator++(int) {
 		Iterator it = *this;
 		++(*this);
 		return it;
@@ -453,8 +579,9 @@ namespace Containers {
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	typename UnorderedMap<K, V, Hash, Equal>::Iterator UnorderedMap<K, V, Hash, Equal>::Iterator::operator+(int steps) const {
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator::operator+(int steps) const {
 		Iterator it = *this;
 		for (int i = 0; i < steps; ++i, ++it);
 		return it;
@@ -462,25 +589,28 @@ namespace Containers {
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	typename UnorderedMap<K, V, Hash, Equal>::Iterator& UnorderedMap<K, V, Hash, Equal>::Iterator::operator+=(int steps) {
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator& UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator::operator+=(int steps) {
 		*this = *this + steps;
 		return *this;
 	}
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	typename UnorderedMap<K, V, Hash, Equal>::Iterator& UnorderedMap<K, V, Hash, Equal>::Iterator::operator--() {
-		if (!m_pointer->prev) throw OutOfRangeException("LinkedList");
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator& UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator::operator--() {
+		if (!m_pointer->prev) throw OutOfRangeException("UnorderedMap");
 		m_pointer = m_pointer->prev;
 		return *this;
 	}
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	typename UnorderedMap<K, V, Hash, Equal>::Iterator UnorderedMap<K, V, Hash, Equal>::Iterator::operator--(int) {
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator::operator--(int) {
 		Iterator it = *this;
 		--(*this);
 		return it;
@@ -488,8 +618,9 @@ namespace Containers {
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	typename UnorderedMap<K, V, Hash, Equal>::Iterator UnorderedMap<K, V, Hash, Equal>::Iterator::operator-(int steps) const {
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator::operator-(int steps) const {
 		Iterator it = *this;
 		for (int i = 0; i < steps; ++i, --it);
 		return it;
@@ -497,171 +628,186 @@ namespace Containers {
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	typename UnorderedMap<K, V, Hash, Equal>::Iterator& UnorderedMap<K, V, Hash, Equal>::Iterator::operator-=(int steps) {
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator& UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator::operator-=(int steps) {
 		*this = *this - steps;
 		return *this;
 	}
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	size_t UnorderedMap<K, V, Hash, Equal>::Iterator::operator-(const Iterator& other) const {
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	size_t UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator::operator-(const Iterator& other) const {
 		size_t dis = 0;
-		for (Iterator it = other; it.m_pointer; ++it, ++dis) {
+		for (Iterator it = other; it.m_pointer; ++dis) {
 			if (m_pointer == it.m_pointer) return dis;
+			it.m_pointer = it.m_pointer->next;
 		}
-		throw InvalidIteratorException("LinkedList");
+		throw InvalidIteratorException("UnorderedMap");
 	}
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	UnorderedMap<K, V, Hash, Equal>::KV& UnorderedMap<K, V, Hash, Equal>::Iterator::operator*() {
-		return m_pointer->value;
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::KV& UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator::operator*() {
+		return static_cast<MapNode*>(m_pointer)->key_value;
 	}
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	const UnorderedMap<K, V, Hash, Equal>::KV& UnorderedMap<K, V, Hash, Equal>::Iterator::operator*() const {
-		return m_pointer->value;
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	const typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::KV& UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator::operator*() const {
+		return static_cast<const MapNode*>(m_pointer)->key_value;
 	}
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	UnorderedMap<K, V, Hash, Equal>::KV* UnorderedMap<K, V, Hash, Equal>::Iterator::operator->() {
-		return &(m_pointer->value);
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::KV* UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator::operator->() {
+		return &(static_cast<MapNode*>(m_pointer)->key_value);
 	}
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	const UnorderedMap<K, V, Hash, Equal>::KV* UnorderedMap<K, V, Hash, Equal>::Iterator::operator->() const {
-		return &(m_pointer->value);
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	const typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::KV* UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator::operator->() const {
+		return &(static_cast<const MapNode*>(m_pointer)->key_value);
 	}
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	typename UnorderedMap<K, V, Hash, Equal>::Iterator UnorderedMap<K, V, Hash, Equal>::begin() noexcept {
-		return Iterator(std::get<0>(m_buckets[m_begin_index]))
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::begin() noexcept {
+		return Iterator(m_head);
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	const typename UnorderedMap<K, V, Hash, Equal>::Iterator UnorderedMap<K, V, Hash, Equal>::begin() const noexcept {
-		return Iterator(std::get<0>(m_buckets[m_begin_index]))
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	const typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::begin() const noexcept {
+		return Iterator(m_head);
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	typename UnorderedMap<K, V, Hash, Equal>::Iterator UnorderedMap<K, V, Hash, Equal>::end() noexcept {
-		return Iterator(std::get<1>(m_buckets[m_bucket_count]))
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::end() noexcept {
+		return Iterator(m_end);
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	const typename UnorderedMap<K, V, Hash, Equal>::Iterator UnorderedMap<K, V, Hash, Equal>::end() const noexcept {
-		return Iterator(std::get<1>(m_buckets[m_bucket_count]))
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	const typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::end() const noexcept {
+		return Iterator(m_end);
 	}
 
 	// Capacity
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	bool UnorderedMap<K, V, Hash, Equal>::empty() const noexcept { return m_size; }
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	bool UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::empty() const noexcept { return m_size == 0; }
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	size_t UnorderedMap<K, V, Hash, Equal>::size() const noexcept { return m_size; }
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	size_t UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::size() const noexcept { return m_size; }
 
 	// Modifiers
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	void UnorderedMap<K, V, Hash, Equal>::clear() noexcept {
-		erase(begin(), end());
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	void UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::clear() noexcept {
+		for (NodeBase* node = m_head; node != m_end;) {
+			NodeBase* next = node->next;
+			destroy_node(static_cast<MapNode*>(node));
+			node = next;
+		}
+		std::fill_n(m_buckets, m_bucket_count, LL(nullptr, nullptr));
+		m_head = m_end;
+		if (m_end) m_end->prev = nullptr;
+		m_size = 0;
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	std::pair<typename UnorderedMap<K, V, Hash, Equal>::Iterator, bool> UnorderedMap<K, V, Hash, Equal>::insert(const KV& key_value) {
-		if (load_factor() >= m_max_load_factor)
-			rehash(m_bucket_count * Global::UNORDERED_MAP_RESIZE_FACTOR);
-		MapNode* new_node = new MapNode(key_value);
-		const auto& [key, val] = key_value;
-		Iterator pos = find(key);
-		if (pos != end()) {
-			delete new_node;
-			return { pos, false };
-		}
-		size_t bucket = hash(key);
-		auto [head, tail] = m_buckets[bucket];
-		insert_between(bucket, new_node, tail, tail->next);
-		return { Iterator(new_node), true };
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	std::pair<typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator, bool> UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::insert(const KV& key_value) {
+		return emplace(key_value);
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	std::pair<typename UnorderedMap<K, V, Hash, Equal>::Iterator, bool> UnorderedMap<K, V, Hash, Equal>::insert(KV&& key_value) {
-		return emplace(std::forward<KV>(key_value));
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	std::pair<typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator, bool> UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::insert(KV&& key_value) {
+		return emplace(std::move(key_value));
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
 	template<class P, std::enable_if_t<std::is_constructible<std::pair<const K, V>, P&&>::value>...>
-	std::pair<typename UnorderedMap<K, V, Hash, Equal>::Iterator, bool> UnorderedMap<K, V, Hash, Equal>::insert(P&& key_value) {
+	std::pair<typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator, bool> UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::insert(P&& key_value) {
 		return emplace(std::forward<P>(key_value));
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	typename UnorderedMap<K, V, Hash, Equal>::Iterator UnorderedMap<K, V, Hash, Equal>::insert(const Iterator pos, const KV& key_value) {
-		if (m_equal(pos->first, std::get<0>(key_value)))
-			return { pos, false };
-		return insert(key_value);
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::insert(const Iterator pos, const KV& key_value) {
+		return emplace_hint(pos, key_value);
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	typename UnorderedMap<K, V, Hash, Equal>::Iterator UnorderedMap<K, V, Hash, Equal>::insert(const Iterator pos, KV&& key_value) {
-		return emplace_hint(pos, std::forward<KV>(key_value));
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::insert(const Iterator pos, KV&& key_value) {
+		return emplace_hint(pos, std::move(key_value));
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
 	template<class P, std::enable_if_t<std::is_constructible<std::pair<const K, V>, P&&>::value>...>
-	typename UnorderedMap<K, V, Hash, Equal>::Iterator UnorderedMap<K, V, Hash, Equal>::insert(const Iterator pos, P&& key_value) {
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::insert(const Iterator pos, P&& key_value) {
 		return emplace_hint(pos, std::forward<P>(key_value));
 	}
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
 	template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
-	void UnorderedMap<K, V, Hash, Equal>::insert(IT first, IT last) {
+	void UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::insert(IT first, IT last) {
 		for (IT it = first; it != last; ++it) {
 			insert(*it);
 		}
@@ -670,170 +816,218 @@ namespace Containers {
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	void UnorderedMap<K, V, Hash, Equal>::insert(std::initializer_list<KV> il) {
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	void UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::insert(std::initializer_list<KV> il) {
 		return insert(il.begin(), il.end());
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	typename UnorderedMap<K, V, Hash, Equal>::IRT UnorderedMap<K, V, Hash, Equal>::insert(MapNode&&);
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::IRT UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::insert(MapNode&& node) {
+		Iterator pos = find(node.key_value.first);
+		if (pos != end()) return { pos, false, std::move(node) };
+		return { emplace(std::move(node.key_value)).first, true, MapNode() };
+	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	typename UnorderedMap<K, V, Hash, Equal>::Iterator UnorderedMap<K, V, Hash, Equal>::insert(const Iterator, MapNode&&);
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::insert(const Iterator pos, MapNode&& node) {
+		return emplace_hint(pos, std::move(node.key_value));
+	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
 	template <class M>
-	std::pair<typename UnorderedMap<K, V, Hash, Equal>::Iterator, bool> UnorderedMap<K, V, Hash, Equal>::insert_or_assign(const K&, M&&);
+	std::pair<typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator, bool> UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::insert_or_assign(const K& key, M&& value) {
+		if (MapNode* node = find_node(key)) {
+			node->key_value.second = std::forward<M>(value);
+			return { Iterator(node), false };
+		}
+		return emplace(key, std::forward<M>(value));
+	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
 	template <class M>
-	std::pair<typename UnorderedMap<K, V, Hash, Equal>::Iterator, bool> UnorderedMap<K, V, Hash, Equal>::insert_or_assign(K&&, M&&);
+	std::pair<typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator, bool> UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::insert_or_assign(K&& key, M&& value) {
+		if (MapNode* node = find_node(key)) {
+			node->key_value.second = std::forward<M>(value);
+			return { Iterator(node), false };
+		}
+		return emplace(std::move(key), std::forward<M>(value));
+	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
 	template <class M>
-	typename UnorderedMap<K, V, Hash, Equal>::Iterator UnorderedMap<K, V, Hash, Equal>::insert_or_assign(const Iterator, const K&, M&&);
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::insert_or_assign(const Iterator, const K& key, M&& value) {
+		return insert_or_assign(key, std::forward<M>(value)).first;
+	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
 	template <class M>
-	typename UnorderedMap<K, V, Hash, Equal>::Iterator UnorderedMap<K, V, Hash, Equal>::insert_or_assign(const Iterator, K&&, M&&);
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::insert_or_assign(const Iterator, K&& key, M&& value) {
+		return insert_or_assign(std::move(key), std::forward<M>(value)).first;
+	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
 	template<class...Args>
-	std::pair<typename UnorderedMap<K, V, Hash, Equal>::Iterator, bool> UnorderedMap<K, V, Hash, Equal>::emplace(Args&&...args) {
-		if (load_factor() >= m_max_load_factor)
-			rehash(m_bucket_count * Global::UNORDERED_MAP_RESIZE_FACTOR);
-		MapNode* new_node = new MapNode(std::forward<Args>(args)...);
-		const auto& [key, val] = new_node->key_value;
-		Iterator pos = find(key);
-		if (pos != end()) {
-			delete new_node;
-			return { pos, false };
-		}
-		size_t bucket = hash(key);
-		auto [head, tail] = m_buckets[bucket];
-		insert_between(bucket, new_node, tail, tail->next);
-		return { Iterator(new_node), true };
+	std::pair<typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator, bool> UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::emplace(Args&&...args) {
+		return insert_node(create_node(std::in_place, std::forward<Args>(args)...));
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
 	template<class...Args>
-	std::pair<typename UnorderedMap<K, V, Hash, Equal>::Iterator, bool> UnorderedMap<K, V, Hash, Equal>::emplace_hint(const Iterator pos, Args&&...args) {
-		return emplace(std::forward<Args>(args)...);
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::emplace_hint(const Iterator, Args&&...args) {
+		return emplace(std::forward<Args>(args)...).first;
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
 	template<class...Args>
-	std::pair<typename UnorderedMap<K, V, Hash, Equal>::Iterator, bool> UnorderedMap<K, V, Hash, Equal>::try_emplace(const K&, Args&&...);
+	std::pair<typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator, bool> UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::try_emplace(const K& key, Args&&...args) {
+		if (MapNode* node = find_node(key)) return { Iterator(node), false };
+		return emplace(std::piecewise_construct,
+			std::forward_as_tuple(key),
+			std::forward_as_tuple(std::forward<Args>(args)...));
+	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
 	template<class...Args>
-	std::pair<typename UnorderedMap<K, V, Hash, Equal>::Iterator, bool> UnorderedMap<K, V, Hash, Equal>::try_emplace(K&&, Args&&...);
+	std::pair<typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator, bool> UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::try_emplace(K&& key, Args&&...args) {
+		if (MapNode* node = find_node(key)) return { Iterator(node), false };
+		return emplace(std::piecewise_construct,
+			std::forward_as_tuple(std::move(key)),
+			std::forward_as_tuple(std::forward<Args>(args)...));
+	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
 	template<class...Args>
-	typename UnorderedMap<K, V, Hash, Equal>::Iterator UnorderedMap<K, V, Hash, Equal>::try_emplace(const Iterator, const K&, Args&&...);
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::try_emplace(const Iterator, const K& key, Args&&...args) {
+		return try_emplace(key, std::forward<Args>(args)...).first;
+	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
 	template<class...Args>
-	typename UnorderedMap<K, V, Hash, Equal>::Iterator UnorderedMap<K, V, Hash, Equal>::try_emplace(const Iterator, K&&, Args&&...);
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::try_emplace(const Iterator, K&& key, Args&&...args) {
+		return try_emplace(std::move(key), std::forward<Args>(args)...).first;
+	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	typename UnorderedMap<K, V, Hash, Equal>::Iterator UnorderedMap<K, V, Hash, Equal>::erase(Iterator pos) {
-		if (!pos.m_pointer) throw InvalidIteratorException("UnorderedMap");
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::erase(const Iterator pos) {
+		if (!pos.m_pointer || pos.m_pointer == m_end) throw InvalidIteratorException("UnorderedMap");
 		size_t bucket = hash(pos->first);
-		return erase(bucket, pos.m_pointer); 
+		return erase(bucket, static_cast<MapNode*>(pos.m_pointer));
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	typename UnorderedMap<K, V, Hash, Equal>::Iterator UnorderedMap<K, V, Hash, Equal>::erase(const Iterator pos) {
-		if (!pos.m_pointer) throw InvalidIteratorException("UnorderedMap");
-		size_t bucket = hash(pos->first);
-		return erase(bucket, pos.m_pointer);
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::erase(const Iterator first, const Iterator last) {
+		Iterator it = first;
+		while (it != last) {
+			it = erase(it);
+		}
+		return it;
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	typename UnorderedMap<K, V, Hash, Equal>::Iterator UnorderedMap<K, V, Hash, Equal>::erase(const Iterator first, const Iterator last) {
-		Iterator out = first;
-		for (Iterator it = first; it != last; ++it) {
-			out = erase(it);
-		}
-		return out;
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	size_t UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::erase(const K& key) {
+		MapNode* node = find_node(key);
+		if (!node) return 0;
+		erase(hash(key), node);
+		return 1;
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	size_t UnorderedMap<K, V, Hash, Equal>::erase(const K& key) {
-		if (!contains(key)) return 0;
-		erase(find(key));
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	template<class Q, std::enable_if_t<is_transparent_lookup<Hash, Equal, Q>::value>...>
+	size_t UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::erase(Q&& query) {
+		MapNode* node = find_node(query);
+		if (!node) return 0;
+		erase(hash(query), node);
 		return 1;
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	template<class Q, std::enable_if_t<Hash::is_transparent&& Equal::is_transparent>...>
-	size_t UnorderedMap<K, V, Hash, Equal>::erase(Q&& query) {
-		if (!contains(std::move(query))) return 0;
-		erase(find(std::move(query)));
-		return 1;
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	void UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::swap(UnorderedMap& other) noexcept {
+		swap_storage(other);
+		if constexpr (NodeTraits::propagate_on_container_swap::value)
+			std::swap(m_allocator, other.m_allocator);
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	void UnorderedMap<K, V, Hash, Equal>::swap(UnorderedMap& other) noexcept {
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	void UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::swap_storage(UnorderedMap& other) noexcept {
 		std::swap(m_buckets, other.m_buckets);
 		std::swap(m_bucket_count, other.m_bucket_count);
 		std::swap(m_size, other.m_size);
+		std::swap(m_head, other.m_head);
+		std::swap(m_end, other.m_end);
+		std::swap(m_max_load_factor, other.m_max_load_factor);
 		std::swap(m_hasher, other.m_hasher);
 		std::swap(m_equal, other.m_equal);
 	}
@@ -841,307 +1035,513 @@ namespace Containers {
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	typename UnorderedMap<K, V, Hash, Equal>::MapNode UnorderedMap<K, V, Hash, Equal>::extract(const Iterator);
-
-
-	template<
-		typename K, typename V,
-		typename Hash, typename Equal>
-	typename UnorderedMap<K, V, Hash, Equal>::MapNode UnorderedMap<K, V, Hash, Equal>::extract(const K&);
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::MapNode UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::extract(const Iterator pos) {
+		if (!pos.m_pointer || pos.m_pointer == m_end) throw InvalidIteratorException("UnorderedMap");
+		MapNode* node = static_cast<MapNode*>(pos.m_pointer);
+		MapNode out(std::move(*node));
+		erase(hash(node->key_value.first), node);
+		return out;
+	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	template<class Q, std::enable_if_t<Hash::is_transparent&& Equal::is_transparent>...>
-	typename UnorderedMap<K, V, Hash, Equal>::MapNode UnorderedMap<K, V, Hash, Equal>::extract(Q&&);
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::MapNode UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::extract(const K& key) {
+		return extract(find(key));
+	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	template<class H2, class E2>
-	void UnorderedMap<K, V, Hash, Equal>::merge(UnorderedMap<K, V, H2, E2>&);
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	template<class Q, std::enable_if_t<is_transparent_lookup<Hash, Equal, Q>::value>...>
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::MapNode UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::extract(Q&& query) {
+		return extract(find(query));
+	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	template<class H2, class E2>
-	void UnorderedMap<K, V, Hash, Equal>::merge(UnorderedMap<K, V, H2, E2>&&);
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	template<class H2, class E2, class P2, class A2>
+	void UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::merge(UnorderedMap<K, V, H2, E2, P2, A2>& source) {
+		for (auto it = source.begin(); it != source.end();) {
+			if (find_node(it->first)) {
+				++it;
+				continue;
+			}
+			emplace(std::move(*it));
+			it = source.erase(it);
+		}
+	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	template<class H2, class E2>
-	void UnorderedMap<K, V, Hash, Equal>::merge(UnorderedMultiMap<K, V, H2, E2>&);
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	template<class H2, class E2, class P2, class A2>
+	void UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::merge(UnorderedMap<K, V, H2, E2, P2, A2>&& source) {
+		merge(source);
+	}
 
+	// Look-Up
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	template<class H2, class E2>
-	void UnorderedMap<K, V, Hash, Equal>::merge(UnorderedMultiMap<K, V, H2, E2>&&);
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	V& UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::at(const K& key) {
+		MapNode* node = find_node(key);
+		if (!node) throw OutOfRangeException("UnorderedMap");
+		return node->key_value.second;
+	}
 
-	// Look-Up
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	V& UnorderedMap<K, V, Hash, Equal>::at(const K&);
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	const V& UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::at(const K& key) const {
+		MapNode* node = find_node(key);
+		if (!node) throw OutOfRangeException("UnorderedMap");
+		return node->key_value.second;
+	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	const V& UnorderedMap<K, V, Hash, Equal>::at(const K&) const;
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	V& UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::operator[](const K& key) {
+		return try_emplace(key).first->second;
+	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	V& UnorderedMap<K, V, Hash, Equal>::operator[](const K&);
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	V& UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::operator[](K&& key) {
+		return try_emplace(std::move(key)).first->second;
+	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	V& UnorderedMap<K, V, Hash, Equal>::operator[](K&&);
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	size_t UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::count(const K& key) const {
+		return find_node(key) ? 1 : 0;
+	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	size_t UnorderedMap<K, V, Hash, Equal>::count(const K&) const;
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	template<class Q, std::enable_if_t<is_transparent_lookup<Hash, Equal, Q>::value>...>
+	size_t UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::count(const Q& query) const {
+		return find_node(query) ? 1 : 0;
+	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	template<class Q, std::enable_if_t<Hash::is_transparent&& Equal::is_transparent>...>
-	size_t UnorderedMap<K, V, Hash, Equal>::count(const Q&) const;
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::find(const K& key) {
+		MapNode* node = find_node(key);
+		return node ? Iterator(node) : end();
+	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	typename UnorderedMap<K, V, Hash, Equal>::Iterator UnorderedMap<K, V, Hash, Equal>::find(const K& key) {
-		size_t bucket = hash(key);
-		auto [head, tail] = m_buckets[bucket];
-		return std::find_if(
-			Iterator(head), Iterator(tail ? tail->next : nullptr),
-			[this](const KV& key_value) {
-				m_equal(std::get<0>(key_value), key);
-			});
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	const typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::find(const K& key) const {
+		MapNode* node = find_node(key);
+		return node ? Iterator(node) : end();
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	const typename UnorderedMap<K, V, Hash, Equal>::Iterator UnorderedMap<K, V, Hash, Equal>::find(const K& key) const {
-		size_t bucket = hash(key);
-		auto [head, tail] = m_buckets[bucket];
-		return std::find_if(
-			Iterator(head), Iterator(tail ? tail->next : nullptr),
-			[this](const KV& key_value) {
-				m_equal(std::get<0>(key_value), key);
-			});
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	template<class Q, std::enable_if_t<is_transparent_lookup<Hash, Equal, Q>::value>...>
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::find(const Q& query) {
+		MapNode* node = find_node(query);
+		return node ? Iterator(node) : end();
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	template<class Q, std::enable_if_t<Hash::is_transparent&& Equal::is_transparent>...>
-	typename UnorderedMap<K, V, Hash, Equal>::Iterator UnorderedMap<K, V, Hash, Equal>::find(const Q& query) {
-		size_t bucket = hash(query);
-		auto [head, tail] = m_buckets[bucket];
-		return std::find_if(
-			Iterator(head), Iterator(tail ? tail->next : nullptr),
-			[this](const KV& key_value) {
-				m_equal(std::get<0>(key_value), query);
-			});
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	template<class Q, std::enable_if_t<is_transparent_lookup<Hash, Equal, Q>::value>...>
+	const typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::find(const Q& query) const {
+		MapNode* node = find_node(query);
+		return node ? Iterator(node) : end();
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	template<class Q, std::enable_if_t<Hash::is_transparent&& Equal::is_transparent>...>
-	const typename UnorderedMap<K, V, Hash, Equal>::Iterator UnorderedMap<K, V, Hash, Equal>::find(const Q& query) const {
-		size_t bucket = hash(query);
-		auto [head, tail] = m_buckets[bucket];
-		return std::find_if(
-			Iterator(head), Iterator(tail ? tail->next : nullptr),
-			[this](const KV& key_value) {
-				m_equal(std::get<0>(key_value), query);
-			});
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	bool UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::contains(const K& key) const {
+		return find_node(key) != nullptr;
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	bool UnorderedMap<K, V, Hash, Equal>::contains(const K& key) const {
-		return find(key) != end();
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	template<class Q, std::enable_if_t<is_transparent_lookup<Hash, Equal, Q>::value>...>
+	bool UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::contains(const Q& query) const {
+		return find_node(query) != nullptr;
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	template<class Q, std::enable_if_t<Hash::is_transparent&& Equal::is_transparent>...>
-	bool UnorderedMap<K, V, Hash, Equal>::contains(const Q& query) const {
-		return find(query) != end();
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	std::pair<typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator, typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator> UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::equal_range(const K& key) {
+		MapNode* node = find_node(key);
+		if (!node) return { end(), end() };
+		return { Iterator(node), Iterator(node->next) };
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	std::pair<typename UnorderedMap<K, V, Hash, Equal>::Iterator, typename UnorderedMap<K, V, Hash, Equal>::Iterator> UnorderedMap<K, V, Hash, Equal>::m_equal_range(const K&);
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	std::pair<const typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator, const typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator> UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::equal_range(const K& key) const {
+		MapNode* node = find_node(key);
+		if (!node) return { end(), end() };
+		return { Iterator(node), Iterator(node->next) };
+	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	std::pair<const typename UnorderedMap<K, V, Hash, Equal>::Iterator, const typename UnorderedMap<K, V, Hash, Equal>::Iterator> UnorderedMap<K, V, Hash, Equal>::m_equal_range(const K&) const;
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	template<class Q, std::enable_if_t<is_transparent_lookup<Hash, Equal, Q>::value>...>
+	std::pair<typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator, typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator> UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::equal_range(const Q& query) {
+		MapNode* node = find_node(query);
+		if (!node) return { end(), end() };
+		return { Iterator(node), Iterator(node->next) };
+	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	template<class Q, std::enable_if_t<Hash::is_transparent&& Equal::is_transparent>...>
-	std::pair<typename UnorderedMap<K, V, Hash, Equal>::Iterator, typename UnorderedMap<K, V, Hash, Equal>::Iterator> UnorderedMap<K, V, Hash, Equal>::m_equal_range(const Q&);
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	template<class Q, std::enable_if_t<is_transparent_lookup<Hash, Equal, Q>::value>...>
+	std::pair<const typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator, const typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator> UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::equal_range(const Q& query) const {
+		MapNode* node = find_node(query);
+		if (!node) return { end(), end() };
+		return { Iterator(node), Iterator(node->next) };
+	}
 
+	// Bucket Interface
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	template<class Q, std::enable_if_t<Hash::is_transparent&& Equal::is_transparent>...>
-	std::pair<const typename UnorderedMap<K, V, Hash, Equal>::Iterator, const typename UnorderedMap<K, V, Hash, Equal>::Iterator> UnorderedMap<K, V, Hash, Equal>::m_equal_range(const Q&) const;
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	size_t UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::bucket_count() const noexcept {
+		return m_bucket_count;
+	}
 
 	// Hash Policy
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	double UnorderedMap<K, V, Hash, Equal>::load_factor() const {
-		return m_size / m_bucket_count;
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	double UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::load_factor() const {
+		return m_bucket_count ? static_cast<double>(m_size) / m_bucket_count : 0.0;
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	double UnorderedMap<K, V, Hash, Equal>::max_load_factor() const {
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	double UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::max_load_factor() const {
 		return m_max_load_factor;
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	void UnorderedMap<K, V, Hash, Equal>::max_load_factor(double max_load_factor) {
-		if (max_load_factor <= 0) throw std::exception("Invalid Load Factor");
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	void UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::max_load_factor(double max_load_factor) {
+		if (max_load_factor <= 0) throw ContainerException("UnorderedMap", "Invalid Load Factor");
 		m_max_load_factor = max_load_factor;
 	}
 
 
+	// Relinks the existing nodes into a new bucket array; no node is copied or reallocated
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	void UnorderedMap<K, V, Hash, Equal>::rehash(size_t bucket_count) {
-		UnorderedMap<K, V, Hash, Equal> temp(begin(), end(), bucket_count, m_hasher, m_equal);
-		temp.swap(*this);
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	void UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::rehash(size_t bucket_count) {
+		size_t min_count = static_cast<size_t>(std::ceil(m_size / m_max_load_factor));
+		bucket_count = Policy::bucket_count(std::max(bucket_count, min_count));
+		if (bucket_count == m_bucket_count) return;
+
+		NodeBase* node = m_head;
+		allocate(bucket_count);
+
+		m_head = m_end;
+		m_end->prev = nullptr;
+		m_size = 0;
+		while (node && node != m_end) {
+			NodeBase* next = node->next;
+			link(static_cast<MapNode*>(node));
+			node = next;
+		}
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	void UnorderedMap<K, V, Hash, Equal>::reserve(size_t) {
-		rehash(ceil(m_size / m_max_load_factor));
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	void UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::reserve(size_t count) {
+		rehash(static_cast<size_t>(std::ceil(count / m_max_load_factor)));
 	}
 
 	// Observers
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	Hash UnorderedMap<K, V, Hash, Equal>::hash_function() const {
-		return m_hasher
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	Hash UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::hash_function() const {
+		return m_hasher;
 	}
 
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	Equal UnorderedMap<K, V, Hash, Equal>::key_eq() const {
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	Equal UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::key_eq() const {
 		return m_equal;
 	}
 
 	// Private Members
+	// Installs an empty bucket array, releasing the old one; the map is untouched if it throws
+	template<
+		typename K, typename V,
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	void UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::allocate(size_t bucket_count) {
+		bucket_count = Policy::bucket_count(bucket_count);
+		BucketAllocator bucket_allocator(m_allocator);
+		LL* buckets = BucketTraits::allocate(bucket_allocator, bucket_count);
+		std::uninitialized_fill_n(buckets, bucket_count, LL(nullptr, nullptr));
+		if (!m_end) {
+			BaseAllocator base_allocator(m_allocator);
+			try {
+				m_end = BaseTraits::allocate(base_allocator, 1);
+			}
+			catch (...) {
+				BucketTraits::deallocate(bucket_allocator, buckets, bucket_count);
+				throw;
+			}
+			BaseTraits::construct(base_allocator, m_end);
+			m_head = m_end;
+		}
+		if (m_buckets) BucketTraits::deallocate(bucket_allocator, m_buckets, m_bucket_count);
+		m_buckets = buckets;
+		m_bucket_count = bucket_count;
+	}
+
+	// Releases the bucket array and the end sentinel; the nodes must already be cleared
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	void UnorderedMap<K, V, Hash, Equal>::allocate(size_t bucket_count) {
-		m_buckets = new LL[bucket_count + 1];
-		m_bucket_count = bucket_count;
-		MapNode* tail = new MapNode();
-		m_buckets[bucket_count] = LL(tail, tail);
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	void UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::deallocate() noexcept {
+		if (m_buckets) {
+			BucketAllocator bucket_allocator(m_allocator);
+			BucketTraits::deallocate(bucket_allocator, m_buckets, m_bucket_count);
+		}
+		if (m_end) {
+			BaseAllocator base_allocator(m_allocator);
+			BaseTraits::destroy(base_allocator, m_end);
+			BaseTraits::deallocate(base_allocator, m_end, 1);
+		}
+		m_buckets = nullptr;
+		m_bucket_count = 0;
+		m_head = nullptr;
+		m_end = nullptr;
+	}
+
+	template<
+		typename K, typename V,
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	template<class...Args>
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::MapNode* UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::create_node(Args&&...args) {
+		MapNode* node = NodeTraits::allocate(m_allocator, 1);
+		try {
+			NodeTraits::construct(m_allocator, node, std::forward<Args>(args)...);
+		}
+		catch (...) {
+			NodeTraits::deallocate(m_allocator, node, 1);
+			throw;
+		}
+		return node;
+	}
+
+	template<
+		typename K, typename V,
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	void UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::destroy_node(MapNode* node) noexcept {
+		NodeTraits::destroy(m_allocator, node);
+		NodeTraits::deallocate(m_allocator, node, 1);
+	}
+
+	template<
+		typename K, typename V,
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	template<class Q>
+	size_t UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::hash(const Q& key) const {
+		return Policy::index(m_hasher(key), m_bucket_count);
+	}
+
+	template<
+		typename K, typename V,
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	template<class Q>
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::MapNode* UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::find_node(const Q& key) const {
+		if (!m_bucket_count) return nullptr;
+		auto [head, tail] = m_buckets[hash(key)];
+		for (MapNode* node = head; node; node = node == tail ? nullptr : static_cast<MapNode*>(node->next)) {
+			if (m_equal(node->key_value.first, key)) return node;
+		}
+		return nullptr;
 	}
 
+	// Links new_node into its bucket unless the key is already present, in which case the
+	// node is released and the existing entry returned
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	size_t UnorderedMap<K, V, Hash, Equal>::hash(const K& key) const {
-		return m_hasher(key) % m_bucket_count;
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	std::pair<typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator, bool> UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::insert_node(MapNode* new_node) {
+		if (MapNode* node = find_node(new_node->key_value.first)) {
+			destroy_node(new_node);
+			return { Iterator(node), false };
+		}
+		if (m_size + 1 > m_bucket_count * m_max_load_factor)
+			rehash(std::max(Policy::grow(m_bucket_count), Policy::init_bucket_count));
+		link(new_node);
+		return { Iterator(new_node), true };
 	}
 
+	// Appends node to its bucket's run, or starts a new run at the front of the list
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	void UnorderedMap<K, V, Hash, Equal>::insert_between(
-		size_t bucket, 
-		MapNode* new_node, 
-		MapNode* prev, 
-		MapNode* next) {
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	void UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::link(MapNode* node) {
+		size_t bucket = hash(node->key_value.first);
+		MapNode* tail = m_buckets[bucket].second;
+		if (tail)
+			insert_between(bucket, node, tail, tail->next);
+		else
+			insert_between(bucket, node, nullptr, m_head);
+	}
+
+	template<
+		typename K, typename V,
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	void UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::insert_between(
+		size_t bucket,
+		MapNode* new_node,
+		NodeBase* prev,
+		NodeBase* next) {
 		new_node->prev = prev;
 		new_node->next = next;
 		auto &[head, tail] = m_buckets[bucket];
 		if (prev) prev->next = new_node;
-		if (!prev || next == head) head = new_node;
-		if (next) next->prev = new_node;
-		if (!next || prev == tail) tail = new_node;
+		else m_head = new_node;
+		next->prev = new_node;
+		if (!head) head = new_node;
+		if (!tail || tail == prev) tail = new_node;
 		++m_size;
 	}
 
 	template<
 		typename K, typename V,
-		typename Hash, typename Equal>
-	typename UnorderedMap<K, V, Hash, Equal>::Iterator UnorderedMap<K, V, Hash, Equal>::erase(size_t bucket, MapNode* node) {
-		if (!node) throw OutOfRangeException("UnorderedMap");
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	void UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::unlink(size_t bucket, MapNode* node) {
 		auto& [head, tail] = m_buckets[bucket];
-		if (node->prev)
-			node->prev->next = node->next;
-		if (node == head) {
-			head = node->next;
-			head->prev = node->prev;
+		if (node == head && node == tail) {
+			head = nullptr;
+			tail = nullptr;
 		}
-		if (node->next)
-			node->next->prev = node->prev;
-		if (node == tail) {
-			tail = node->prev;
-			tail->next = node->next;
+		else if (node == head) {
+			head = static_cast<MapNode*>(node->next);
 		}
-		MapNode* next = node->next;
-		delete node;
+		else if (node == tail) {
+			tail = static_cast<MapNode*>(node->prev);
+		}
+		if (node->prev)
+			node->prev->next = node->next;
+		else
+			m_head = node->next;
+		node->next->prev = node->prev;
 		--m_size;
+	}
+
+	template<
+		typename K, typename V,
+		typename Hash, typename Equal,
+		typename Policy, typename Allocator>
+	typename UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::Iterator UnorderedMap<K, V, Hash, Equal, Policy, Allocator>::erase(size_t bucket, MapNode* node) {
+		if (!node) throw OutOfRangeException("UnorderedMap");
+		NodeBase* next = node->next;
+		unlink(bucket, node);
+		destroy_node(node);
 		return Iterator(next);
 	}
 
+
+	namespace pmr {
+		template<
+			typename K, typename V,
+			typename Hash = std::hash<K>,
+			typename Equal = std::equal_to<K>,
+			typename Policy = DefaultHashPolicy>
+		using UnorderedMap = Containers::UnorderedMap<K, V, Hash, Equal, Policy,
+			std::pmr::polymorphic_allocator<std::pair<const K, V>>>;
+	}
 }
\ No newline at end of file
@@ -2,588 +2,336 @@
 #include <algorithm>
 #include <initializer_list>
 #include <iostream>
+#include <memory>
+#include <memory_resource>
 #include <type_traits>
 #include <utility>
-#include "globals.h"
+#include "aligned_allocator.h"
 #include "exception.h"
+#include "expression.h"
+#include "policy.h"
+#include "relocate.h"
+#include "simd.h"
+#include "vector_base.h"
 
 namespace Containers {
 
-	template<typename T>
-	class Vector {
+	template<typename T, typename Growth = DefaultGrowth, typename Allocator = std::allocator<T>>
+	class Vector : public VectorBase<Vector<T, Growth, Allocator>, T, VectorStorage<T, Growth, Allocator>> {
+		using Base = VectorBase<Vector<T, Growth, Allocator>, T, VectorStorage<T, Growth, Allocator>>;
+		using AllocTraits = std::allocator_traits<Allocator>;
 	public:
+		using typename Base::Iterator;
+
 		Vector() noexcept;
 
-		explicit Vector(size_t);
+		explicit Vector(const Allocator&) noexcept;
+
+		explicit Vector(size_t, const Allocator& = Allocator());
 
-		Vector(size_t, const T&);
+		Vector(size_t, const T&, const Allocator& = Allocator());
 
 		template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
-		Vector(IT, IT);
+		Vector(IT, IT, const Allocator& = Allocator());
 
 		Vector(const Vector&);
 
+		Vector(const Vector&, const Allocator&);
+
 		Vector(Vector&&) noexcept;
 
-		Vector(std::initializer_list<T>);
+		Vector(Vector&&, const Allocator&);
+
+		Vector(std::initializer_list<T>, const Allocator& = Allocator());
+
+		template<class E, std::enable_if_t<is_vector_expression_v<E>>...>
+		Vector(const E&, const Allocator& = Allocator());
 
 		~Vector();
 
 		Vector& operator=(const Vector&);
 
-		Vector& operator=(Vector&&) noexcept;
+		Vector& operator=(Vector&&) noexcept(
+			AllocTraits::propagate_on_container_move_assignment::value ||
+			AllocTraits::is_always_equal::value);
 
 		Vector& operator=(std::initializer_list<T>);
 
-		// Element Access
-		T& at(size_t);
-
-		const T& at(size_t) const;
-
-		T& operator[](size_t);
-
-		const T& operator[](size_t) const;
-
-		T& front();
-
-		const T& front() const;
-
-		T& back();
-
-		const T& back() const;
-
-		T* data() noexcept;
-
-		const T* data() const noexcept;
+		template<class E, std::enable_if_t<is_vector_expression_v<E>>...>
+		Vector& operator=(const E&);
 
 		// Capacity
-		bool empty() const noexcept;
-
-		size_t size() const noexcept;
-
 		void reserve(size_t);
 
-		size_t capacity() const;
-
 		void shrink_to_fit();
 
-		// Iterators
-		class Iterator;
-
-		Iterator begin() noexcept;
-
-		const Iterator begin() const noexcept;
-
-		Iterator end() noexcept;
-
-		const Iterator end() const noexcept;
-
-		Iterator find(const T&) const;
-
 		// Modifiers
-		void clear() noexcept;
-
-		template<typename...Args>
-		Iterator emplace(const Iterator, Args&&...);
-
-		Iterator insert(const Iterator, const T&);
-
-		Iterator insert(const Iterator, T&&);
-
-		void insert(const Iterator, size_t, const T&);
-
-		template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
-		void insert(const Iterator, IT, IT);
-
-		void insert(const Iterator, std::initializer_list<T>);
-
-		Iterator erase(const Iterator);
-
-		Iterator erase(const Iterator, const Iterator);
-
-		void push_back(const T&);
-
-		void push_back(T&&);
-
-		template<typename...Args>
-		void emplace_back(Args&&...);
-
-		void pop_back();
-
-		void resize(size_t);
-
-		void resize(size_t, const T&);
-
 		void swap(Vector& other) noexcept;
 
 	private:
-		T* m_data;
-		size_t m_size;
-		size_t m_capacity;
-
-		void allocate(size_t);
-	};
-
-	template<typename T>
-	class Vector<T>::Iterator {
-	public:
-		Iterator() : m_pointer(nullptr) {}
-
-		Iterator(T* pointer) : m_pointer(pointer) {}
+		friend Base;
 
-		Iterator(const Iterator& other) : m_pointer(other.m_pointer) {}
+		// Reads bitwise elements straight into spare capacity
+		template<typename, typename>
+		friend struct Serializer;
 
-		bool operator==(const Iterator&) const;
+		static constexpr const char* name = "Vector";
 
-		bool operator!=(const Iterator&) const;
+		using Base::m_allocator;
+		using Base::m_data;
+		using Base::m_size;
+		using Base::m_capacity;
+		using Base::construct;
+		using Base::construct_n;
+		using Base::destroy;
+		using Base::grow_capacity;
 
-		Iterator& operator++();
+		T* allocate(size_t);
 
-		Iterator operator++(int);
+		void deallocate(T*, size_t) noexcept;
 
-		Iterator operator+(int) const;
+		bool reallocate(size_t) noexcept;
 
-		Iterator& operator+=(int);
-
-		Iterator& operator--();
-
-		Iterator operator--(int);
-
-		Iterator operator-(int) const;
-
-		Iterator& operator-=(int);
-
-		size_t operator-(const Iterator&) const;
-
-		T& operator*();
-
-		const T& operator*() const;
-
-		T* operator->();
-
-		const T* operator->() const;
-
-	private:
-		T* m_pointer;
+		void swap_storage(Vector&) noexcept;
 	};
 
+	template<typename T, typename Growth, typename Allocator>
+	Vector<T, Growth, Allocator>::Vector() noexcept : Base(Allocator()) {}
 
-	template<typename T>
-	Vector<T>::Vector() noexcept :
-		m_data(nullptr), m_size(0), m_capacity(Global::VECTOR_INIT_SIZE) {
-		allocate(Global::VECTOR_INIT_SIZE);
-	}
+	template<typename T, typename Growth, typename Allocator>
+	Vector<T, Growth, Allocator>::Vector(const Allocator& allocator) noexcept : Base(allocator) {}
 
-	template<typename T>
-	Vector<T>::Vector(size_t size) :
-		m_size(size), m_capacity(size) {
-		allocate(size);
+	template<typename T, typename Growth, typename Allocator>
+	Vector<T, Growth, Allocator>::Vector(size_t size, const Allocator& allocator) : Base(allocator) {
+		m_data = allocate(size);
+		m_capacity = size;
+		try {
+			construct_n(m_data, size);
+		}
+		catch (...) {
+			deallocate(m_data, m_capacity);
+			throw;
+		}
+		m_size = size;
 	}
 
-	template<typename T>
-	Vector<T>::Vector(size_t size, const T& init_val) :
-		m_size(size), m_capacity(size) {
-		allocate(size);
-		std::fill_n(m_data, size, init_val);
+	template<typename T, typename Growth, typename Allocator>
+	Vector<T, Growth, Allocator>::Vector(size_t size, const T& init_val, const Allocator& allocator) : Base(allocator) {
+		m_data = allocate(size);
+		m_capacity = size;
+		try {
+			construct_n(m_data, size, init_val);
+		}
+		catch (...) {
+			deallocate(m_data, m_capacity);
+			throw;
+		}
+		m_size = size;
 	}
 
-	template<typename T>
+	template<typename T, typename Growth, typename Allocator>
 	template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
-	Vector<T>::Vector(IT first, IT last) :
-		m_size(last - first), m_capacity(last - first) {
-		allocate(last - first);
-		std::copy(first, last, m_data);
-	}
-
-	template<typename T>
-	Vector<T>::Vector(const Vector& other) :
-		Vector(other.begin(), other.end()) {}
-
-	template<typename T>
-	Vector<T>::Vector(Vector&& other) noexcept :
-		m_size(std::move(other.m_size)), 
-		m_capacity(std::move(other.m_capacity)), 
-		m_data(std::move(other.m_data)) {}
-
-	template<typename T>
-	Vector<T>::Vector(std::initializer_list<T> il) :
-		Vector(il.begin(), il.end()) {}
-
-	template<typename T>
-	Vector<T>::~Vector() {
-		delete[] m_data;
-		m_capacity = 0;
-		m_size = 0;
-	}
-
-	template<typename T>
-	Vector<T>& Vector<T>::operator=(const Vector& other) {
-		Vector<T> temp(other);
-		temp.swap(*this);
-		return *this;
-	}
-
-	template<typename T>
-	Vector<T>& Vector<T>::operator=(Vector&& other) noexcept {
-		other.swap(*this);
-		return *this;
-	}
-
-	template<typename T>
-	Vector<T>& Vector<T>::operator=(std::initializer_list<T> il) {
-		Vector<T> temp(il);
-		temp.swap(*this);
-		return *this;
-	}
-
-	// Element Access
-	template<typename T>
-	T& Vector<T>::at(size_t pos) {
-		if (pos >= m_size) throw OutOfRangeException("Vector");
-		return m_data[pos];
-	}
-
-	template<typename T>
-	const T& Vector<T>::at(size_t pos) const {
-		if (pos >= m_size) throw OutOfRangeException("Vector");
-		return m_data[pos];
-	}
-
-	template<typename T>
-	T& Vector<T>::operator[](size_t pos) {
-		return m_data[pos];
-	}
-
-	template<typename T>
-	const T& Vector<T>::operator[](size_t pos) const {
-		return m_data[pos];
-	}
-
-	template<typename T>
-	T& Vector<T>::front() {
-		if (!m_size) throw OutOfRangeException("Vector");
-		return m_data[0];
-	}
-
-	template<typename T>
-	const T& Vector<T>::front() const {
-		if (!m_size) throw OutOfRangeException("Vector");
-		return m_data[0];
-	}
-
-	template<typename T>
-	T& Vector<T>::back() {
-		if (!m_size) throw OutOfRangeException("Vector");
-		return m_data[m_size - 1];
-	}
-
-	template<typename T>
-	const T& Vector<T>::back() const {
-		if (!m_size) throw OutOfRangeException("Vector");
-		return m_data[m_size - 1];
+	Vector<T, Growth, Allocator>::Vector(IT first, IT last, const Allocator& allocator) : Base(allocator) {
+		m_data = allocate(last - first);
+		m_capacity = last - first;
+		try {
+			for (T* dest = m_data; first != last; ++first, ++dest, ++m_size)
+				construct(dest, *first);
+		}
+		catch (...) {
+			destroy(m_data, m_data + m_size);
+			deallocate(m_data, m_capacity);
+			throw;
+		}
 	}
 
-	template<typename T>
-	T* Vector<T>::data() noexcept { return m_data; };
+	template<typename T, typename Growth, typename Allocator>
+	Vector<T, Growth, Allocator>::Vector(const Vector& other) :
+		Vector(other, AllocTraits::select_on_container_copy_construction(other.m_allocator)) {}
 
-	template<typename T>
-	const T* Vector<T>::data() const noexcept { return m_data; };
+	template<typename T, typename Growth, typename Allocator>
+	Vector<T, Growth, Allocator>::Vector(const Vector& other, const Allocator& allocator) :
+		Vector(other.begin(), other.end(), allocator) {}
 
-	// Iterators
-	template<typename T>
-	bool Vector<T>::Iterator::operator==(const Iterator& other) const {
-		return m_pointer == other.m_pointer;
+	template<typename T, typename Growth, typename Allocator>
+	Vector<T, Growth, Allocator>::Vector(Vector&& other) noexcept : Base(std::move(other.m_allocator)) {
+		swap_storage(other);
 	}
 
-	template<typename T>
-	bool Vector<T>::Iterator::operator!=(const Iterator& other) const {
-		return m_pointer != other.m_pointer;
+	template<typename T, typename Growth, typename Allocator>
+	Vector<T, Growth, Allocator>::Vector(Vector&& other, const Allocator& allocator) : Base(allocator) {
+		if (m_allocator == other.m_allocator) {
+			swap_storage(other);
+			return;
+		}
+		// storage from another resource cannot be adopted, so move element-wise
+		reserve(other.m_size);
+		try {
+			for (; m_size < other.m_size; ++m_size)
+				construct(m_data + m_size, std::move(other.m_data[m_size]));
+		}
+		catch (...) {
+			destroy(m_data, m_data + m_size);
+			deallocate(m_data, m_capacity);
+			throw;
+		}
 	}
 
-	template<typename T>
-	typename Vector<T>::Iterator& Vector<T>::Iterator::operator++() {
-		++m_pointer;
-		return *this;
-	}
+	template<typename T, typename Growth, typename Allocator>
+	Vector<T, Growth, Allocator>::Vector(std::initializer_list<T> il, const Allocator& allocator) :
+		Vector(il.begin(), il.end(), allocator) {}
 
-	template<typename T>
-	typename Vector<T>::Iterator Vector<T>::Iterator::operator++(int) {
-		Iterator it = *this;
-		++(*this);
-		return it;
+	// Evaluates an element-wise expression straight into new storage in one fused pass,
+	// without default-constructing the elements first
+	template<typename T, typename Growth, typename Allocator>
+	template<class E, std::enable_if_t<is_vector_expression_v<E>>...>
+	Vector<T, Growth, Allocator>::Vector(const E& source, const Allocator& allocator) : Base(allocator) {
+		static_assert(std::is_arithmetic_v<T>, "only a Vector of arithmetic elements can hold an expression");
+		m_data = allocate(source.size());
+		m_size = source.size();
+		m_capacity = source.size();
+		expression::evaluate(source, m_data);
 	}
 
-	template<typename T>
-	typename Vector<T>::Iterator Vector<T>::Iterator::operator+(int steps) const {
-		Iterator it = *this;
-		it.m_pointer += steps;
-		return it;
+	template<typename T, typename Growth, typename Allocator>
+	Vector<T, Growth, Allocator>::~Vector() {
+		destroy(m_data, m_data + m_size);
+		deallocate(m_data, m_capacity);
+		m_capacity = 0;
+		m_size = 0;
 	}
 
-	template<typename T>
-	typename Vector<T>::Iterator& Vector<T>::Iterator::operator+=(int steps) {
-		m_pointer += steps;
+	template<typename T, typename Growth, typename Allocator>
+	Vector<T, Growth, Allocator>& Vector<T, Growth, Allocator>::operator=(const Vector& other) {
+		if (this == &other) return *this;
+		constexpr bool propagate = AllocTraits::propagate_on_container_copy_assignment::value;
+		Vector temp(other, propagate ? other.m_allocator : m_allocator);
+		swap_storage(temp);
+		if constexpr (propagate) std::swap(m_allocator, temp.m_allocator);
 		return *this;
 	}
 
-	template<typename T>
-	typename Vector<T>::Iterator& Vector<T>::Iterator::operator--() {
-		--m_pointer;
+	template<typename T, typename Growth, typename Allocator>
+	Vector<T, Growth, Allocator>& Vector<T, Growth, Allocator>::operator=(Vector&& other) noexcept(
+		AllocTraits::propagate_on_container_move_assignment::value ||
+		AllocTraits::is_always_equal::value) {
+		constexpr bool propagate = AllocTraits::propagate_on_container_move_assignment::value;
+		Vector temp(std::move(other), propagate ? other.m_allocator : m_allocator);
+		swap_storage(temp);
+		if constexpr (propagate) std::swap(m_allocator, temp.m_allocator);
 		return *this;
 	}
 
-	template<typename T>
-	typename Vector<T>::Iterator Vector<T>::Iterator::operator--(int) {
-		Iterator it = *this;
-		--(*this);
-		return it;
-	}
-
-	template<typename T>
-	typename Vector<T>::Iterator Vector<T>::Iterator::operator-(int steps) const {
-		Iterator it = *this;
-		it.m_pointer -= steps;
-		return it;
-	}
-
-	template<typename T>
-	typename Vector<T>::Iterator& Vector<T>::Iterator::operator-=(int steps) {
-		m_pointer -= steps;
+	template<typename T, typename Growth, typename Allocator>
+	Vector<T, Growth, Allocator>& Vector<T, Growth, Allocator>::operator=(std::initializer_list<T> il) {
+		Vector temp(il, m_allocator);
+		swap_storage(temp);
 		return *this;
 	}
 
-	template<typename T>
-	size_t Vector<T>::Iterator::operator-(const Iterator& other) const {
-		return m_pointer - other.m_pointer;
-	}
-
-	template<typename T>
-	T& Vector<T>::Iterator::operator*() {
-		return *m_pointer;
-	}
-
-	template<typename T>
-	const T& Vector<T>::Iterator::operator*() const {
-		return *m_pointer;
-	}
-
-	template<typename T>
-	T* Vector<T>::Iterator::operator->() {
-		return m_pointer;
-	}
-
-	template<typename T>
-	const T* Vector<T>::Iterator::operator->() const {
-		return m_pointer;
-	}
-
-	template<typename T>
-	typename Vector<T>::Iterator Vector<T>::begin() noexcept {
-		return Iterator(m_data);
-	}
-
-	template<typename T>
-	const typename Vector<T>::Iterator Vector<T>::begin() const noexcept {
-		return Iterator(m_data);
-	}
-
-	template<typename T>
-	typename Vector<T>::Iterator Vector<T>::end() noexcept {
-		return Iterator(m_data + m_size);
-	}
-
-	template<typename T>
-	const typename Vector<T>::Iterator Vector<T>::end() const noexcept {
-		return Iterator(m_data + m_size);
-	}
-
-	template<typename T>
-	typename Vector<T>::Iterator Vector<T>::find(const T& value) const {
-		for (Iterator it = begin(); it != end(); ++it) {
-			if (*it == value) return it;
+	// Same-sized results are written over the current elements, which is safe even when the
+	// expression reads this Vector
+	template<typename T, typename Growth, typename Allocator>
+	template<class E, std::enable_if_t<is_vector_expression_v<E>>...>
+	Vector<T, Growth, Allocator>& Vector<T, Growth, Allocator>::operator=(const E& source) {
+		if (source.size() == m_size) {
+			expression::evaluate(source, m_data);
+			return *this;
 		}
-		return end();
+		Vector temp(source, m_allocator);
+		swap_storage(temp);
+		return *this;
 	}
 
 	// Capacity
-	template<typename T>
-	bool Vector<T>::empty() const noexcept { return m_size == 0; }
-
-	template<typename T>
-	size_t Vector<T>::size() const noexcept { return m_size; }
-
-	template<typename T>
-	void Vector<T>::reserve(size_t capacity) {
-		if (capacity <= m_capacity) return;
-		T* new_data = new T[capacity];
-
-		std::copy(m_data, m_data + m_capacity, new_data);
+	template<typename T, typename Growth, typename Allocator>
+	void Vector<T, Growth, Allocator>::reserve(size_t capacity) {
+		if (capacity <= m_capacity || reallocate(capacity)) return;
+		T* new_data = allocate(capacity);
+		try {
+			relocate(m_allocator, m_data, m_size, new_data);
+		}
+		catch (...) {
+			deallocate(new_data, capacity);
+			throw;
+		}
 
 		std::swap(m_capacity, capacity);
 		std::swap(m_data, new_data);
 
-		delete[] new_data;
+		deallocate(new_data, capacity);
 	}
 
-	template<typename T>
-	size_t Vector<T>::capacity() const { return m_capacity; }
-
-	template<typename T>
-	void Vector<T>::shrink_to_fit() {
-		T* new_data = new T[m_size];
-
-		std::copy(m_data, m_data + m_size, new_data);
+	template<typename T, typename Growth, typename Allocator>
+	void Vector<T, Growth, Allocator>::shrink_to_fit() {
+		if (m_size == m_capacity || reallocate(m_size)) return;
+		T* new_data = allocate(m_size);
+		try {
+			relocate(m_allocator, m_data, m_size, new_data);
+		}
+		catch (...) {
+			deallocate(new_data, m_size);
+			throw;
+		}
 
 		std::swap(m_data, new_data);
+		deallocate(new_data, m_capacity);
 		m_capacity = m_size;
-
-		delete[] new_data;
 	}
 
 	// Modifiers
-	template<typename T>
-	void Vector<T>::clear() noexcept {
-		m_size = 0;
-	}
-
-	template<typename T>
-	void Vector<T>::push_back(const T& value) {
-		if (m_size == m_capacity) {
-			reserve(m_capacity * Global::VECTOR_RESIZE_FACTOR);
-		}
-		m_data[m_size] = value;
-		++m_size;
-	}
-
-	template<typename T>
-	void Vector<T>::push_back(T&& value) {
-		emplace_back(std::move(value));
-	}
-
-	template<typename T>
-	template<typename...Args>
-	void Vector<T>::emplace_back(Args&&... args) {
-		if (m_size == m_capacity) {
-			reserve(m_capacity * Global::VECTOR_RESIZE_FACTOR);
-		}
-		m_data[m_size] = T(std::forward<Args>(args)...);
-		++m_size;
+	template<typename T, typename Growth, typename Allocator>
+	void Vector<T, Growth, Allocator>::swap(Vector& other) noexcept {
+		swap_storage(other);
+		if constexpr (AllocTraits::propagate_on_container_swap::value)
+			std::swap(m_allocator, other.m_allocator);
 	}
 
-	template<typename T>
-	void Vector<T>::pop_back() {
-		if (m_size > 0) --m_size;
-		else throw OutOfRangeException("Vector");
-	}
-
-	template<typename T>
-	template<typename...Args>
-	typename Vector<T>::Iterator Vector<T>::emplace(const Iterator pos, Args&&...args) {
-		if (m_size == m_capacity) {
-			reserve(m_size + 1);
-		}
-		size_t start = pos - begin();
-		if (start >= m_size) throw InvalidIteratorException("Vector");
-		for (size_t i = m_size; i > start; --i) {
-			m_data[i] = m_data[i - 1];
-		}
-		*pos = T(std::forward<Args>(args)...);
-		++m_size;
-		return pos;
-	}
-
-	template<typename T>
-	typename Vector<T>::Iterator Vector<T>::insert(const Iterator pos, const T& value) {
-		insert(pos, (size_t) 1, value);
-		return pos;
-	}
-
-	template<typename T>
-	typename Vector<T>::Iterator Vector<T>::insert(const Iterator pos, T&& value) {
-		return emplace(pos, std::move(value));
-	}
-
-	template<typename T>
-	void Vector<T>::insert(const Iterator pos, size_t n, const T& value) {
-		size_t start = pos - begin();
-		if (m_size + n > m_capacity) {
-			reserve(m_size + n);
-		}
-		if (start > m_size) throw InvalidIteratorException("Vector");
-
-		std::copy_n(m_data + start, m_size - start, m_data + start + n);
-		std::fill_n(m_data + start, n, value);
-
-		m_size += n;
-	}
-
-	template<typename T> 
-	template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
-	void Vector<T>::insert(const Iterator pos, IT first, IT last) {
-		size_t n = last - first;
-		size_t start = pos - begin();
-		size_t fi = &(*first) - m_data, la = &(*last) - m_data;
-		if (m_size + n > m_capacity) {
-			reserve(m_size + n);
+	// Private Members
+	template<typename T, typename Growth, typename Allocator>
+	T* Vector<T, Growth, Allocator>::allocate(size_t size) {
+		return size ? AllocTraits::allocate(m_allocator, size) : nullptr;
+	}
+
+	template<typename T, typename Growth, typename Allocator>
+	void Vector<T, Growth, Allocator>::deallocate(T* data, size_t size) noexcept {
+		if (data) AllocTraits::deallocate(m_allocator, data, size);
+	}
+
+	// Lets an allocator with a reallocate hook move the elements to a block of the new
+	// capacity itself (mremap for HugePageAllocator); false when it declines
+	template<typename T, typename Growth, typename Allocator>
+	bool Vector<T, Growth, Allocator>::reallocate(size_t capacity) noexcept {
+		if constexpr (is_trivially_relocatable_v<T> && has_reallocate_v<Allocator>) {
+			if (!m_data || !capacity) return false;
+			T* new_data = m_allocator.reallocate(m_data, m_capacity, capacity);
+			if (!new_data) return false;
+			m_data = new_data;
+			m_capacity = capacity;
+			return true;
 		}
-		if (start > m_size) throw InvalidIteratorException("Vector");
-
-		std::copy_n(m_data + start, m_size - start, m_data + start + n);
-		if (typeid(IT) == typeid(Iterator) && fi <= m_size && la <= m_size) {
-			for (size_t i = fi; i < la; ++i) {
-				m_data[start + i - fi] = m_data[i < start ? i : i + n];
-			}
+		else {
+			return false;
 		}
-		else
-			std::copy(first, last, m_data + start);
-		m_size += n;
-	}
-
-	template<typename T>
-	void Vector<T>::insert(const Iterator pos, std::initializer_list<T> il) {
-		insert(pos, il.begin(), il.end());
-	}
-
-	template<typename T>
-	typename Vector<T>::Iterator Vector<T>::erase(const Iterator pos) {
-		return erase(pos, pos + 1);
 	}
 
-	template<typename T>
-	typename Vector<T>::Iterator Vector<T>::erase(const Iterator first, const Iterator last) {
-		if (first == last) return last;
-		size_t start = first - begin(), end = last - begin();
-		if (start > m_size || end > m_size) throw InvalidIteratorException("Vector");
-		for (size_t i = end; i < m_size; ++i) {
-			m_data[i - end + start] = m_data[i];
-		}
-		m_size -= end - start;
-		return Iterator(m_data + start);
-	}
-
-	template<typename T>
-	void Vector<T>::resize(size_t size) {
-		resize(size, T());
-	}
-
-	template<typename T>
-	void Vector<T>::resize(size_t size, const T& value) {
-		if (size < m_size)
-			erase(begin() + static_cast<int>(size), end());
-		else if (size > m_size)
-			insert(end(), size - m_size, value);
-	}
-
-	template<typename T>
-	void Vector<T>::swap(Vector& other) noexcept {
+	template<typename T, typename Growth, typename Allocator>
+	void Vector<T, Growth, Allocator>::swap_storage(Vector& other) noexcept {
 		std::swap(m_size, other.m_size);
 		std::swap(m_capacity, other.m_capacity);
 		std::swap(m_data, other.m_data);
 	}
 
-	// Private Members
-	template<typename T>
-	void Vector<T>::allocate(size_t size) {
-		m_data = new T[size];
+	template<typename T, typename Growth, typename Allocator>
+	struct is_numeric_container<Vector<T, Growth, Allocator>> : std::is_arithmetic<T> {};
+
+	// A Vector whose data() is aligned to Alignment bytes and whose storage is padded to a
+	// multiple of it, so SIMD kernels can use aligned loads and run past size() unmasked
+	template<typename T, size_t Alignment = 64, typename Growth = DefaultGrowth>
+	using AlignedVector = Vector<T, Growth, AlignedAllocator<T, Alignment>>;
+
+	namespace pmr {
+		template<typename T, typename Growth = DefaultGrowth>
+		using Vector = Containers::Vector<T, Growth, std::pmr::polymorphic_allocator<T>>;
 	}
 }
\ No newline at end of file
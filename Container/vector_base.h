@@ -0,0 +1,672 @@
+#pragma once
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "exception.h"
+#include "relocate.h"
+#include "simd.h"
+
+namespace Containers {
+
+	// Iterator over contiguous elements, shared by Vector, SmallVector and StaticVector
+	template<typename T>
+	class VectorIterator {
+	public:
+		constexpr VectorIterator() : m_pointer(nullptr) {}
+
+		constexpr VectorIterator(T* pointer) : m_pointer(pointer) {}
+
+		constexpr VectorIterator(const VectorIterator& other) : m_pointer(other.m_pointer) {}
+
+		constexpr VectorIterator& operator=(const VectorIterator&) = default;
+
+		constexpr bool operator==(const VectorIterator&) const;
+
+		constexpr bool operator!=(const VectorIterator&) const;
+
+		constexpr VectorIterator& operator++();
+
+		constexpr VectorIterator operator++(int);
+
+		constexpr VectorIterator operator+(int) const;
+
+		constexpr VectorIterator& operator+=(int);
+
+		constexpr VectorIterator& operator--();
+
+		constexpr VectorIterator operator--(int);
+
+		constexpr VectorIterator operator-(int) const;
+
+		constexpr VectorIterator& operator-=(int);
+
+		constexpr size_t operator-(const VectorIterator&) const;
+
+		constexpr T& operator*();
+
+		constexpr const T& operator*() const;
+
+		constexpr T* operator->();
+
+		constexpr const T* operator->() const;
+
+	private:
+		T* m_pointer;
+	};
+
+	// Storage policy for VectorBase: a buffer from Allocator, grown as Growth directs.
+	// Vector and SmallVector keep their elements here; StaticVector has its own storage
+	// inside the object. A storage provides m_size, data(), capacity(), construct(),
+	// destroy() and grow_capacity().
+	template<typename T, typename Growth, typename Allocator>
+	class VectorStorage {
+	public:
+		Allocator get_allocator() const noexcept;
+
+		T* data() noexcept;
+
+		const T* data() const noexcept;
+
+		size_t capacity() const noexcept;
+
+	protected:
+		using AllocTraits = std::allocator_traits<Allocator>;
+
+		Allocator m_allocator;
+		T* m_data;
+		size_t m_size;
+		size_t m_capacity;
+
+		explicit VectorStorage(const Allocator&) noexcept;
+
+		template<typename...Args>
+		void construct(T*, Args&&...);
+
+		void destroy(T*, T*) noexcept;
+
+		size_t grow_capacity(size_t) const noexcept;
+	};
+
+	// Everything Vector, SmallVector and StaticVector do to their elements alike: access,
+	// search, insert, erase and the shifts behind them. Storage says where the elements
+	// live and how they are built. Derived provides reserve(size_t), which moves the
+	// elements into a buffer of at least that capacity or throws when it cannot, and a
+	// name for exceptions; it handles construction, assignment and swapping itself. Every
+	// member is constexpr so that StaticVector stays usable in constant expressions.
+	template<typename Derived, typename T, typename Storage>
+	class VectorBase : public Storage {
+	public:
+		using Iterator = VectorIterator<T>;
+
+		using Storage::data;
+
+		using Storage::capacity;
+
+		// Element Access
+		constexpr T& at(size_t);
+
+		constexpr const T& at(size_t) const;
+
+		constexpr T& operator[](size_t);
+
+		constexpr const T& operator[](size_t) const;
+
+		constexpr T& front();
+
+		constexpr const T& front() const;
+
+		constexpr T& back();
+
+		constexpr const T& back() const;
+
+		// Capacity
+		constexpr bool empty() const noexcept;
+
+		constexpr size_t size() const noexcept;
+
+		// Iterators
+		constexpr Iterator begin() noexcept;
+
+		constexpr const Iterator begin() const noexcept;
+
+		constexpr Iterator end() noexcept;
+
+		constexpr const Iterator end() const noexcept;
+
+		constexpr Iterator find(const T&) const;
+
+		constexpr size_t count(const T&) const;
+
+		constexpr bool contains(const T&) const;
+
+		// Modifiers
+		constexpr void clear() noexcept;
+
+		template<typename...Args>
+		constexpr Iterator emplace(const Iterator, Args&&...);
+
+		constexpr Iterator insert(const Iterator, const T&);
+
+		constexpr Iterator insert(const Iterator, T&&);
+
+		constexpr void insert(const Iterator, size_t, const T&);
+
+		template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
+		constexpr void insert(const Iterator, IT, IT);
+
+		constexpr void insert(const Iterator, std::initializer_list<T>);
+
+		constexpr Iterator erase(const Iterator);
+
+		constexpr Iterator erase(const Iterator, const Iterator);
+
+		constexpr void push_back(const T&);
+
+		constexpr void push_back(T&&);
+
+		template<typename...Args>
+		constexpr void emplace_back(Args&&...);
+
+		constexpr void pop_back();
+
+		constexpr void resize(size_t);
+
+		constexpr void resize(size_t, const T&);
+
+	protected:
+		using Storage::Storage;
+
+		using Storage::m_size;
+		using Storage::construct;
+		using Storage::destroy;
+		using Storage::grow_capacity;
+
+		template<typename...Args>
+		constexpr void construct_n(T*, size_t, const Args&...);
+
+		constexpr void make_room(size_t);
+
+		constexpr void shift_right(size_t, size_t, size_t);
+
+		constexpr void shift_left(size_t, size_t, size_t) noexcept;
+
+	private:
+		constexpr Derived& derived() noexcept;
+	};
+
+	// VectorIterator
+	template<typename T>
+	constexpr bool VectorIterator<T>::operator==(const VectorIterator& other) const {
+		return m_pointer == other.m_pointer;
+	}
+
+	template<typename T>
+	constexpr bool VectorIterator<T>::operator!=(const VectorIterator& other) const {
+		return m_pointer != other.m_pointer;
+	}
+
+	template<typename T>
+	constexpr VectorIterator<T>& VectorIterator<T>::operator++() {
+		++m_pointer;
+		return *this;
+	}
+
+	template<typename T>
+	constexpr VectorIterator<T> VectorIterator<T>::operator++(int) {
+		VectorIterator it = *this;
+		++(*this);
+		return it;
+	}
+
+	template<typename T>
+	constexpr VectorIterator<T> VectorIterator<T>::operator+(int steps) const {
+		VectorIterator it = *this;
+		it.m_pointer += steps;
+		return it;
+	}
+
+	template<typename T>
+	constexpr VectorIterator<T>& VectorIterator<T>::operator+=(int steps) {
+		m_pointer += steps;
+		return *this;
+	}
+
+	template<typename T>
+	constexpr VectorIterator<T>& VectorIterator<T>::operator--() {
+		--m_pointer;
+		return *this;
+	}
+
+	template<typename T>
+	constexpr VectorIterator<T> VectorIterator<T>::operator--(int) {
+		VectorIterator it = *this;
+		--(*this);
+		return it;
+	}
+
+	template<typename T>
+	constexpr VectorIterator<T> VectorIterator<T>::operator-(int steps) const {
+		VectorIterator it = *this;
+		it.m_pointer -= steps;
+		return it;
+	}
+
+	template<typename T>
+	constexpr VectorIterator<T>& VectorIterator<T>::operator-=(int steps) {
+		m_pointer -= steps;
+		return *this;
+	}
+
+	template<typename T>
+	constexpr size_t VectorIterator<T>::operator-(const VectorIterator& other) const {
+		return m_pointer - other.m_pointer;
+	}
+
+	template<typename T>
+	constexpr T& VectorIterator<T>::operator*() {
+		return *m_pointer;
+	}
+
+	template<typename T>
+	constexpr const T& VectorIterator<T>::operator*() const {
+		return *m_pointer;
+	}
+
+	template<typename T>
+	constexpr T* VectorIterator<T>::operator->() {
+		return m_pointer;
+	}
+
+	template<typename T>
+	constexpr const T* VectorIterator<T>::operator->() const {
+		return m_pointer;
+	}
+
+	// VectorStorage
+	template<typename T, typename Growth, typename Allocator>
+	VectorStorage<T, Growth, Allocator>::VectorStorage(const Allocator& allocator) noexcept :
+		m_allocator(allocator), m_data(nullptr), m_size(0), m_capacity(0) {}
+
+	template<typename T, typename Growth, typename Allocator>
+	Allocator VectorStorage<T, Growth, Allocator>::get_allocator() const noexcept {
+		return m_allocator;
+	}
+
+	template<typename T, typename Growth, typename Allocator>
+	T* VectorStorage<T, Growth, Allocator>::data() noexcept { return m_data; }
+
+	template<typename T, typename Growth, typename Allocator>
+	const T* VectorStorage<T, Growth, Allocator>::data() const noexcept { return m_data; }
+
+	template<typename T, typename Growth, typename Allocator>
+	size_t VectorStorage<T, Growth, Allocator>::capacity() const noexcept { return m_capacity; }
+
+	template<typename T, typename Growth, typename Allocator>
+	template<typename...Args>
+	void VectorStorage<T, Growth, Allocator>::construct(T* dest, Args&&...args) {
+		AllocTraits::construct(m_allocator, dest, std::forward<Args>(args)...);
+	}
+
+	template<typename T, typename Growth, typename Allocator>
+	void VectorStorage<T, Growth, Allocator>::destroy(T* first, T* last) noexcept {
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			for (; first != last; ++first)
+				AllocTraits::destroy(m_allocator, first);
+		}
+	}
+
+	// Capacity to grow to when at least required slots are needed, as chosen by the
+	// Growth policy so that repeated insertions stay amortized O(1)
+	template<typename T, typename Growth, typename Allocator>
+	size_t VectorStorage<T, Growth, Allocator>::grow_capacity(size_t required) const noexcept {
+		return Growth::grow(m_capacity, required);
+	}
+
+	// Element Access
+	template<typename Derived, typename T, typename Storage>
+	constexpr T& VectorBase<Derived, T, Storage>::at(size_t pos) {
+		if (pos >= m_size) throw OutOfRangeException(Derived::name);
+		return data()[pos];
+	}
+
+	template<typename Derived, typename T, typename Storage>
+	constexpr const T& VectorBase<Derived, T, Storage>::at(size_t pos) const {
+		if (pos >= m_size) throw OutOfRangeException(Derived::name);
+		return data()[pos];
+	}
+
+	template<typename Derived, typename T, typename Storage>
+	constexpr T& VectorBase<Derived, T, Storage>::operator[](size_t pos) {
+		return data()[pos];
+	}
+
+	template<typename Derived, typename T, typename Storage>
+	constexpr const T& VectorBase<Derived, T, Storage>::operator[](size_t pos) const {
+		return data()[pos];
+	}
+
+	template<typename Derived, typename T, typename Storage>
+	constexpr T& VectorBase<Derived, T, Storage>::front() {
+		if (!m_size) throw OutOfRangeException(Derived::name);
+		return data()[0];
+	}
+
+	template<typename Derived, typename T, typename Storage>
+	constexpr const T& VectorBase<Derived, T, Storage>::front() const {
+		if (!m_size) throw OutOfRangeException(Derived::name);
+		return data()[0];
+	}
+
+	template<typename Derived, typename T, typename Storage>
+	constexpr T& VectorBase<Derived, T, Storage>::back() {
+		if (!m_size) throw OutOfRangeException(Derived::name);
+		return data()[m_size - 1];
+	}
+
+	template<typename Derived, typename T, typename Storage>
+	constexpr const T& VectorBase<Derived, T, Storage>::back() const {
+		if (!m_size) throw OutOfRangeException(Derived::name);
+		return data()[m_size - 1];
+	}
+
+	// Capacity
+	template<typename Derived, typename T, typename Storage>
+	constexpr bool VectorBase<Derived, T, Storage>::empty() const noexcept { return m_size == 0; }
+
+	template<typename Derived, typename T, typename Storage>
+	constexpr size_t VectorBase<Derived, T, Storage>::size() const noexcept { return m_size; }
+
+	// Iterators
+	template<typename Derived, typename T, typename Storage>
+	constexpr typename VectorBase<Derived, T, Storage>::Iterator VectorBase<Derived, T, Storage>::begin() noexcept {
+		return Iterator(data());
+	}
+
+	template<typename Derived, typename T, typename Storage>
+	constexpr const typename VectorBase<Derived, T, Storage>::Iterator VectorBase<Derived, T, Storage>::begin() const noexcept {
+		return Iterator(const_cast<T*>(data()));
+	}
+
+	template<typename Derived, typename T, typename Storage>
+	constexpr typename VectorBase<Derived, T, Storage>::Iterator VectorBase<Derived, T, Storage>::end() noexcept {
+		return Iterator(data() + m_size);
+	}
+
+	template<typename Derived, typename T, typename Storage>
+	constexpr const typename VectorBase<Derived, T, Storage>::Iterator VectorBase<Derived, T, Storage>::end() const noexcept {
+		return Iterator(const_cast<T*>(data()) + m_size);
+	}
+
+	// Arithmetic element types are searched with the widest SIMD kernel the CPU supports
+	template<typename Derived, typename T, typename Storage>
+	constexpr typename VectorBase<Derived, T, Storage>::Iterator VectorBase<Derived, T, Storage>::find(const T& value) const {
+		if constexpr (simd::is_searchable_v<T>) {
+			if (!std::is_constant_evaluated())
+				return Iterator(const_cast<T*>(data()) + simd::find(data(), m_size, value));
+		}
+		for (Iterator it = begin(); it != end(); ++it) {
+			if (*it == value) return it;
+		}
+		return end();
+	}
+
+	template<typename Derived, typename T, typename Storage>
+	constexpr size_t VectorBase<Derived, T, Storage>::count(const T& value) const {
+		if constexpr (simd::is_searchable_v<T>) {
+			if (!std::is_constant_evaluated())
+				return simd::count(data(), m_size, value);
+		}
+		size_t count = 0;
+		for (size_t i = 0; i < m_size; ++i)
+			count += data()[i] == value;
+		return count;
+	}
+
+	template<typename Derived, typename T, typename Storage>
+	constexpr bool VectorBase<Derived, T, Storage>::contains(const T& value) const {
+		return find(value) != end();
+	}
+
+	// Modifiers
+	template<typename Derived, typename T, typename Storage>
+	constexpr void VectorBase<Derived, T, Storage>::clear() noexcept {
+		destroy(data(), data() + m_size);
+		m_size = 0;
+	}
+
+	template<typename Derived, typename T, typename Storage>
+	constexpr void VectorBase<Derived, T, Storage>::push_back(const T& value) {
+		emplace_back(value);
+	}
+
+	template<typename Derived, typename T, typename Storage>
+	constexpr void VectorBase<Derived, T, Storage>::push_back(T&& value) {
+		emplace_back(std::move(value));
+	}
+
+	template<typename Derived, typename T, typename Storage>
+	template<typename...Args>
+	constexpr void VectorBase<Derived, T, Storage>::emplace_back(Args&&... args) {
+		if (m_size == capacity()) {
+			// args may refer into the current buffer, so build the value before it moves
+			T value(std::forward<Args>(args)...);
+			make_room(1);
+			construct(data() + m_size, std::move(value));
+		}
+		else {
+			construct(data() + m_size, std::forward<Args>(args)...);
+		}
+		++m_size;
+	}
+
+	template<typename Derived, typename T, typename Storage>
+	constexpr void VectorBase<Derived, T, Storage>::pop_back() {
+		if (!m_size) throw OutOfRangeException(Derived::name);
+		destroy(data() + m_size - 1, data() + m_size);
+		--m_size;
+	}
+
+	template<typename Derived, typename T, typename Storage>
+	template<typename...Args>
+	constexpr typename VectorBase<Derived, T, Storage>::Iterator VectorBase<Derived, T, Storage>::emplace(const Iterator pos, Args&&...args) {
+		size_t start = pos - begin();
+		if (start > m_size) throw InvalidIteratorException(Derived::name);
+		T value(std::forward<Args>(args)...);
+		make_room(1);
+		shift_right(start, m_size, 1);
+		construct(data() + start, std::move(value));
+		++m_size;
+		return Iterator(data() + start);
+	}
+
+	template<typename Derived, typename T, typename Storage>
+	constexpr typename VectorBase<Derived, T, Storage>::Iterator VectorBase<Derived, T, Storage>::insert(const Iterator pos, const T& value) {
+		size_t start = pos - begin();
+		insert(pos, (size_t) 1, value);
+		return Iterator(data() + start);
+	}
+
+	template<typename Derived, typename T, typename Storage>
+	constexpr typename VectorBase<Derived, T, Storage>::Iterator VectorBase<Derived, T, Storage>::insert(const Iterator pos, T&& value) {
+		return emplace(pos, std::move(value));
+	}
+
+	template<typename Derived, typename T, typename Storage>
+	constexpr void VectorBase<Derived, T, Storage>::insert(const Iterator pos, size_t n, const T& value) {
+		size_t start = pos - begin();
+		if (start > m_size) throw InvalidIteratorException(Derived::name);
+		if (!n) return;
+		const T copy(value);
+		make_room(n);
+
+		shift_right(start, m_size, n);
+		try {
+			construct_n(data() + start, n, copy);
+		}
+		catch (...) {
+			shift_left(start + n, m_size + n, n);
+			throw;
+		}
+
+		m_size += n;
+	}
+
+	// A range from this vector is read by index, since growing and shifting move it
+	template<typename Derived, typename T, typename Storage>
+	template<class IT, std::enable_if_t<!std::is_integral<IT>::value>...>
+	constexpr void VectorBase<Derived, T, Storage>::insert(const Iterator pos, IT first, IT last) {
+		size_t n = last - first;
+		size_t start = pos - begin();
+		if (start > m_size) throw InvalidIteratorException(Derived::name);
+		if (!n) return;
+		size_t source = m_size;
+		if constexpr (std::is_same_v<IT, Iterator> || std::is_convertible_v<IT, const T*>) {
+			const T* pointer = &(*first);
+			if (std::is_constant_evaluated()) {
+				// ordering unrelated pointers is not a constant expression, equality is
+				for (size_t i = 0; i < m_size && source == m_size; ++i) {
+					if (pointer == data() + i) source = i;
+				}
+			}
+			else if (pointer >= data() && pointer < data() + m_size) {
+				source = pointer - data();
+			}
+		}
+		make_room(n);
+
+		shift_right(start, m_size, n);
+		size_t built = 0;
+		try {
+			if (source < m_size) {
+				// elements from start on now sit n slots higher, the gap is never read
+				for (; built < n; ++built) {
+					size_t from = source + built;
+					construct(data() + start + built, data()[from < start ? from : from + n]);
+				}
+			}
+			else {
+				for (; first != last; ++first, ++built)
+					construct(data() + start + built, *first);
+			}
+		}
+		catch (...) {
+			destroy(data() + start, data() + start + built);
+			shift_left(start + n, m_size + n, n);
+			throw;
+		}
+		m_size += n;
+	}
+
+	template<typename Derived, typename T, typename Storage>
+	constexpr void VectorBase<Derived, T, Storage>::insert(const Iterator pos, std::initializer_list<T> il) {
+		insert(pos, il.begin(), il.end());
+	}
+
+	template<typename Derived, typename T, typename Storage>
+	constexpr typename VectorBase<Derived, T, Storage>::Iterator VectorBase<Derived, T, Storage>::erase(const Iterator pos) {
+		return erase(pos, pos + 1);
+	}
+
+	template<typename Derived, typename T, typename Storage>
+	constexpr typename VectorBase<Derived, T, Storage>::Iterator VectorBase<Derived, T, Storage>::erase(const Iterator first, const Iterator last) {
+		if (first == last) return last;
+		size_t start = first - begin(), end = last - begin();
+		if (start > end || end > m_size) throw InvalidIteratorException(Derived::name);
+		if constexpr (is_trivially_relocatable_v<T>) {
+			destroy(data() + start, data() + end);
+			shift_left(end, m_size, end - start);
+		}
+		else {
+			std::move(data() + end, data() + m_size, data() + start);
+			destroy(data() + m_size - (end - start), data() + m_size);
+		}
+		m_size -= end - start;
+		return Iterator(data() + start);
+	}
+
+	template<typename Derived, typename T, typename Storage>
+	constexpr void VectorBase<Derived, T, Storage>::resize(size_t size) {
+		if (size < m_size) {
+			erase(begin() + static_cast<int>(size), end());
+			return;
+		}
+		make_room(size - m_size);
+		construct_n(data() + m_size, size - m_size);
+		m_size = size;
+	}
+
+	template<typename Derived, typename T, typename Storage>
+	constexpr void VectorBase<Derived, T, Storage>::resize(size_t size, const T& value) {
+		if (size < m_size)
+			erase(begin() + static_cast<int>(size), end());
+		else if (size > m_size)
+			insert(end(), size - m_size, value);
+	}
+
+	// Private Members
+	// Constructs n elements from args (value-initialized when empty); on a throw the
+	// ones already built are destroyed again
+	template<typename Derived, typename T, typename Storage>
+	template<typename...Args>
+	constexpr void VectorBase<Derived, T, Storage>::construct_n(T* dest, size_t n, const Args&...args) {
+		size_t built = 0;
+		try {
+			for (; built < n; ++built)
+				construct(dest + built, args...);
+		}
+		catch (...) {
+			destroy(dest, dest + built);
+			throw;
+		}
+	}
+
+	// Makes the capacity hold n more elements, growing through Derived::reserve
+	template<typename Derived, typename T, typename Storage>
+	constexpr void VectorBase<Derived, T, Storage>::make_room(size_t n) {
+		if (n <= capacity() - m_size) return;
+		if (n > static_cast<size_t>(-1) - m_size) throw OutOfRangeException(Derived::name);
+		derived().reserve(grow_capacity(m_size + n));
+	}
+
+	// Moves [first, last) up by n slots, leaving [first, first + n) as raw storage
+	template<typename Derived, typename T, typename Storage>
+	constexpr void VectorBase<Derived, T, Storage>::shift_right(size_t first, size_t last, size_t n) {
+		if constexpr (is_trivially_relocatable_v<T>) {
+			if (!std::is_constant_evaluated()) {
+				if (first < last)
+					std::memmove(static_cast<void*>(data() + first + n), static_cast<const void*>(data() + first), (last - first) * sizeof(T));
+				return;
+			}
+		}
+		// only the elements landing past last need constructing, the rest are move-assigned
+		size_t tail = std::min(n, last - first);
+		for (size_t i = last - tail; i < last; ++i)
+			construct(data() + i + n, std::move(data()[i]));
+		std::move_backward(data() + first, data() + last - tail, data() + last + n - tail);
+		destroy(data() + first, data() + first + tail);
+	}
+
+	// Moves [first, last) down by n slots into the raw storage at [first - n, first)
+	template<typename Derived, typename T, typename Storage>
+	constexpr void VectorBase<Derived, T, Storage>::shift_left(size_t first, size_t last, size_t n) noexcept {
+		if constexpr (is_trivially_relocatable_v<T>) {
+			if (!std::is_constant_evaluated()) {
+				if (first < last)
+					std::memmove(static_cast<void*>(data() + first - n), static_cast<const void*>(data() + first), (last - first) * sizeof(T));
+				return;
+			}
+		}
+		for (size_t i = first; i < last; ++i) {
+			construct(data() + i - n, std::move(data()[i]));
+			destroy(data() + i, data() + i + 1);
+		}
+	}
+
+	template<typename Derived, typename T, typename Storage>
+	constexpr Derived& VectorBase<Derived, T, Storage>::derived() noexcept {
+		return static_cast<Derived&>(*this);
+	}
+}
\ No newline at end of file
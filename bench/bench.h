@@ -0,0 +1,28 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+// Helpers shared by the standalone benchmark programs in this directory
+namespace bench {
+
+	// Written by the benchmarks so the optimizer cannot drop the work being timed
+	inline volatile size_t sink = 0;
+
+	// Runs f reps times and returns the fastest run in milliseconds
+	template<typename F>
+	double best_ms(int reps, F&& f) {
+		double best = 1e300;
+		for (int rep = 0; rep < reps; ++rep) {
+			auto start = std::chrono::steady_clock::now();
+			f();
+			std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+			if (elapsed.count() < best) best = elapsed.count();
+		}
+		return best;
+	}
+
+	inline void row(const char* name, double ms) {
+		std::printf("  %-40s %10.2f ms\n", name, ms);
+	}
+}
@@ -0,0 +1,108 @@
+// Many producers appending at once: ConcurrentVector against a Vector behind a mutex, with
+// the allocator counting how many bytes are live at the peak
+//
+//     g++ -std=c++20 -O2 -I Container bench/concurrent_vector.cpp -o concurrent_vector -pthread
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "bench.h"
+#include "concurrent_vector.h"
+#include "vector.h"
+
+using namespace Containers;
+
+constexpr size_t appends_per_thread = 1'000'000;
+
+std::atomic<size_t> allocations = 0;
+std::atomic<size_t> live_bytes = 0;
+std::atomic<size_t> peak_bytes = 0;
+
+template<typename T>
+struct CountingAllocator {
+	using value_type = T;
+
+	CountingAllocator() = default;
+
+	template<typename U>
+	CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+	T* allocate(size_t n) {
+		++allocations;
+		size_t live = live_bytes += n * sizeof(T);
+		size_t peak = peak_bytes.load();
+		while (live > peak && !peak_bytes.compare_exchange_weak(peak, live)) {}
+		return std::allocator<T>().allocate(n);
+	}
+
+	void deallocate(T* p, size_t n) noexcept {
+		live_bytes -= n * sizeof(T);
+		std::allocator<T>().deallocate(p, n);
+	}
+
+	template<typename U>
+	bool operator==(const CountingAllocator<U>&) const noexcept { return true; }
+};
+
+struct Result {
+	double ms;
+	size_t allocations;
+	size_t peak_bytes;
+};
+
+// Starts threads producers that each append appends_per_thread values through append,
+// and reports the fastest of three runs with the highest peak seen in any of them
+template<typename Container, typename Append>
+Result run(size_t threads, Append append) {
+	Result result{ 0, 0, 0 };
+	result.ms = bench::best_ms(3, [&] {
+		allocations = 0;
+		peak_bytes = 0;
+		{
+			Container container;
+			std::vector<std::thread> producers;
+			for (size_t p = 0; p < threads; ++p) {
+				producers.emplace_back([&] {
+					for (size_t i = 0; i < appends_per_thread; ++i) append(container, static_cast<long>(i));
+				});
+			}
+			for (std::thread& producer : producers) producer.join();
+			bench::sink = bench::sink + container.size();
+		}
+		result.allocations = std::max(result.allocations, allocations.load());
+		result.peak_bytes = std::max(result.peak_bytes, peak_bytes.load());
+	});
+	return result;
+}
+
+struct LockedVector {
+	Vector<long, DefaultGrowth, CountingAllocator<long>> vector;
+	std::mutex mutex;
+
+	size_t size() const { return vector.size(); }
+};
+
+void print(const char* name, const Result& result) {
+	std::printf("  %-28s %10.2f ms %8zu allocations %8.0f MB peak\n",
+		name, result.ms, result.allocations, result.peak_bytes / (1024.0 * 1024.0));
+}
+
+int main() {
+	std::printf("%zu push_back of long per thread (best of 3, highest peak)\n", appends_per_thread);
+	std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+	for (size_t threads : { 1, 2, 4, 8, 16, 32, 64 }) {
+		std::printf("%zu threads\n", threads);
+		print("ConcurrentVector", run<ConcurrentVector<long, CountingAllocator<long>>>(threads,
+			[](auto& container, long value) { container.push_back(value); }));
+		print("Vector behind a mutex", run<LockedVector>(threads,
+			[](LockedVector& container, long value) {
+				std::lock_guard<std::mutex> lock(container.mutex);
+				container.vector.push_back(value);
+			}));
+	}
+	return 0;
+}
@@ -0,0 +1,38 @@
+// Short-lived tiny vectors: SmallVector against Vector and std::vector
+//
+//     g++ -std=c++20 -O2 -I Container bench/small_vector.cpp -o small_vector
+
+#include <cstdio>
+#include <vector>
+#include "bench.h"
+#include "small_vector.h"
+#include "vector.h"
+
+using namespace Containers;
+
+constexpr size_t rounds = 1'000'000;
+
+// Builds, reads and destroys one vector of length elements per round
+template<typename V>
+double tiny(size_t length) {
+	return bench::best_ms(5, [&] {
+		size_t total = 0;
+		for (size_t round = 0; round < rounds; ++round) {
+			V v;
+			for (size_t i = 0; i < length; ++i) v.push_back(static_cast<int>(round + i));
+			for (size_t i = 0; i < v.size(); ++i) total += v[i];
+		}
+		bench::sink = bench::sink + total;
+	});
+}
+
+int main() {
+	std::printf("%zu vectors of int built and destroyed (best of 5)\n", rounds);
+	for (size_t length : { 1, 4, 8, 16 }) {
+		std::printf("%zu elements\n", length);
+		bench::row("SmallVector<int, 8>", tiny<SmallVector<int, 8>>(length));
+		bench::row("Vector<int>", tiny<Vector<int>>(length));
+		bench::row("std::vector<int>", tiny<std::vector<int>>(length));
+	}
+	return 0;
+}
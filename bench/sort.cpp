@@ -0,0 +1,66 @@
+// Containers::sort against std::sort on random, sorted, reversed and many-duplicate input
+//
+//     g++ -std=c++20 -O2 -I Container bench/sort.cpp -o sort
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include "bench.h"
+#include "sort.h"
+#include "vector.h"
+
+using namespace Containers;
+
+constexpr size_t length = 1'000'000;
+
+enum class Input { Random, Sorted, Reversed, Duplicates };
+
+template<typename T>
+Vector<T> make_input(Input input) {
+	std::mt19937_64 random(42);
+	Vector<T> values;
+	values.reserve(length);
+	for (size_t i = 0; i < length; ++i) {
+		switch (input) {
+		case Input::Random: values.push_back(static_cast<T>(static_cast<int64_t>(random() >> 1) - (int64_t(1) << 62))); break;
+		case Input::Sorted: values.push_back(static_cast<T>(i)); break;
+		case Input::Reversed: values.push_back(static_cast<T>(length - i)); break;
+		case Input::Duplicates: values.push_back(static_cast<T>(random() % 16)); break;
+		}
+	}
+	return values;
+}
+
+// Sorts a fresh copy of the input each run; the copy is made outside the timed part
+template<typename T, typename F>
+double time_sort(const Vector<T>& input, F sort) {
+	double best = 1e300;
+	for (int rep = 0; rep < 5; ++rep) {
+		Vector<T> values = input;
+		best = std::min(best, bench::best_ms(1, [&] { sort(values); }));
+		if (!std::is_sorted(values.begin(), values.end())) std::printf("  not sorted!\n");
+		bench::sink = bench::sink + static_cast<size_t>(values[length / 2]);
+	}
+	return best;
+}
+
+template<typename T>
+void run(const char* type) {
+	const char* names[] = { "random", "sorted", "reversed", "16 distinct values" };
+	for (Input input : { Input::Random, Input::Sorted, Input::Reversed, Input::Duplicates }) {
+		std::printf("%s, %s\n", type, names[static_cast<int>(input)]);
+		Vector<T> values = make_input<T>(input);
+		bench::row("Containers::sort", time_sort(values, [](Vector<T>& v) { sort(v); }));
+		bench::row("Containers::sort, std::less (pdqsort)", time_sort(values, [](Vector<T>& v) { sort(v, std::less<>()); }));
+		bench::row("std::sort", time_sort(values, [](Vector<T>& v) { std::sort(v.data(), v.data() + v.size()); }));
+	}
+}
+
+int main() {
+	std::printf("%zu elements (best of 5)\n", length);
+	run<int64_t>("int64_t");
+	run<double>("double");
+	return 0;
+}
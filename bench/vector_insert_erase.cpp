@@ -0,0 +1,57 @@
+// Mid-vector insert and erase on a 1M-element Vector, against std::vector
+//
+//     g++ -std=c++20 -O2 -I Container bench/vector_insert_erase.cpp -o vector_insert_erase
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "vector.h"
+
+using namespace Containers;
+
+constexpr size_t elements = 1'000'000;
+constexpr size_t operations = 300;
+
+// operations inserts at the middle followed by as many erases there, 2 * operations in total
+template<typename V, typename T>
+double insert_erase(const T& value) {
+	V base;
+	for (size_t i = 0; i < elements; ++i) base.push_back(value);
+	return bench::best_ms(5, [&] {
+		V v = base;
+		for (size_t i = 0; i < operations; ++i)
+			v.insert(v.begin() + static_cast<int>(v.size() / 2), value);
+		for (size_t i = 0; i < operations; ++i)
+			v.erase(v.begin() + static_cast<int>(v.size() / 2));
+		bench::sink = bench::sink + v.size();
+	});
+}
+
+// The copy of the 1M-element base is part of each run, so it is timed on its own too
+template<typename V, typename T>
+double copy_only(const T& value) {
+	V base;
+	for (size_t i = 0; i < elements; ++i) base.push_back(value);
+	return bench::best_ms(5, [&] {
+		V v = base;
+		bench::sink = bench::sink + v.size();
+	});
+}
+
+int main() {
+	std::printf("%zu mid-vector inserts then %zu erases on %zu elements (best of 5)\n", operations, operations, elements);
+
+	std::printf("int64_t\n");
+	bench::row("Vector", insert_erase<Vector<int64_t>>(int64_t(42)));
+	bench::row("std::vector", insert_erase<std::vector<int64_t>>(int64_t(42)));
+	bench::row("copy of the base (Vector)", copy_only<Vector<int64_t>>(int64_t(42)));
+
+	std::string text(32, 'x');
+	std::printf("std::string (32 chars)\n");
+	bench::row("Vector", insert_erase<Vector<std::string>>(text));
+	bench::row("std::vector", insert_erase<std::vector<std::string>>(text));
+	bench::row("copy of the base (Vector)", copy_only<Vector<std::string>>(text));
+	return 0;
+}
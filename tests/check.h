@@ -0,0 +1,29 @@
+#pragma once
+#include <cstdio>
+
+// Minimal checks for the standalone test programs in this directory. A failed CHECK is
+// reported and the test carries on; main returns check::failures() so the exit code is
+// non-zero when anything failed.
+namespace check {
+
+	inline int& failures() {
+		static int count = 0;
+		return count;
+	}
+
+	inline void fail(const char* expression, const char* file, int line) {
+		std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, expression);
+		++failures();
+	}
+}
+
+#define CHECK(expression) \
+	((expression) ? void() : check::fail(#expression, __FILE__, __LINE__))
+
+#define CHECK_THROWS(expression, Exception) \
+	do { \
+		bool thrown = false; \
+		try { expression; } \
+		catch (const Exception&) { thrown = true; } \
+		if (!thrown) check::fail(#expression " throws " #Exception, __FILE__, __LINE__); \
+	} while (false)
@@ -0,0 +1,113 @@
+// Key updates in PriorityQueue: increase_key and decrease_key under std::less and
+// std::greater, and the exceptions for a key moved the wrong way
+//
+//     g++ -std=c++20 -I Container tests/priority_queue_test.cpp -o priority_queue_test
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <vector>
+#include "check.h"
+#include "priority_queue.h"
+
+using namespace Containers;
+
+// Pops everything and checks that no element comes out before one it compares before
+template<typename Queue, typename Compare>
+bool pops_in_order(Queue& queue, Compare compare) {
+	bool first = true;
+	int previous = 0;
+	while (!queue.empty()) {
+		int value = queue.top();
+		if (!first && compare(previous, value)) return false;
+		previous = value;
+		first = false;
+		queue.pop();
+	}
+	return true;
+}
+
+void test_less() {
+	// std::less keeps the largest on top, so a larger value is an increase
+	PriorityQueue<int> queue;
+	auto low = queue.push(1);
+	auto mid = queue.push(5);
+	auto high = queue.push(9);
+
+	queue.increase_key(low, 20);
+	CHECK(queue.top_handle() == low && queue.top() == 20);
+	queue.decrease_key(low, 0);
+	CHECK(queue.top_handle() == high && queue[low] == 0);
+
+	// An equal value is both an increase and a decrease
+	queue.increase_key(mid, 5);
+	queue.decrease_key(mid, 5);
+	CHECK(queue[mid] == 5);
+
+	CHECK_THROWS(queue.increase_key(high, 8), ContainerException);
+	CHECK_THROWS(queue.decrease_key(low, 1), ContainerException);
+	CHECK(queue[high] == 9 && queue[low] == 0);
+	CHECK(queue.size() == 3 && pops_in_order(queue, std::less<int>()));
+}
+
+void test_greater() {
+	// std::greater keeps the smallest on top, so a smaller value is an increase
+	PriorityQueue<int, std::greater<int>> queue;
+	auto low = queue.push(1);
+	auto mid = queue.push(5);
+	auto high = queue.push(9);
+
+	queue.increase_key(high, -3);
+	CHECK(queue.top_handle() == high && queue.top() == -3);
+	queue.decrease_key(high, 30);
+	CHECK(queue.top_handle() == low && queue[high] == 30);
+
+	queue.increase_key(mid, 5);
+	queue.decrease_key(mid, 5);
+	CHECK(queue[mid] == 5);
+
+	CHECK_THROWS(queue.increase_key(low, 2), ContainerException);
+	CHECK_THROWS(queue.decrease_key(high, 29), ContainerException);
+	CHECK(queue[low] == 1 && queue[high] == 30);
+	CHECK(queue.size() == 3 && pops_in_order(queue, std::greater<int>()));
+}
+
+// Random updates in both directions, with each checked against the Compare order before
+// it is applied, must leave a valid heap
+template<typename Compare>
+void test_random_updates() {
+	std::mt19937 random(7);
+	std::vector<int> values(1000);
+	for (int& value : values) value = static_cast<int>(random() % 10000);
+	PriorityQueue<int, Compare> queue(values.begin(), values.end());
+	Compare compare;
+	size_t thrown = 0;
+	for (int round = 0; round < 5000; ++round) {
+		size_t handle = random() % values.size();
+		int value = static_cast<int>(random() % 10000);
+		bool increase = random() % 2;
+		bool allowed = increase ? !compare(value, values[handle]) : !compare(values[handle], value);
+		try {
+			if (increase) queue.increase_key(handle, value);
+			else queue.decrease_key(handle, value);
+			values[handle] = value;
+		}
+		catch (const ContainerException&) {
+			++thrown;
+			CHECK(!allowed);
+			continue;
+		}
+		CHECK(allowed);
+	}
+	CHECK(thrown > 0);
+	for (size_t handle = 0; handle < values.size(); ++handle) CHECK(queue[handle] == values[handle]);
+	CHECK(pops_in_order(queue, compare));
+}
+
+int main() {
+	test_less();
+	test_greater();
+	test_random_updates<std::less<int>>();
+	test_random_updates<std::greater<int>>();
+	return check::failures();
+}
@@ -0,0 +1,68 @@
+// Stability of stable_sort and stable_sort_by_key for floating-point keys: -0.0 and 0.0
+// compare equal, so they must keep their input order on both the merge and radix paths
+//
+//     g++ -std=c++20 -I Container tests/sort_test.cpp -o sort_test
+
+#include <cmath>
+#include <cstddef>
+#include "check.h"
+#include "globals.h"
+#include "sort.h"
+#include "vector.h"
+
+using namespace Containers;
+
+struct Item {
+	double key;
+	int id;
+};
+
+// Zeros of both signs interleaved with other values; zero i is negative when i % 3 is 1
+Vector<double> mixed_zeros(size_t length) {
+	Vector<double> values;
+	for (size_t i = 0; i < length; ++i) {
+		if (i % 2) values.push_back(i % 3 == 1 ? -0.0 : 0.0);
+		else values.push_back(static_cast<double>(static_cast<int>(length / 2) - static_cast<int>(i)));
+	}
+	return values;
+}
+
+void test_stable_sort(size_t length) {
+	Vector<double> input = mixed_zeros(length);
+	Vector<double> sorted = input;
+	stable_sort(sorted);
+	Vector<bool> expected, actual;
+	for (double value : input) {
+		if (value == 0.0) expected.push_back(std::signbit(value));
+	}
+	for (size_t i = 0; i < sorted.size(); ++i) {
+		CHECK(i == 0 || !(sorted[i] < sorted[i - 1]));
+		if (sorted[i] == 0.0) actual.push_back(std::signbit(sorted[i]));
+	}
+	CHECK(actual.size() == expected.size());
+	for (size_t i = 0; i < actual.size() && i < expected.size(); ++i) CHECK(actual[i] == expected[i]);
+}
+
+void test_stable_sort_by_key(size_t length) {
+	Vector<double> keys = mixed_zeros(length);
+	Vector<Item> items;
+	for (size_t i = 0; i < keys.size(); ++i) items.push_back({ keys[i], static_cast<int>(i) });
+	stable_sort_by_key(items, [](const Item& item) { return item.key; });
+	int last_zero = -1;
+	for (size_t i = 0; i < items.size(); ++i) {
+		CHECK(i == 0 || !(items[i].key < items[i - 1].key));
+		if (items[i].key != 0.0) continue;
+		CHECK(items[i].id > last_zero);
+		CHECK(std::signbit(items[i].key) == std::signbit(keys[items[i].id]));
+		last_zero = items[i].id;
+	}
+}
+
+int main() {
+	// Below the threshold the stable variants merge, above it they radix-sort
+	for (size_t length : { size_t(9), Global::RADIX_SORT_THRESHOLD - 1, Global::RADIX_SORT_THRESHOLD * 8 }) {
+		test_stable_sort(length);
+		test_stable_sort_by_key(length);
+	}
+	return check::failures();
+}
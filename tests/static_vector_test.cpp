@@ -0,0 +1,96 @@
+// Behaviour of StaticVector at its capacity: the throwing members, the try_ members and
+// the guarantee that the try_ members never allocate
+//
+//     g++ -std=c++20 -I Container tests/static_vector_test.cpp -o static_vector_test
+
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <type_traits>
+#include "check.h"
+#include "static_vector.h"
+
+using namespace Containers;
+
+// Counts every allocation made through the global operator new
+size_t allocations = 0;
+
+void* operator new(size_t size) {
+	++allocations;
+	if (void* p = std::malloc(size ? size : 1)) return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+static_assert(std::is_trivially_copyable_v<StaticVector<int, 4>>);
+static_assert(!std::is_trivially_copyable_v<StaticVector<std::string, 4>>);
+
+constexpr bool constant_try_members() {
+	StaticVector<int, 4> v{ 1, 2 };
+	int extra[] = { 7, 8, 9 };
+	if (v.try_insert(v.begin(), extra, extra + 3)) return false;
+	if (!v.try_insert(v.begin() + 1, extra, extra + 2)) return false;
+	if (v.try_emplace(v.end(), 5) || v.try_resize(5)) return false;
+	return v.size() == 4 && v[0] == 1 && v[1] == 7 && v[2] == 8 && v[3] == 2;
+}
+
+static_assert(constant_try_members());
+
+void test_throwing_members() {
+	StaticVector<int, 4> v{ 1, 2, 3, 4 };
+	CHECK_THROWS(v.push_back(5), OutOfRangeException);
+	CHECK_THROWS(v.insert(v.begin(), 0), OutOfRangeException);
+	CHECK_THROWS(v.emplace(v.begin(), 0), OutOfRangeException);
+	CHECK_THROWS(v.resize(5), OutOfRangeException);
+	CHECK(v.size() == 4 && v[0] == 1 && v[3] == 4);
+}
+
+void test_try_members() {
+	StaticVector<std::string, 4> v{ "b", "d" };
+	size_t before = allocations;
+
+	// Room left: the try_ members behave like the plain ones
+	std::string* inserted = v.try_insert(v.begin(), std::string());
+	CHECK(inserted == v.data() && v.size() == 3);
+	CHECK(v.try_emplace(v.begin() + 2) == v.data() + 2);
+	CHECK(v.full());
+
+	// Full: every try_ member declines and leaves the vector alone
+	CHECK(!v.try_push_back(std::string()));
+	CHECK(!v.try_emplace_back());
+	CHECK(!v.try_emplace(v.begin()));
+	CHECK(!v.try_insert(v.end(), std::string()));
+	CHECK(!v.try_insert(v.begin(), 1, std::string()));
+	CHECK(!v.try_insert(v.begin(), v.begin(), v.begin() + 1));
+	CHECK(!v.try_resize(5));
+	CHECK(!v.try_resize(5, std::string()));
+	CHECK(allocations == before);
+	CHECK(v.size() == 4 && v[1] == "b" && v[3] == "d");
+
+	// A zero-length range and shrinking always fit
+	CHECK(v.try_insert(v.end(), v.begin(), v.begin()));
+	CHECK(v.try_resize(2));
+	CHECK(v.size() == 2 && v[1] == "b");
+	CHECK(v.try_resize(4, std::string()));
+	CHECK(v.size() == 4 && v[3].empty());
+}
+
+void test_partial_room() {
+	StaticVector<int, 6> v{ 1, 2, 3, 4 };
+	int extra[] = { 5, 6, 7 };
+	CHECK(!v.try_insert(v.begin() + 2, 3, 0));
+	CHECK(!v.try_insert(v.begin() + 2, extra, extra + 3));
+	CHECK(v.size() == 4);
+	CHECK(v.try_insert(v.begin() + 2, extra, extra + 2));
+	CHECK(v.size() == 6 && v[2] == 5 && v[3] == 6 && v[4] == 3);
+}
+
+int main() {
+	test_throwing_members();
+	test_try_members();
+	test_partial_room();
+	return check::failures();
+}
@@ -0,0 +1,195 @@
+// Behaviour of UnorderedMap: lookup, insertion, erasure, rehashing, node handles and merge
+//
+//     g++ -std=c++20 -I Container tests/unordered_map_test.cpp -o unordered_map_test
+
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include "check.h"
+#include "unordered_map.h"
+
+using namespace Containers;
+
+// Set to make every FlakyAllocator allocation throw
+bool fail_allocations = false;
+
+template<typename T>
+struct FlakyAllocator {
+	using value_type = T;
+
+	FlakyAllocator() = default;
+
+	template<typename U>
+	FlakyAllocator(const FlakyAllocator<U>&) noexcept {}
+
+	T* allocate(size_t n) {
+		if (fail_allocations) throw std::bad_alloc();
+		return std::allocator<T>().allocate(n);
+	}
+
+	void deallocate(T* p, size_t n) noexcept { std::allocator<T>().deallocate(p, n); }
+
+	template<typename U>
+	bool operator==(const FlakyAllocator<U>&) const noexcept { return true; }
+};
+
+template<typename Map>
+bool holds_range(const Map& map, int first, int last) {
+	if (map.size() != static_cast<size_t>(last - first)) return false;
+	for (int i = first; i < last; ++i) {
+		if (!map.contains(i) || map.at(i) != std::to_string(i)) return false;
+	}
+	size_t visited = 0;
+	for (const auto& key_value : map) {
+		if (key_value.first < first || key_value.first >= last) return false;
+		++visited;
+	}
+	return visited == map.size();
+}
+
+template<typename Policy>
+void test_policy() {
+	UnorderedMap<int, std::string, std::hash<int>, std::equal_to<int>, Policy> map;
+	for (int i = 0; i < 5000; ++i) map.emplace(i, std::to_string(i));
+	CHECK(holds_range(map, 0, 5000));
+	CHECK(map.load_factor() <= map.max_load_factor());
+}
+
+void test_lookup_and_insert() {
+	UnorderedMap<int, std::string> map;
+	CHECK(map.empty());
+	CHECK(map.find(1) == map.end());
+	CHECK_THROWS(map.at(1), OutOfRangeException);
+
+	CHECK(map.insert({ 1, "one" }).second);
+	CHECK(!map.insert({ 1, "uno" }).second);
+	CHECK(map.at(1) == "one");
+
+	map[2] = "two";
+	CHECK(map.size() == 2 && map[2] == "two");
+	CHECK(map.count(2) == 1 && map.count(3) == 0);
+
+	auto [position, inserted] = map.try_emplace(2, "deux");
+	CHECK(!inserted && position->second == "two");
+	CHECK(map.try_emplace(3, "three").second);
+
+	CHECK(!map.insert_or_assign(3, "drei").second);
+	CHECK(map.at(3) == "drei");
+	CHECK(map.insert_or_assign(4, "four").second);
+
+	auto [first, last] = map.equal_range(4);
+	CHECK(first != map.end() && first->second == "four" && ++first == last);
+	auto [none, none_end] = map.equal_range(5);
+	CHECK(none == none_end);
+}
+
+void test_erase() {
+	UnorderedMap<int, std::string> map;
+	for (int i = 0; i < 1000; ++i) map[i] = std::to_string(i);
+	for (int i = 0; i < 1000; i += 2) CHECK(map.erase(i) == 1);
+	CHECK(map.erase(0) == 0);
+	CHECK(map.size() == 500);
+	for (int i = 0; i < 1000; ++i) CHECK(map.contains(i) == (i % 2 == 1));
+
+	for (auto it = map.begin(); it != map.end();)
+		it = it->first < 500 ? map.erase(it) : ++it;
+	CHECK(map.size() == 250);
+	map.erase(map.begin(), map.end());
+	CHECK(map.empty() && map.begin() == map.end());
+
+	map[7] = "seven";
+	map.clear();
+	CHECK(map.empty() && !map.contains(7));
+}
+
+void test_rehash() {
+	UnorderedMap<int, std::string> map;
+	for (int i = 0; i < 2000; ++i) map[i] = std::to_string(i);
+	size_t buckets = map.bucket_count();
+	CHECK(map.load_factor() <= map.max_load_factor());
+
+	map.rehash(buckets * 4);
+	CHECK(map.bucket_count() >= buckets * 4);
+	CHECK(holds_range(map, 0, 2000));
+
+	map.max_load_factor(4.0);
+	map.rehash(0);
+	CHECK(map.bucket_count() < buckets * 4);
+	CHECK(holds_range(map, 0, 2000));
+	CHECK_THROWS(map.max_load_factor(0.0), ContainerException);
+
+	map.reserve(10000);
+	CHECK(map.bucket_count() * map.max_load_factor() >= 10000);
+	CHECK(holds_range(map, 0, 2000));
+}
+
+// A rehash whose bucket array cannot be allocated leaves the map as it was
+void test_rehash_failure() {
+	using Map = UnorderedMap<int, std::string, std::hash<int>, std::equal_to<int>,
+		DefaultHashPolicy, FlakyAllocator<std::pair<const int, std::string>>>;
+	Map map;
+	for (int i = 0; i < 100; ++i) map[i] = std::to_string(i);
+
+	fail_allocations = true;
+	bool thrown = false;
+	try {
+		map.rehash(4096);
+	}
+	catch (const std::bad_alloc&) {
+		thrown = true;
+	}
+	fail_allocations = false;
+
+	CHECK(thrown);
+	CHECK(holds_range(map, 0, 100));
+	for (int i = 100; i < 1000; ++i) map[i] = std::to_string(i);
+	CHECK(holds_range(map, 0, 1000));
+}
+
+void test_copy_and_move() {
+	UnorderedMap<int, std::string> map{ { 1, "one" }, { 2, "two" }, { 3, "three" } };
+	UnorderedMap<int, std::string> copy(map);
+	copy[4] = "four";
+	CHECK(map.size() == 3 && copy.size() == 4);
+
+	UnorderedMap<int, std::string> moved(std::move(copy));
+	CHECK(moved.size() == 4 && moved.at(4) == "four");
+
+	copy = map;
+	CHECK(copy.size() == 3 && copy.at(3) == "three");
+	copy = { { 9, "nine" } };
+	CHECK(copy.size() == 1 && copy.at(9) == "nine");
+
+	copy.swap(moved);
+	CHECK(copy.size() == 4 && moved.size() == 1);
+}
+
+void test_nodes_and_merge() {
+	UnorderedMap<int, std::string> map{ { 1, "one" }, { 2, "two" } };
+	auto node = map.extract(1);
+	CHECK(!map.contains(1) && map.size() == 1);
+	CHECK(node.key_value.first == 1 && node.key_value.second == "one");
+
+	auto result = map.insert(std::move(node));
+	CHECK(result.inserted && result.position->second == "one");
+	CHECK(map.size() == 2);
+
+	UnorderedMap<int, std::string> other{ { 2, "deux" }, { 3, "trois" } };
+	map.merge(other);
+	CHECK(map.size() == 3 && map.at(2) == "two" && map.at(3) == "trois");
+	CHECK(other.size() == 1 && other.at(2) == "deux");
+}
+
+int main() {
+	test_lookup_and_insert();
+	test_erase();
+	test_rehash();
+	test_rehash_failure();
+	test_copy_and_move();
+	test_nodes_and_merge();
+	test_policy<ModuloHashPolicy>();
+	test_policy<PowerOfTwoHashPolicy>();
+	test_policy<PrimeHashPolicy>();
+	return check::failures();
+}